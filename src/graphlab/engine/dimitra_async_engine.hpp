@@ -0,0 +1,267 @@
+#ifndef GRAPHLAB_DIMITRA_ASYNC_ENGINE_HPP
+#define GRAPHLAB_DIMITRA_ASYNC_ENGINE_HPP
+
+#include <graphlab/engine/powerlyra_async_engine.hpp>
+#include <graphlab/vertex_program/imulti_vertex_program.hpp>
+
+#include <graphlab/macros_def.hpp>
+
+namespace graphlab {
+
+
+  /**
+   * \ingroup engines
+   *
+   * \brief The DiMITra asynchronous engine runs AutoMI multi-instance
+   * vertex programs on top of the PowerLyra asynchronous engine,
+   * without any global superstep barrier.
+   *
+   * Every scheduled vertex carries the lane mask of its pending
+   * message (see imulti_vertex_program::message_lanes).  Since
+   * messages to the same vertex are combined while the vertex waits
+   * in the scheduler, the mask is the union of the lanes signaled
+   * since the vertex last ran.  The vertex program is executed with
+   * that mask, so a vertex signaled for 3 of 256 queries only gathers,
+   * applies and scatters those 3 lanes:
+   *
+   * \li a task whose message carries no lane is dropped;
+   * \li the lanes are shipped to the mirrors with the vertex program
+   * for the gather;
+   * \li after apply the lanes are narrowed to
+   * imulti_vertex_program::changed_lanes, and the scatter (including
+   * the vertex data push to the mirrors) is skipped if none changed.
+   *
+   * The engine accepts the same options as the
+   * \ref powerlyra_async_engine.
+   *
+   * \tparam VertexProgram The user defined vertex program which
+   * should implement the \ref graphlab::imulti_vertex_program
+   * interface.
+   */
+  template<typename VertexProgram>
+  class dimitra_async_engine :
+    public powerlyra_async_engine<VertexProgram> {
+
+  public:
+    typedef powerlyra_async_engine<VertexProgram> base_engine_type;
+
+    typedef typename base_engine_type::vertex_program_type vertex_program_type;
+    typedef typename base_engine_type::message_type message_type;
+    typedef typename base_engine_type::graph_type graph_type;
+    typedef typename base_engine_type::vertex_type vertex_type;
+
+    /// The type of the per-lane activity mask
+    typedef typename vertex_program_type::lane_mask_type lane_mask_type;
+
+  private:
+    typedef typename base_engine_type::lvid_type lvid_type;
+    typedef typename base_engine_type::local_vertex_type local_vertex_type;
+    typedef typename base_engine_type::context_type context_type;
+    typedef typename base_engine_type::conditional_gather_type
+                                                   conditional_gather_type;
+    typedef typename base_engine_type::vertex_fiber_cm_handle
+                                                   vertex_fiber_cm_handle;
+
+    using base_engine_type::rmi;
+    using base_engine_type::graph;
+    using base_engine_type::cmlocks;
+    using base_engine_type::cm_handles;
+    using base_engine_type::vertexlocks;
+    using base_engine_type::factorized_consistency;
+    using base_engine_type::track_task_time;
+    using base_engine_type::total_completion_time;
+    using base_engine_type::programs_executed;
+
+    /**
+     * \brief The number of scheduled tasks dropped because their
+     * message carried no active lane.
+     */
+    atomic<uint64_t> tasks_without_lanes;
+
+    /**
+     * \brief The number of executed tasks which skipped the scatter
+     * because all of their lanes have converged.
+     */
+    atomic<uint64_t> tasks_converged;
+
+  public:
+    /**
+     * \brief Construct a multi-instance asynchronous engine for a
+     * given graph and options.
+     *
+     * See \ref powerlyra_async_engine::powerlyra_async_engine for the
+     * available options.
+     */
+    dimitra_async_engine(distributed_control& dc, graph_type& graph,
+                         const graphlab_options& opts = graphlab_options()) :
+      base_engine_type(dc, graph, opts),
+      tasks_without_lanes(0), tasks_converged(0) { }
+
+    // documentation inherited from iengine
+    execution_status::status_enum start() {
+      tasks_without_lanes = 0; tasks_converged = 0;
+      execution_status::status_enum ret = base_engine_type::start();
+
+      uint64_t nempty = tasks_without_lanes.value;
+      uint64_t nconverged = tasks_converged.value;
+      rmi.all_reduce(nempty);
+      rmi.all_reduce(nconverged);
+      rmi.cout() << "Tasks without lanes: " << nempty << std::endl;
+      rmi.cout() << "Converged Tasks: " << nconverged << std::endl;
+      return ret;
+    } // end of start
+
+  protected:
+    /**
+     * \internal
+     * Called when the scheduler returns a vertex to run.  Mirrors
+     * powerlyra_async_engine::eval_sched_task with the vertex program
+     * restricted to the lanes carried by the message.
+     */
+    void eval_sched_task(const lvid_type lvid,
+                         const message_type& msg) {
+      const typename graph_type::vertex_record& rec = graph.l_get_vertex_record(lvid);
+      vertex_id_type vid = rec.gvid;
+      char task_time_data[sizeof(timer)];
+      timer* task_time = NULL;
+      if (track_task_time) {
+        // placement new to create the timer
+        task_time = reinterpret_cast<timer*>(task_time_data);
+        new (task_time) timer();
+      }
+      // if this is another machine's forward it
+      if (rec.owner != rmi.procid()) {
+        rmi.remote_call(rec.owner, &dimitra_async_engine::rpc_signal, vid, msg);
+        return;
+      }
+
+      // compute the lanes of the task before taking the vertex, a
+      // message without lanes has nothing to do
+      vertex_program_type vprog = vertex_program_type();
+      lane_mask_type lanes;
+      vprog.message_lanes(msg, lanes);
+      if (lanes.vec_all_zeros()) {
+        tasks_without_lanes.inc();
+        return;
+      }
+      vprog.set_active_lanes(lanes);
+
+      // I have to run this myself
+      if (!this->get_exclusive_access_to_vertex(lvid, msg)) return;
+
+      /**************************************************************************/
+      /*                             Acquire Locks                              */
+      /**************************************************************************/
+      if (!factorized_consistency) {
+        // begin lock acquisition
+        cm_handles[lvid] = new vertex_fiber_cm_handle;
+        cm_handles[lvid]->philosopher_ready = false;
+        cm_handles[lvid]->fiber_handle = fiber_control::get_tid();
+        cmlocks->make_philosopher_hungry(lvid);
+        cm_handles[lvid]->lock.lock();
+        while (!cm_handles[lvid]->philosopher_ready) {
+          fiber_control::deschedule_self(&(cm_handles[lvid]->lock.m_mut));
+          cm_handles[lvid]->lock.lock();
+        }
+        cm_handles[lvid]->lock.unlock();
+      }
+
+      /**************************************************************************/
+      /*                             Begin Program                              */
+      /**************************************************************************/
+      context_type context(*this, graph);
+      local_vertex_type local_vertex(graph.l_vertex(lvid));
+      vertex_type vertex(local_vertex);
+      bool high = this->high_lvid(lvid);
+
+      /**************************************************************************/
+      /*                               init phase                               */
+      /**************************************************************************/
+      vprog.init(context, vertex, msg);
+
+      /**************************************************************************/
+      /*                              Gather Phase                              */
+      /**************************************************************************/
+      // the vertex program carries the active lanes to the mirrors
+      conditional_gather_type gather_result;
+      std::vector<request_future<conditional_gather_type> > gather_futures;
+      edge_dir_type gather_dir = vprog.gather_edges(context, vertex);
+
+      if (high || (gather_dir == graphlab::ALL_EDGES)
+               || (gather_dir == graphlab::OUT_EDGES)) {
+        foreach(procid_t mirror, local_vertex.mirrors()) {
+          gather_futures.push_back(
+              object_fiber_remote_request(rmi,
+                                          mirror,
+                                          &dimitra_async_engine::perform_gather,
+                                          vid,
+                                          vprog));
+        }
+      }
+      gather_result += this->perform_gather(vid, vprog);
+      if (high || (gather_dir == graphlab::ALL_EDGES)
+               || (gather_dir == graphlab::OUT_EDGES)) {
+        for(size_t i = 0;i < gather_futures.size(); ++i) {
+          gather_result += gather_futures[i]();
+        }
+      }
+
+      /**************************************************************************/
+      /*                              apply phase                               */
+      /**************************************************************************/
+      vertexlocks[lvid].lock();
+      vprog.apply(context, vertex, gather_result.value);
+      vertexlocks[lvid].unlock();
+
+      /**************************************************************************/
+      /*                            scatter phase                               */
+      /**************************************************************************/
+      // only the lanes changed by apply are scattered, and the vertex
+      // data of converged lanes does not need to reach the mirrors.
+      // Without factorized consistency the scatter also releases the
+      // distributed locks on every replica, so it is never skipped.
+      vprog.changed_lanes(lanes);
+      const bool converged = lanes.vec_all_zeros();
+      vprog.set_active_lanes(lanes);
+      if (!converged || !factorized_consistency) {
+        std::vector<request_future<void> > scatter_futures;
+        foreach(procid_t mirror, local_vertex.mirrors()) {
+          scatter_futures.push_back(
+              object_fiber_remote_request(rmi,
+                                          mirror,
+                                          &dimitra_async_engine::perform_scatter,
+                                          vid,
+                                          vprog,
+                                          local_vertex.data()));
+        }
+        this->perform_scatter_local(lvid, vprog);
+        for(size_t i = 0;i < scatter_futures.size(); ++i)
+          scatter_futures[i]();
+      }
+      if (converged) tasks_converged.inc();
+
+      /************************************************************************/
+      /*                           Release Locks                              */
+      /************************************************************************/
+      // the scatter is used to release the chandy misra
+      // here I cleanup
+      if (!factorized_consistency) {
+        delete cm_handles[lvid];
+        cm_handles[lvid] = NULL;
+      }
+      this->release_exclusive_access_to_vertex(lvid);
+      if (track_task_time) {
+        total_completion_time[fiber_control::get_worker_id()] +=
+            task_time->current_time();
+        task_time->~timer();
+      }
+      programs_executed.inc();
+    } // end of eval_sched_task
+
+  }; // end of class dimitra_async_engine
+
+} // namespace
+
+#include <graphlab/macros_undef.hpp>
+
+#endif
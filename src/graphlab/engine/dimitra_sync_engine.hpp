@@ -0,0 +1,851 @@
+#ifndef GRAPHLAB_DIMITRA_SYNC_ENGINE_HPP
+#define GRAPHLAB_DIMITRA_SYNC_ENGINE_HPP
+
+#include <deque>
+#include <map>
+#include <vector>
+
+#include <graphlab/engine/powerlyra_sync_engine.hpp>
+#include <graphlab/vertex_program/imulti_vertex_program.hpp>
+
+#include <graphlab/macros_def.hpp>
+
+namespace graphlab {
+
+
+  /**
+   * \ingroup engines
+   *
+   * \brief The DiMITra synchronous engine runs AutoMI multi-instance
+   * vertex programs, which execute many queries at once with one lane
+   * per query, on top of the PowerLyra synchronous engine.
+   *
+   * The engine tracks the active lanes of every vertex program (see
+   * \ref graphlab::imulti_vertex_program):
+   *
+   * \li On receiving messages the lanes carried by the message are
+   * computed with imulti_vertex_program::message_lanes.  Vertices
+   * whose message carries no lane are not activated.
+   *
+   * \li After apply the lanes are narrowed to
+   * imulti_vertex_program::changed_lanes.  Vertices whose lanes have
+   * all converged neither synchronize their data with the mirrors nor
+   * scatter.
+   *
+   * \li The lanes are shipped to the mirrors with the vertex program,
+   * so gather and scatter only need to touch the active lanes.
+   *
+   * \li At the end of every superstep the changed lanes of all
+   * vertices are OR-reduced across the cluster.  A lane which no
+   * vertex has changed has converged everywhere and retires: it is
+   * masked out of the lanes of later messages.
+   *
+   * The engine accepts the same options as the
+   * \ref powerlyra_sync_engine, except <b>direction</b> and
+   * <b>pipeline</b>.  With <b>delta_sync</b> the mirrors only receive
+   * the changed lanes of the vertex data, and with
+   * <b>lane_compaction</b> the retired lanes are dropped from the lane
+   * vectors once at least half of the lanes have retired, which
+   * shrinks the vertex data, messages and accumulators exchanged in
+   * the following supersteps.  The results of the dropped lanes are
+   * emitted with imulti_vertex_program::retire_lanes first.  Lane i
+   * then runs query \ref lane_query "lane_query(i)".
+   *
+   * With <b>stream_queries</b> the engine serves a stream of queries:
+   * at the end of each superstep the results of the retired lanes are
+   * emitted with imulti_vertex_program::retire_lanes, and the sources
+   * queued with \ref queue_queries are admitted into the freed lanes,
+   * which are cleared with imulti_vertex_program::reset_lanes and
+   * seeded through source_init.  Lanes are not compacted with
+   * <b>stream_queries</b>.
+   *
+   * \tparam VertexProgram The user defined vertex program which
+   * should implement the \ref graphlab::imulti_vertex_program
+   * interface.
+   */
+  template<typename VertexProgram>
+  class dimitra_sync_engine :
+    public powerlyra_sync_engine<VertexProgram> {
+
+  public:
+    typedef powerlyra_sync_engine<VertexProgram> base_engine_type;
+
+    typedef typename base_engine_type::vertex_program_type vertex_program_type;
+    typedef typename base_engine_type::message_type message_type;
+    typedef typename base_engine_type::graph_type graph_type;
+    typedef typename base_engine_type::vertex_type vertex_type;
+    typedef typename base_engine_type::gather_type gather_type;
+
+    /// The type of the per-lane activity mask
+    typedef typename vertex_program_type::lane_mask_type lane_mask_type;
+
+  private:
+    typedef typename base_engine_type::lvid_type lvid_type;
+    typedef typename base_engine_type::context_type context_type;
+
+    using base_engine_type::rmi;
+    using base_engine_type::graph;
+    using base_engine_type::ncpus;
+    using base_engine_type::sched_allv;
+    using base_engine_type::vertex_programs;
+    using base_engine_type::messages;
+    using base_engine_type::has_message;
+    using base_engine_type::has_cache;
+    using base_engine_type::use_cache;
+    using base_engine_type::lane_compaction;
+    using base_engine_type::stream_queries;
+    using base_engine_type::iteration_counter;
+    using base_engine_type::gather_accum;
+    using base_engine_type::active_superstep;
+    using base_engine_type::active_minorstep;
+    using base_engine_type::num_active_vertices;
+    using base_engine_type::completed_applys;
+    using base_engine_type::shared_lvid_counter;
+    using base_engine_type::thread_barrier;
+    using base_engine_type::per_thread_compute_time;
+    using base_engine_type::activ_exchange;
+    using base_engine_type::EVENT_APPLIES;
+#ifdef COMM_STATS
+    using base_engine_type::num_send_activs;
+    using base_engine_type::num_send_updates;
+    using base_engine_type::num_send_updates_activs;
+#endif // COMM_STATS
+
+    /**
+     * \brief The number of vertices which were skipped in the apply
+     * phase because all of their lanes have converged.
+     */
+    atomic<size_t> num_converged_vertices;
+
+    /**
+     * \brief The lanes committed by the applys (or source_inits) of
+     * each thread in the current superstep.
+     */
+    std::vector<lane_mask_type> thread_lanes;
+
+    /**
+     * \brief The lanes changed by some vertex of the cluster in the
+     * last superstep.
+     */
+    lane_mask_type live_lanes;
+
+    /**
+     * \brief The lanes which have converged in the whole cluster and
+     * are dropped from the messages.
+     */
+    lane_mask_type retired_lanes;
+
+    /// The query run by each lane, which moves when lanes are compacted
+    std::vector<size_t> lane_queries;
+
+    /// The number of lanes which have retired since construction
+    size_t num_retired_lanes;
+
+    /// Set if the lanes are compacted before the next superstep
+    bool compact_pending;
+
+    /// The retired lanes whose results have not been emitted yet
+    lane_mask_type unemitted_lanes;
+
+    /// The emitted lanes which can run a queued query
+    lane_mask_type free_lanes;
+
+    /// The lanes admitting a queued query at the end of this superstep
+    lane_mask_type recycled_lanes;
+
+    /**
+     * \brief The sources of the queued queries.  Only the queue of
+     * machine 0 is used.
+     */
+    std::deque<vertex_id_type> queued_sources;
+
+    /// Protects queued_sources
+    mutex queue_lock;
+
+    /// The seed messages of the admitted queries on the local masters
+    std::vector<std::pair<lvid_type, message_type> > seeds;
+
+    /// The id of the next admitted query
+    size_t next_query;
+
+  public:
+    /// The query of a lane which has never run a query
+    static const size_t NO_QUERY = size_t(-1);
+
+    /**
+     * \brief Construct a multi-instance synchronous engine for a
+     * given graph and options.
+     *
+     * See \ref powerlyra_sync_engine::powerlyra_sync_engine for the
+     * available options.
+     */
+    dimitra_sync_engine(distributed_control& dc, graph_type& graph,
+                        const graphlab_options& opts = graphlab_options()) :
+      base_engine_type(dc, graph, opts), num_converged_vertices(0),
+      thread_lanes(opts.get_ncpus()), num_retired_lanes(0),
+      compact_pending(false), next_query(0) {
+      // the pull candidates would not get any lane
+      if (this->direction != base_engine_type::DIRECTION_PUSH) {
+        logstream(LOG_FATAL)
+          << "direction is not supported by the multi-instance engines" << std::endl;
+      }
+      // the pipelined apply would bypass the lane bookkeeping of execute_applys
+      if (this->pipeline) {
+        logstream(LOG_FATAL)
+          << "pipeline is not supported by the multi-instance engines" << std::endl;
+      }
+    }
+
+    /**
+     * \brief Get the number of vertices whose lanes had all converged
+     * after apply since the engine was constructed.
+     */
+    size_t num_converged() const { return num_converged_vertices.value; }
+
+    /// Get the number of lanes changed in the last superstep
+    size_t num_live_lanes() const { return live_lanes.count(); }
+
+    /// Get the number of lanes which have retired since construction
+    size_t num_retired() const { return num_retired_lanes; }
+
+    /**
+     * \brief Get the query run by a lane, which is the lane itself
+     * unless the lanes have been compacted.
+     */
+    size_t lane_query(size_t lane) const {
+      return lane < lane_queries.size() ? lane_queries[lane] : lane;
+    }
+
+    /**
+     * \brief Queues source vertices of queries to be admitted into
+     * freed lanes with the <b>stream_queries</b> option.
+     *
+     * Only the queries queued on machine 0 are admitted, and they may
+     * be queued from another thread while the engine runs.  The
+     * queries get consecutive ids following the lanes of the initial
+     * sources, in order of admission.  The engine does not terminate
+     * while queries are queued or lanes are live, so every admitted
+     * query is emitted.
+     */
+    void queue_queries(const std::vector<vertex_id_type>& sources) {
+      queue_lock.lock();
+      queued_sources.insert(queued_sources.end(), sources.begin(), sources.end());
+      queue_lock.unlock();
+    }
+
+    /// Get the number of queued queries which have not been admitted
+    size_t num_queued() {
+      queue_lock.lock();
+      const size_t n = queued_sources.size();
+      queue_lock.unlock();
+      return n;
+    }
+
+  protected:
+    /**
+     * \brief Sets the lanes of the vertex program from the message
+     * of the local vertex.
+     *
+     * @return false if the message carries no lane.
+     */
+    bool init_lanes(lvid_type lvid, bool drop_retired);
+
+    /**
+     * \brief Narrows the lanes of the vertex program to the lanes
+     * changed by apply (or source_init).
+     *
+     * @return false if all lanes of the vertex have converged, in which
+     * case the vertex program is cleared.
+     */
+    bool commit_lanes(lvid_type lvid, size_t thread_id);
+
+    /**
+     * \brief OR-reduces the lanes committed by all threads of all
+     * machines into the live lanes and retires the lanes which were
+     * live before but have not changed.  Called by all threads at the
+     * end of the phase.
+     */
+    void reduce_lanes(size_t thread_id);
+
+    /**
+     * \brief Emits the results of the retired lanes, then drops them
+     * from the lane vectors of all local vertices and pending messages.
+     * Called by all threads before the messages are received.
+     */
+    void compact_lanes(size_t thread_id);
+
+    /**
+     * \brief Sends the vertex data and vertex program of a master to
+     * its mirrors after its lanes have been committed, and schedules
+     * it for scatter if needed.
+     */
+    void sync_committed(context_type& context, lvid_type lvid,
+                        size_t thread_id);
+
+    /// Returns true if the lanes should be compacted now
+    bool should_compact() const;
+
+    /**
+     * \brief Emits the retired lanes and admits the queued queries into
+     * the freed lanes with the <b>stream_queries</b> option.
+     */
+    void end_superstep();
+
+    /**
+     * \brief With the <b>stream_queries</b> option, returns true while
+     * lanes are live, which are retired and emitted by the next
+     * superstep, or while queries are queued on machine 0 and there
+     * are free lanes to admit them.
+     */
+    bool has_pending_work();
+
+    /**
+     * \brief Emits the unemitted lanes on the local masters and resets
+     * the recycled lanes on all local vertices.
+     */
+    void execute_retire(size_t thread_id);
+
+    /**
+     * \brief Execute the \ref graphlab::ivertex_program::source_init
+     * function on the seeds of the admitted queries.
+     */
+    void execute_seed_init(size_t thread_id);
+
+    /// a |= b, where an empty mask stands for no lane
+    static void merge_lanes(lane_mask_type& a, const lane_mask_type& b);
+
+    /**
+     * \brief Invoke the \ref graphlab::ivertex_program::init function
+     * on all vertex programs whose inbound message carries active
+     * lanes.
+     */
+    void receive_messages(size_t thread_id);
+
+    /**
+     * \brief Execute the \ref graphlab::ivertex_program::apply function
+     * on all active vertices and only synchronize and scatter the
+     * vertices with changed lanes.
+     */
+    void execute_applys(size_t thread_id);
+
+    /**
+     * \brief Execute the \ref graphlab::ivertex_program::source_init
+     * function on all signaled sources with the lanes of their
+     * messages.
+     */
+    void execute_source_init(size_t thread_id);
+
+  }; // end of class dimitra_sync_engine
+
+
+
+  template<typename VertexProgram>
+  inline bool dimitra_sync_engine<VertexProgram>::
+  init_lanes(lvid_type lvid, const bool drop_retired) {
+    lane_mask_type lanes;
+    vertex_programs[lvid].message_lanes(messages[lvid], lanes);
+    // retired lanes are not run again, unless signaled as sources
+    if (drop_retired && retired_lanes.size() == lanes.size())
+      lanes.vec_op_set_mask(retired_lanes, false);
+    if (lanes.vec_all_zeros()) return false;
+    vertex_programs[lvid].set_active_lanes(lanes);
+    return true;
+  } // end of init_lanes
+
+
+  template<typename VertexProgram>
+  inline bool dimitra_sync_engine<VertexProgram>::
+  commit_lanes(lvid_type lvid, const size_t thread_id) {
+    lane_mask_type lanes;
+    vertex_programs[lvid].changed_lanes(lanes);
+    if (lanes.vec_all_zeros()) {
+      vertex_programs.reset(lvid);
+      return false;
+    }
+    merge_lanes(thread_lanes[thread_id], lanes);
+    vertex_programs[lvid].set_active_lanes(lanes);
+    return true;
+  } // end of commit_lanes
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  reduce_lanes(const size_t thread_id) {
+    thread_barrier.wait();
+    if (thread_id == 0) {
+      lane_mask_type lanes;
+      for (size_t i = 0; i < thread_lanes.size(); ++i) {
+        merge_lanes(lanes, thread_lanes[i]);
+        thread_lanes[i] = lane_mask_type();
+      }
+      rmi.all_reduce2(lanes, merge_lanes);
+      // no lane has changed anywhere
+      if (lanes.size() == 0) lanes.resize(live_lanes.size());
+      const bool first = live_lanes.size() == 0;
+      if (lane_queries.size() != lanes.size()) {
+        lane_queries.resize(lanes.size());
+        for (size_t i = 0; i < lane_queries.size(); ++i) lane_queries[i] = i;
+        next_query = lanes.size();
+      }
+      if (retired_lanes.size() != lanes.size()) {
+        retired_lanes = lane_mask_type(lanes.size());
+        unemitted_lanes = lane_mask_type(lanes.size());
+        free_lanes = lane_mask_type(lanes.size());
+      }
+      // lanes signaled again as sources run again
+      retired_lanes.vec_op_set_mask(lanes, false);
+      free_lanes.vec_op_set_mask(lanes, false);
+      // the lanes which were live and did not change have converged
+      size_t nretired = 0;
+      for (size_t i = 0; i < lanes.size(); ++i) {
+        if (lanes.test_bit(i)) continue;
+        if (first) {
+          // no source was signaled in this lane
+          retired_lanes.set_single(true, i);
+          free_lanes.set_single(true, i);
+          lane_queries[i] = NO_QUERY;
+        } else if (live_lanes.test_bit(i)) {
+          retired_lanes.set_single(true, i);
+          if (stream_queries) unemitted_lanes.set_single(true, i);
+          ++nretired;
+        }
+      }
+      live_lanes = lanes;
+      num_retired_lanes += nretired;
+      const size_t nlive = live_lanes.count();
+      if (nretired > 0 && rmi.procid() == 0) {
+        logstream(LOG_INFO) << "Iteration " << iteration_counter << ": "
+                            << nretired << " lanes retired, "
+                            << nlive << " lanes live" << std::endl;
+      }
+      compact_pending = should_compact();
+    }
+    thread_barrier.wait();
+  } // end of reduce_lanes
+
+
+  template<typename VertexProgram>
+  inline bool dimitra_sync_engine<VertexProgram>::
+  should_compact() const {
+    const size_t nlive = live_lanes.count();
+    return lane_compaction && !stream_queries && nlive > 0 &&
+           2 * nlive <= live_lanes.size();
+  } // end of should_compact
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  end_superstep() {
+    if (!stream_queries) return;
+    // the lanes emitted now are free once their results are out
+    lane_mask_type available = free_lanes;
+    merge_lanes(available, unemitted_lanes);
+    const size_t navailable = available.count();
+    std::vector<vertex_id_type> admitted;
+    if (navailable > 0) {
+      if (rmi.procid() == 0) {
+        queue_lock.lock();
+        while (admitted.size() < navailable && !queued_sources.empty()) {
+          admitted.push_back(queued_sources.front());
+          queued_sources.pop_front();
+        }
+        queue_lock.unlock();
+      }
+      rmi.broadcast(admitted, rmi.procid() == 0);
+    }
+
+    // assign the admitted queries to the available lanes in order
+    recycled_lanes = lane_mask_type(live_lanes.size());
+    std::vector<size_t> admitted_lanes;
+    for (size_t i = 0; i < available.size() &&
+           admitted_lanes.size() < admitted.size(); ++i) {
+      if (!available.test_bit(i)) continue;
+      recycled_lanes.set_single(true, i);
+      admitted_lanes.push_back(i);
+    }
+    if (unemitted_lanes.vec_all_zeros() && admitted.empty()) return;
+
+    this->run_synchronous(&dimitra_sync_engine::execute_retire);
+    merge_lanes(free_lanes, unemitted_lanes);
+    unemitted_lanes.clear();
+    if (admitted.empty()) return;
+
+    // seed the admitted queries on their masters, merging the seeds of
+    // queries sharing a source
+    const vertex_program_type vprog;
+    std::map<lvid_type, size_t> seed_index;
+    seeds.clear();
+    for (size_t i = 0; i < admitted.size(); ++i) {
+      const size_t lane = admitted_lanes[i];
+      lane_queries[lane] = next_query++;
+      if (!graph.is_master(admitted[i])) continue;
+      const lvid_type lvid = graph.vertex(admitted[i]).local_id();
+      typename std::map<lvid_type, size_t>::iterator it = seed_index.find(lvid);
+      if (it == seed_index.end()) {
+        seed_index[lvid] = seeds.size();
+        seeds.push_back(std::make_pair(lvid, vprog.source_message(lane)));
+      } else {
+        seeds[it->second].second += vprog.source_message(lane);
+      }
+    }
+    free_lanes.vec_op_set_mask(recycled_lanes, false);
+    retired_lanes.vec_op_set_mask(recycled_lanes, false);
+    // the cached accumulators still hold the old queries
+    if (use_cache) has_cache.clear();
+    // the vertices scattered in this superstep are done
+    active_minorstep.clear();
+    this->run_synchronous(&dimitra_sync_engine::execute_seed_init);
+    this->run_synchronous(&dimitra_sync_engine::execute_source_scatter);
+    seeds.clear();
+    // the seeds belong to this superstep, they were not changed in the
+    // next one
+    for (size_t i = 0; i < thread_lanes.size(); ++i) {
+      thread_lanes[i] = lane_mask_type();
+    }
+    merge_lanes(live_lanes, recycled_lanes);
+    if (rmi.procid() == 0) {
+      logstream(LOG_INFO) << "Iteration " << iteration_counter << ": "
+                          << admitted.size() << " queries admitted" << std::endl;
+    }
+  } // end of end_superstep
+
+
+  template<typename VertexProgram>
+  bool dimitra_sync_engine<VertexProgram>::
+  has_pending_work() {
+    if (!stream_queries) return false;
+    // the live lanes are the same on all machines
+    if (live_lanes.count() > 0) return true;
+    size_t nqueued = 0;
+    if (rmi.procid() == 0 && free_lanes.count() > 0) nqueued = num_queued();
+    rmi.all_reduce(nqueued);
+    return nqueued > 0;
+  } // end of has_pending_work
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  execute_retire(const size_t thread_id) {
+    const vertex_program_type vprog;
+    const bool emit = !unemitted_lanes.vec_all_zeros();
+    const bool reset = !recycled_lanes.vec_all_zeros();
+    for (lvid_type lvid = thread_id; lvid < graph.num_local_vertices();
+         lvid += ncpus) {
+      vertex_type vertex(graph.l_vertex(lvid));
+      if (emit && graph.l_is_master(lvid)) {
+        vprog.retire_lanes(vertex, unemitted_lanes, lane_queries);
+      }
+      if (reset) vprog.reset_lanes(vertex, recycled_lanes);
+    }
+  } // end of execute_retire
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  execute_seed_init(const size_t thread_id) {
+    context_type context(*this, graph);
+    const size_t TRY_RECV_MOD = 1000;
+    size_t vcount = 0;
+
+    for (size_t i = thread_id; i < seeds.size(); i += ncpus) {
+      const lvid_type lvid = seeds[i].first;
+      const message_type& message = seeds[i].second;
+      lane_mask_type lanes;
+      vertex_programs.reset(lvid);
+      vertex_programs[lvid].message_lanes(message, lanes);
+      vertex_programs[lvid].set_active_lanes(lanes);
+      vertex_type vertex(graph.l_vertex(lvid));
+      vertex_programs[lvid].source_init(context, vertex, message);
+      if (!commit_lanes(lvid, thread_id)) continue;
+      sync_committed(context, lvid, thread_id);
+
+      if(++vcount % TRY_RECV_MOD == 0) {
+        this->recv_updates_activs(); this->recv_updates();
+      }
+    }
+
+    this->partial_flush_updates();
+    thread_barrier.wait();
+    // Flush the buffer and finish receiving any remaining updates.
+    if(thread_id == 0) this->flush_updates();
+    thread_barrier.wait();
+    this->recv_updates_activs(); this->recv_updates();
+  } // end of execute_seed_init
+
+
+  template<typename VertexProgram>
+  inline void dimitra_sync_engine<VertexProgram>::
+  sync_committed(context_type& context, lvid_type lvid,
+                 const size_t thread_id) {
+    // determine if a scatter operation is needed
+    const vertex_program_type& const_vprog = vertex_programs[lvid];
+    const vertex_type const_vertex(graph.l_vertex(lvid));
+
+    if (const_vprog.scatter_edges(context, const_vertex)
+        != graphlab::NO_EDGES) {
+      // send Ax1 and Sx1
+      this->send_updates_activs(lvid, thread_id);
+      active_minorstep.set_bit(lvid);
+#ifdef COMM_STATS
+      ++num_send_updates_activs;
+#endif  // COMM_STATS
+    } else {
+      // send Ax1
+      this->send_updates(lvid, thread_id);
+      vertex_programs.reset(lvid);
+#ifdef COMM_STATS
+      ++num_send_updates;
+#endif // COMM_STATS
+    }
+  } // end of sync_committed
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  compact_lanes(const size_t thread_id) {
+    const vertex_program_type vprog;
+    if (thread_id == 0) {
+      // the dropped lanes which ran a query
+      unemitted_lanes = lane_mask_type(live_lanes.size());
+      for (size_t i = 0; i < live_lanes.size(); ++i) {
+        if (!live_lanes.test_bit(i) && lane_queries[i] != NO_QUERY)
+          unemitted_lanes.set_single(true, i);
+      }
+    }
+    thread_barrier.wait();
+    // emit their results, which the compaction drops
+    if (!unemitted_lanes.vec_all_zeros()) {
+      for (lvid_type lvid = thread_id; lvid < graph.num_local_vertices();
+           lvid += ncpus) {
+        if (!graph.l_is_master(lvid)) continue;
+        const vertex_type vertex(graph.l_vertex(lvid));
+        vprog.retire_lanes(vertex, unemitted_lanes, lane_queries);
+      }
+      thread_barrier.wait();
+    }
+    if (thread_id == 0) vprog.compact_lanes(live_lanes);
+    thread_barrier.wait();
+    for (lvid_type lvid = thread_id; lvid < graph.num_local_vertices();
+         lvid += ncpus) {
+      vertex_type vertex(graph.l_vertex(lvid));
+      vprog.compact_vertex(vertex, live_lanes);
+      if (has_message.get(lvid)) vprog.compact_message(messages[lvid], live_lanes);
+    }
+    thread_barrier.wait();
+    if (thread_id == 0) {
+      // the cached accumulators still hold the dropped lanes
+      if (use_cache) has_cache.clear();
+      std::vector<size_t> queries;
+      for (size_t i = 0; i < lane_queries.size(); ++i) {
+        if (live_lanes.test_bit(i)) queries.push_back(lane_queries[i]);
+      }
+      lane_queries.swap(queries);
+      if (rmi.procid() == 0) {
+        logstream(LOG_INFO) << "Compacted " << live_lanes.size() << " lanes to "
+                            << lane_queries.size() << " lanes" << std::endl;
+      }
+      live_lanes.compact(live_lanes);
+      retired_lanes = lane_mask_type(live_lanes.size());
+      unemitted_lanes = lane_mask_type(live_lanes.size());
+      free_lanes = lane_mask_type(live_lanes.size());
+      compact_pending = false;
+      // the entries reset from now on take the compacted lanes
+      vertex_programs.refresh_default();
+      messages.refresh_default();
+      gather_accum.refresh_default();
+    }
+    thread_barrier.wait();
+  } // end of compact_lanes
+
+
+  template<typename VertexProgram>
+  inline void dimitra_sync_engine<VertexProgram>::
+  merge_lanes(lane_mask_type& a, const lane_mask_type& b) {
+    if (b.size() == 0) return;
+    if (a.size() == 0) a = b;
+    else lane_mask_type::pair_op_or(a, b);
+  } // end of merge_lanes
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  receive_messages(const size_t thread_id) {
+    if (compact_pending) compact_lanes(thread_id);
+    context_type context(*this, graph);
+    fixed_dense_bitset<8 * sizeof(size_t)> local_bitset; // a word-size = 64 bit
+    const size_t TRY_RECV_MOD = 100;
+    size_t vcount = 0;
+    size_t nactive_inc = 0;
+
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of has_message holding a bit at a time
+    while (has_message.next_word(shared_lvid_counter,
+                                 lvid_block_start, lvid_bit_block)) {
+      // initialize a word sized bitfield
+      local_bitset.clear();
+      local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
+      foreach(size_t lvid_block_offset, local_bitset) {
+        lvid_type lvid = lvid_block_start + lvid_block_offset;
+        if (lvid >= graph.num_local_vertices()) break;
+
+        ASSERT_TRUE(graph.l_is_master(lvid));
+        // Messages without active lanes do not activate the vertex
+        if (!init_lanes(lvid, true)) {
+          messages.reset(lvid);
+          continue;
+        }
+        // The vertex becomes active for this superstep
+        active_superstep.set_bit(lvid);
+        ++nactive_inc;
+        // Pass the message to the vertex program
+        const vertex_type vertex(graph.l_vertex(lvid));
+        vertex_programs[lvid].init(context, vertex, messages[lvid]);
+        // clear the message to save memory
+        messages.reset(lvid);
+        if (sched_allv) continue;
+        // Determine if the gather should be run
+        const vertex_program_type& const_vprog = vertex_programs[lvid];
+        edge_dir_type gather_dir = const_vprog.gather_edges(context, vertex);
+        if(gather_dir != graphlab::NO_EDGES) {
+          active_minorstep.set_bit(lvid);
+          // send Gx1 msgs (the vertex program carries the active lanes)
+          if (this->high_lvid(lvid)
+              || (this->low_lvid(lvid) // only if gather via out-edge
+                && ((gather_dir == graphlab::ALL_EDGES)
+                    || (gather_dir == graphlab::OUT_EDGES)))) {
+            this->send_activs(lvid, thread_id);
+#ifdef COMM_STATS
+            ++num_send_activs;
+#endif // COMM_STATS
+          }
+        }
+        if(++vcount % TRY_RECV_MOD == 0) this->recv_activs();
+      }
+    }
+    num_active_vertices += nactive_inc;
+    activ_exchange.partial_flush();
+    // Flush the buffer and finish receiving any remaining vertex
+    // programs.
+    thread_barrier.wait();
+    // Flush the buffer and finish receiving any remaining activations.
+    if(thread_id == 0) activ_exchange.flush();
+    thread_barrier.wait();
+    this->recv_activs();
+  } // end of receive_messages
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  execute_applys(const size_t thread_id) {
+    context_type context(*this, graph);
+    fixed_dense_bitset<8 * sizeof(size_t)> local_bitset;  // allocate a word size = 64bits
+    const size_t TRY_RECV_MOD = 1000;
+    size_t vcount = 0;
+    size_t napply_inc = 0;
+    size_t nconverged_inc = 0;
+    timer ti;
+
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of active_superstep holding a bit at a time
+    while (active_superstep.next_word(shared_lvid_counter,
+                                      lvid_block_start, lvid_bit_block)) {
+      // initialize a word sized bitfield
+      local_bitset.clear();
+      local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
+      foreach(size_t lvid_block_offset, local_bitset) {
+        lvid_type lvid = lvid_block_start + lvid_block_offset;
+        if (lvid >= graph.num_local_vertices()) break;
+
+        // [TARGET]: High/Low-degree Masters
+        // Only master vertices can be active in a super-step
+        ASSERT_TRUE(graph.l_is_master(lvid));
+        vertex_type vertex(graph.l_vertex(lvid));
+        // Get the local accumulator.  Note that it is possible that
+        // the gather_accum was not set during the gather.
+        const gather_type& accum = gather_accum[lvid];
+        INCREMENT_EVENT(EVENT_APPLIES, 1);
+        vertex_programs[lvid].apply(context, vertex, accum);
+        // record an apply as a completed task
+        ++napply_inc;
+        // clear the accumulator to save some memory
+        gather_accum.reset(lvid);
+        // the vertex data of converged lanes is unchanged, so there is
+        // nothing to synchronize or scatter
+        if (!commit_lanes(lvid, thread_id)) {
+          ++nconverged_inc;
+          continue;
+        }
+        sync_committed(context, lvid, thread_id);
+
+        if(++vcount % TRY_RECV_MOD == 0) {
+          this->recv_updates_activs(); this->recv_updates();
+        }
+      }
+    } // end of loop over vertices to run apply
+    completed_applys += napply_inc;
+    num_converged_vertices += nconverged_inc;
+    per_thread_compute_time[thread_id] += ti.current_time();
+    this->partial_flush_updates();
+    thread_barrier.wait();
+    // Flush the buffer and finish receiving any remaining updates.
+    if(thread_id == 0) this->flush_updates();
+    thread_barrier.wait();
+    this->recv_updates_activs(); this->recv_updates();
+    reduce_lanes(thread_id);
+  } // end of execute_applys
+
+
+  template<typename VertexProgram>
+  void dimitra_sync_engine<VertexProgram>::
+  execute_source_init(const size_t thread_id) {
+    context_type context(*this, graph);
+    fixed_dense_bitset<8 * sizeof(size_t)> local_bitset;  // allocate a word size = 64bits
+    const size_t TRY_RECV_MOD = 1000;
+    size_t vcount = 0;
+
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of active_superstep holding a bit at a time
+    while (active_superstep.next_word(shared_lvid_counter,
+                                      lvid_block_start, lvid_bit_block)) {
+      // initialize a word sized bitfield
+      local_bitset.clear();
+      local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
+      foreach(size_t lvid_block_offset, local_bitset) {
+        lvid_type lvid = lvid_block_start + lvid_block_offset;
+        if (lvid >= graph.num_local_vertices()) break;
+
+        // [TARGET]: High/Low-degree Masters
+        // Only master vertices can be active in a super-step
+        ASSERT_TRUE(graph.l_is_master(lvid));
+        const bool has_lanes = init_lanes(lvid, false);
+        if (has_lanes) {
+          vertex_type vertex(graph.l_vertex(lvid));
+          vertex_programs[lvid].source_init(context, vertex, messages[lvid]);
+        }
+        // clear the message to save some memory
+        messages.reset(lvid);
+        if (!has_lanes || !commit_lanes(lvid, thread_id)) continue;
+        sync_committed(context, lvid, thread_id);
+
+        if(++vcount % TRY_RECV_MOD == 0) {
+          this->recv_updates_activs(); this->recv_updates();
+        }
+      }
+    } // end of loop over vertices to run source_init
+
+    this->partial_flush_updates();
+    thread_barrier.wait();
+    // Flush the buffer and finish receiving any remaining updates.
+    if(thread_id == 0) this->flush_updates();
+    thread_barrier.wait();
+    this->recv_updates_activs(); this->recv_updates();
+    reduce_lanes(thread_id);
+  } // end of execute_source_init
+
+}; // namespace
+
+
+#include <graphlab/macros_undef.hpp>
+
+
+#endif
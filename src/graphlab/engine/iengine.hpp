@@ -212,6 +212,17 @@ namespace graphlab {
     virtual void signal_source(vertex_id_type vertex,
                         const message_type& message = message_type()) {}
 
+    // when initializing a batch of source vertices (one per query),
+    // call engine_ptr->signal_sources(sources) once instead of
+    // signal_source per vertex. Engines seeding all sources in a
+    // single pass override this.
+    virtual void signal_sources(
+        const std::vector<std::pair<vertex_id_type, message_type> >& sources) {
+      for (size_t i = 0; i < sources.size(); ++i) {
+        signal_source(sources[i].first, sources[i].second);
+      }
+    }
+
     /**
      * \brief Compute the total number of updates (calls to apply)
      * executed since start was last invoked.
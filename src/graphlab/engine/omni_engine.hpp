@@ -59,6 +59,8 @@
 #include <graphlab/engine/async_consistent_engine.hpp>
 #include <graphlab/engine/powerlyra_sync_engine.hpp>
 #include <graphlab/engine/powerlyra_async_engine.hpp>
+#include <graphlab/engine/dimitra_sync_engine.hpp>
+#include <graphlab/engine/dimitra_async_engine.hpp>
 
 namespace graphlab {
 
@@ -99,6 +101,12 @@ namespace graphlab {
    *  (\ref synchronous_engine)
    *  \li "asynchronous" or "async": uses the asynchronous engine
    *  (\ref async_consistent_engine)
+   *  \li "msync" or "dimitra_synchronous": uses the multi-instance
+   *  synchronous engine (\ref dimitra_sync_engine), which requires a
+   *  vertex program implementing \ref imulti_vertex_program
+   *  \li "masync" or "dimitra_asynchronous": uses the multi-instance
+   *  asynchronous engine (\ref dimitra_async_engine), which requires a
+   *  vertex program implementing \ref imulti_vertex_program
 *
    * \see graphlab::synchronous_engine
    * \see graphlab::async_consistent_engine
@@ -174,6 +182,16 @@ namespace graphlab {
      */
     typedef powerlyra_async_engine<VertexProgram> powerlyra_async_engine_type;
 
+    /**
+     * \brief the type of DiMITra (multi-instance) synchronous engine
+     */
+    typedef dimitra_sync_engine<VertexProgram> dimitra_sync_engine_type;
+
+    /**
+     * \brief the type of DiMITra (multi-instance) asynchronous engine
+     */
+    typedef dimitra_async_engine<VertexProgram> dimitra_async_engine_type;
+
 
 
   private:
@@ -193,6 +211,28 @@ namespace graphlab {
      */
     omni_engine(const omni_engine& other ) { }
 
+    /**
+     * \brief Construct a multi-instance engine. Only instantiated for
+     * vertex programs implementing imulti_vertex_program.
+     */
+    template<typename Engine>
+    static iengine_type* new_multi_engine(distributed_control& dc,
+                                          graph_type& graph,
+                                          const graphlab_options& options,
+                                          boost::true_type) {
+      return new Engine(dc, graph, options);
+    }
+
+    template<typename Engine>
+    static iengine_type* new_multi_engine(distributed_control& dc,
+                                          graph_type& graph,
+                                          const graphlab_options& options,
+                                          boost::false_type) {
+      logstream(LOG_FATAL) << "The DiMITra engines require a vertex program "
+                           << "derived from imulti_vertex_program." << std::endl;
+      return NULL;
+    }
+
 
   public:
 
@@ -239,10 +279,12 @@ namespace graphlab {
         engine_ptr = new powerlyra_async_engine_type(dc, graph, new_options);
       } else if (engine_type == "msync" || engine_type == "dimitra_synchronous") {
         logstream(LOG_INFO) << "Using the DiMITra Synchronous engine." << std::endl;
-        // TODO: create DiMITra sync engine_ptr here
+        engine_ptr = new_multi_engine<dimitra_sync_engine_type>(
+            dc, graph, new_options, is_multi_vertex_program<VertexProgram>());
       } else if (engine_type == "masync" || engine_type == "dimitra_asynchronous") {
         logstream(LOG_INFO) << "Using the DiMITra Asynchronous engine." << std::endl;
-        // TODO: create DiMITra async engine_ptr here
+        engine_ptr = new_multi_engine<dimitra_async_engine_type>(
+            dc, graph, new_options, is_multi_vertex_program<VertexProgram>());
       } else {
         logstream(LOG_FATAL) << "Invalid engine type: " << engine_type << std::endl;
       }
@@ -268,6 +310,11 @@ namespace graphlab {
         engine_ptr->signal_source(vertex_id, message);
     }
 
+    void signal_sources(
+        const std::vector<std::pair<vertex_id_type, message_type> >& sources) {
+        engine_ptr->signal_sources(sources);
+    }
+
     size_t num_updates() const { return engine_ptr->num_updates(); }
     float elapsed_seconds() const { return engine_ptr->elapsed_seconds(); }
     int iteration() const { return engine_ptr->iteration(); }
@@ -296,7 +296,7 @@ namespace graphlab {
      */
     typedef icontext<graph_type, gather_type, message_type> icontext_type;
 
-  private:
+  protected:
     /// \internal \brief The base type of all schedulers
     message_array<message_type> messages;
 
@@ -462,7 +462,7 @@ namespace graphlab {
       rmi.barrier();
     }
 
-  private:
+  protected:
 
     /**
      * \internal
@@ -598,7 +598,7 @@ namespace graphlab {
  *                           Signaling Interface                          *
  **************************************************************************/
 
-  private:
+  protected:
 
     /**
      * \internal
@@ -787,7 +787,7 @@ namespace graphlab {
     }
 
 
-  private: 
+  protected:
 
     /**
      * Gets a task from the scheduler and the associated message
@@ -903,7 +903,11 @@ namespace graphlab {
           lvid_type a = edge.source().local_id(), b = edge.target().local_id();
           vertexlocks[std::min(a,b)].lock();
           vertexlocks[std::max(a,b)].lock();
-          accum += vprog.gather(context, vertex, edge);
+          if (accum.has_value) {
+            gather_accumulate(vprog, context, vertex, edge, accum.value);
+          } else {
+            accum.set(vprog.gather(context, vertex, edge));
+          }
           vertexlocks[a].unlock();
           vertexlocks[b].unlock();
         }
@@ -915,7 +919,11 @@ namespace graphlab {
           lvid_type a = edge.source().local_id(), b = edge.target().local_id();
           vertexlocks[std::min(a,b)].lock();
           vertexlocks[std::max(a,b)].lock();
-          accum += vprog.gather(context, vertex, edge);
+          if (accum.has_value) {
+            gather_accumulate(vprog, context, vertex, edge, accum.value);
+          } else {
+            accum.set(vprog.gather(context, vertex, edge));
+          }
           vertexlocks[a].unlock();
           vertexlocks[b].unlock();
         }
@@ -1020,7 +1028,7 @@ namespace graphlab {
      * If this function is called with vertex locks acquired, prelocked
      * should be true. Otherwise it should be false.
      */
-    void eval_sched_task(const lvid_type lvid,
+    virtual void eval_sched_task(const lvid_type lvid,
                          const message_type& msg) {
       const typename graph_type::vertex_record& rec = graph.l_get_vertex_record(lvid);
       vertex_id_type vid = rec.gvid;
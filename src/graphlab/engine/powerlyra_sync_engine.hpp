@@ -29,11 +29,13 @@
 #define GRAPHLAB_POWERLYRA_SYNC_ENGINE_HPP
 
 #include <deque>
+#include <utility>
 #include <boost/bind.hpp>
 
 #include <graphlab/engine/iengine.hpp>
 
 #include <graphlab/vertex_program/ivertex_program.hpp>
+#include <graphlab/vertex_program/imulti_vertex_program.hpp>
 #include <graphlab/vertex_program/icontext.hpp>
 #include <graphlab/vertex_program/context.hpp>
 
@@ -48,6 +50,10 @@
 #include <graphlab/util/tracepoint.hpp>
 #include <graphlab/util/memory_info.hpp>
 #include <graphlab/util/triple.hpp>
+#include <graphlab/util/dimitra_slab_vector.hpp>
+#include <graphlab/util/dimitra_frontier.hpp>
+#include <graphlab/util/dimitra_work_queue.hpp>
+#include <graphlab/util/dimitra_lane_delta.hpp>
 
 #include <graphlab/rpc/dc_dist_object.hpp>
 #include <graphlab/rpc/distributed_event_log.hpp>
@@ -207,6 +213,103 @@ namespace graphlab {
    * for the snapshot. The path including folder and file prefix in
    * which the snapshots should be saved.
    *
+   * \li <b>delta_sync</b>: (default: false) Only for multi-instance
+   * vertex programs (\ref graphlab::imulti_vertex_program).  After
+   * apply, the mirrors only receive the lanes returned by
+   * \ref imulti_vertex_program::changed_lanes together with the lane
+   * mask, instead of the whole vertex data, and vertices without any
+   * changed lane are not synchronized at all.  The vertex data must
+   * provide <code>masked_save(oarchive&, const automi_bitvec<bool>&)</code>
+   * and the matching <code>masked_load</code>.
+   *
+   * \li <b>masked_messages</b>: (default: false) Only for
+   * multi-instance vertex programs.  A message sent from a mirror to
+   * its master only carries the lanes returned by
+   * \ref imulti_vertex_program::message_lanes together with the lane
+   * mask.  The master loads them into a default constructed message,
+   * whose other lanes must hold the identity of the message combiner.
+   * The message type must provide
+   * <code>masked_save(oarchive&, const automi_bitvec<bool>&)</code>
+   * and the matching <code>masked_load</code>.
+   *
+   * \li <b>lane_compaction</b>: (default: false) Only for the
+   * \ref dimitra_sync_engine.  Once at least half of the lanes have
+   * retired, the lane vectors of the vertex data and of the pending
+   * messages are compacted to the lanes still running, see
+   * \ref imulti_vertex_program::compact_vertex.  The results of the
+   * dropped lanes are emitted through
+   * \ref imulti_vertex_program::retire_lanes first.
+   *
+   * \li <b>stream_queries</b>: (default: false) Only for the
+   * \ref dimitra_sync_engine.  The results of every retired lane are
+   * emitted through \ref imulti_vertex_program::retire_lanes, and the
+   * freed lanes run the queries queued with
+   * \ref dimitra_sync_engine::queue_queries while the engine runs.
+   *
+   * \li <b>persistent_workers</b>: (default: false) Runs all the
+   * phases of a superstep in one launch of the worker threads, which
+   * wait for each other with a local barrier between the phases,
+   * instead of launching and joining the threads and running a cluster
+   * barrier once per phase.  The phases which exchange data still
+   * finish with the flush of their exchange, which delivers it
+   * cluster-wide, the signals sent by the scatter phase are delivered
+   * by the cluster barrier which starts the next superstep, and the
+   * count of active vertices is still reduced over the cluster, so the
+   * supersteps run the same; only their fixed overhead shrinks.  This
+   * pays off on graphs of large diameter, with many short supersteps.
+   * With TUNING, the time of each phase not spent by its slowest thread
+   * is reported as its overhead.
+   *
+   * \li <b>work_stealing</b>: (default: false) The gather and scatter
+   * phases split the active vertices among the threads in ranges of
+   * about the same number of local edges, and a thread which has
+   * finished its range steals half of the range of another thread (see
+   * \ref graphlab::automi_work_queue), instead of all the threads taking
+   * 64 vertices at a time from a shared counter.
+   *
+   * \li <b>hub_split</b>: (default: 0) If positive, the gather and
+   * scatter of a vertex with more than this number of local edges are
+   * run by all the threads together, each on a slice of its edges, once
+   * the other vertices are done.  The gathers of the slices go to a
+   * partial accumulator per thread, which are then summed.
+   *
+   * \li <b>direction</b>: (default: push) Only for vertex programs
+   * with the pull hooks (see \ref graphlab::has_pull_gather), and not
+   * for the multi-instance engines.  With <b>push</b>, every superstep
+   * scatters the vertices changed by its apply, as always.  With
+   * <b>pull</b>, once the first superstep has run the vertices changed
+   * by an apply are not scattered: the next superstep activates every
+   * pull candidate and gathers it with pull_gather, until a superstep
+   * changes no vertex.  With <b>auto</b>, the engine switches like a
+   * direction-optimizing BFS: after each apply it sums the edges the
+   * changed vertices would scatter (m_f) and the gather edges of the
+   * vertices which are still pull candidates in some lane (m_u), and
+   * pulls the next superstep if m_f > m_u / direction_alpha and the
+   * frontier grows, until the frontier shrinks below
+   * 1 / direction_beta of the vertices.  The gather cache cannot be
+   * used together with pull supersteps.
+   *
+   * \li <b>direction_alpha</b>, <b>direction_beta</b>: (default: 14
+   * and 24) The thresholds of <b>direction</b>=auto.
+   *
+   * \li <b>pipeline</b>: (default: false) Overlaps the exchange of the
+   * gather accumulators with the gather and apply computation.  The
+   * threads send the accumulators of the mirrors to their masters every
+   * few words of the gather instead of once at its end, and each master
+   * knows how many accumulators it waits for: one from each of its
+   * replicas with local edges in its gather direction, counted once
+   * from the mirror topology.  Once the local gathers are done, a
+   * master is applied as soon as its last accumulator has arrived,
+   * while the other accumulators are still in flight, instead of after
+   * the flush of the exchange and a cluster barrier.  The vertex data
+   * only changes after the local gathers, and the mirrors are updated
+   * at the end of the apply as before, so the supersteps compute the
+   * same.  The masters and mirrors of a vertex must gather along the
+   * same edges; not with use_cache or sched_allv, nor for the
+   * multi-instance engines.  With TUNING, the apply time is counted in
+   * the gather time, and the time the threads waited for accumulators
+   * is reported with the part of the exchange hidden behind applies.
+   *
    * \see graphlab::omni_engine
    * \see graphlab::async_consistent_engine
    * \see graphlab::semi_synchronous_engine
@@ -307,7 +410,7 @@ namespace graphlab {
      */
     typedef icontext<graph_type, gather_type, message_type> icontext_type;
 
-  private:
+  protected:
 
     /**
      * \brief Local vertex type used by the engine for fast indexing
@@ -325,6 +428,18 @@ namespace graphlab {
     typedef typename graph_type::lvid_type            lvid_type;
 
     std::vector<double> per_thread_compute_time;
+
+    /**
+     * \brief The time each thread waited for the other threads of its
+     * machine once it ran out of gather or scatter work.
+     */
+    std::vector<double> per_thread_idle_time;
+
+    /**
+     * \brief The time each thread spent working in the last gather or
+     * scatter phase, not counting its waits at the hub_split barriers.
+     */
+    std::vector<double> per_thread_busy_time;
     /**
      * \brief The actual instance of the context type used by this engine.
      */
@@ -442,6 +557,66 @@ namespace graphlab {
      */
     double postround_time;
 
+    /**
+     * \brief The time thread 0 waited for the gather accumulators of
+     * the other machines after its gathers: the flush of the exchange,
+     * or with <b>pipeline</b> the time it found no master to apply.
+     */
+    double accum_wait_time;
+
+    /**
+     * \brief With <b>pipeline</b>, the time thread 0 applied masters
+     * while accumulators of other masters were still in flight.
+     */
+    double accum_hidden_time;
+
+    /// The phases of a superstep, indexing phase_overhead
+    enum superstep_phase {
+      PHASE_EXCHANGE, PHASE_RECEIVE, PHASE_GATHER, PHASE_APPLY,
+      PHASE_SCATTER, PHASE_POSTROUND, NUM_PHASES
+    };
+
+    /// The values of the <b>direction</b> option
+    enum direction_mode { DIRECTION_PUSH, DIRECTION_PULL, DIRECTION_AUTO };
+
+    /**
+     * \brief The counts of the vertices changed by an apply, reduced
+     * over the cluster to choose the direction of the next superstep.
+     */
+    struct direction_stats : public IS_POD_TYPE {
+      /// The vertices which would scatter (n_f)
+      size_t frontier_vertices;
+      /// The edges they would scatter (m_f)
+      size_t frontier_edges;
+      /// The gather edges of the vertices which stopped being pull candidates
+      size_t settled_edges;
+      direction_stats() :
+        frontier_vertices(0), frontier_edges(0), settled_edges(0) { }
+      direction_stats& operator+=(const direction_stats& other) {
+        frontier_vertices += other.frontier_vertices;
+        frontier_edges += other.frontier_edges;
+        settled_edges += other.settled_edges;
+        return *this;
+      }
+    };
+
+    /**
+     * \brief The time of each phase not spent by its slowest thread:
+     * launching, joining and synchronizing the threads.
+     */
+    double phase_overhead[NUM_PHASES];
+
+    /**
+     * \brief The time each thread spent in the phase functions of the
+     * last phase.
+     */
+    std::vector<double> per_thread_phase_time;
+
+    /**
+     * \brief The number of launches of the worker threads by start().
+     */
+    size_t num_launches;
+
     /**
      * \brief The interval time to print status.
      */
@@ -457,6 +632,159 @@ namespace graphlab {
      */
     bool sched_allv;
 
+    /**
+     * \brief Only synchronizes the changed lanes of the vertex data
+     * to the mirrors
+     */
+    bool delta_sync;
+
+    /**
+     * \brief Only sends the lanes of messages which carry a value
+     */
+    bool masked_messages;
+
+    /**
+     * \brief Compacts the lane vectors once enough lanes have retired
+     * (only used by the multi-instance engines)
+     */
+    bool lane_compaction;
+
+    /**
+     * \brief Emits retired lanes and recycles them for queued queries
+     * (only used by the multi-instance engines)
+     */
+    bool stream_queries;
+
+    /**
+     * \brief Runs all the phases of a superstep in one launch of the
+     * worker threads
+     */
+    bool persistent_workers;
+
+    /**
+     * \brief Set by thread 0 of a persistent superstep if some vertex
+     * of the cluster is active
+     */
+    bool superstep_active;
+
+    /**
+     * \brief Splits the gather and scatter work among the threads by
+     * edge count, with work stealing
+     */
+    bool work_stealing;
+
+    /**
+     * \brief The number of local edges above which the gather and
+     * scatter of a vertex are split among the threads (0 to disable)
+     */
+    size_t hub_split;
+
+    /**
+     * \brief The work of the threads in the gather and scatter phases,
+     * with the <b>work_stealing</b> option.
+     */
+    automi_work_queue minorstep_work;
+
+    /**
+     * \brief The prefix sums of the number of local edges (plus one) of
+     * the vertices of each word of the per-vertex bitsets.
+     */
+    std::vector<size_t> word_edges;
+
+    /// The prefix sums of word_edges over the words of a sparse scan
+    std::vector<size_t> scan_edges;
+
+    /// The hubs met by each thread in the current phase
+    std::vector<std::vector<lvid_type> > thread_hubs;
+
+    /// The hubs met by all the threads in the current phase
+    std::vector<lvid_type> split_hubs;
+
+    /// The partial accumulator of each thread for each split hub
+    std::vector<gather_type> hub_accums;
+
+    /// Set if the matching partial accumulator holds a value
+    std::vector<char> hub_accum_set;
+
+    /// Whether the supersteps push, pull, or choose
+    direction_mode direction;
+
+    /// Pull when the frontier edges exceed 1/direction_alpha of the unexplored edges
+    double direction_alpha;
+
+    /// Push when the frontier shrinks below 1/direction_beta of the vertices
+    double direction_beta;
+
+    /// Set if the current superstep activates and gathers the pull candidates
+    bool pulling;
+
+    /**
+     * \brief Set after the apply phase if the next superstep pulls, in
+     * which case the scatter phase does not scatter.
+     */
+    bool pull_next;
+
+    /// The vertices which would scatter after the current apply
+    atomic<size_t> frontier_vertices;
+
+    /// The edges they would scatter
+    atomic<size_t> frontier_edges;
+
+    /// The gather edges of the masters settled by the current apply
+    atomic<size_t> settled_edges;
+
+    /**
+     * \brief The gather edges of the vertices of the cluster which are
+     * still pull candidates (m_u), with <b>direction</b>=auto.
+     */
+    size_t unexplored_edges;
+
+    /// The frontier vertices of the cluster after the previous apply
+    size_t last_frontier_vertices;
+
+    /// The number of pull supersteps run by start()
+    size_t num_pull_supersteps;
+
+    /// The masters which are no longer pull candidates
+    dense_bitset pull_settled;
+
+    /**
+     * \brief Streams the gather accumulators to the masters and applies
+     * each master once all its accumulators have arrived
+     */
+    bool pipeline;
+
+    /**
+     * \brief The number of replicas of a master, itself included, with
+     * local in-edges, out-edges, or either: those which send it an
+     * accumulator when they gather along these edges.
+     */
+    struct gather_contributors {
+      procid_t in_edges, out_edges, all_edges;
+      gather_contributors() : in_edges(0), out_edges(0), all_edges(0) { }
+    };
+
+    /// The contributors of each master, with the <b>pipeline</b> option
+    std::vector<gather_contributors> contributors;
+
+    /**
+     * \brief The accumulators each active master still waits for,
+     * guarded by the lock in vlocks like its gather_accum.
+     */
+    std::vector<size_t> pending_accums;
+
+    /// The masters which have all their accumulators and are not applied yet
+    std::vector<lvid_type> ready_masters;
+
+    /// The masters added to ready_masters in the current superstep
+    size_t num_ready_masters;
+
+    /// Guards ready_masters and num_ready_masters
+    simple_spinlock ready_lock;
+
+    /// The masters applied by the current pipelined apply
+    atomic<size_t> applied_masters;
+
     /**
      * \brief Used to stop the engine prematurely
      */
@@ -482,18 +810,29 @@ namespace graphlab {
     /**
      * \brief The vertex programs associated with each vertex on this
      * machine.
+     *
+     * The vertex programs, messages and gather accumulators are reset
+     * with reset(lvid).  For the AutoMI programs
+     * (\ref graphlab::imulti_vertex_program), whose values own lane
+     * buffers, the entries keep their storage and a reset is O(1), see
+     * \ref graphlab::automi_slab_vector.
      */
-    std::vector<vertex_program_type> vertex_programs;
+    automi_slab_vector<vertex_program_type, is_multi_vertex_program<VertexProgram>::value> vertex_programs;
 
     /**
      * \brief Vector of messages associated with each vertex.
      */
-    std::vector<message_type> messages;
+    automi_slab_vector<message_type, is_multi_vertex_program<VertexProgram>::value> messages;
 
     /**
      * \brief Bit indicating whether a message is present for each vertex.
+     *
+     * This bitset and the other per-superstep bitsets below are
+     * \ref graphlab::automi_frontier objects: when only a few vertices
+     * are active, the phases only visit, and clear, the words of the
+     * bitset which hold a set bit.
      */
-    dense_bitset has_message;
+    automi_frontier has_message;
 
 
     /**
@@ -505,7 +844,7 @@ namespace graphlab {
      * once and therefore must be guarded by a vertex locks in
      * \ref graphlab::powerlyra_sync_engine::vlocks
      */
-    std::vector<gather_type>  gather_accum;
+    automi_slab_vector<gather_type, is_multi_vertex_program<VertexProgram>::value> gather_accum;
 
     /**
      * \brief Bit indicating if the gather has accumulator contains any
@@ -517,7 +856,7 @@ namespace graphlab {
      * set while holding the lock in
      * \ref graphlab::powerlyra_sync_engine::vlocks.
      */
-    dense_bitset has_gather_accum;
+    automi_frontier has_gather_accum;
 
 
     /**
@@ -539,7 +878,7 @@ namespace graphlab {
      * \brief A bit (for master vertices) indicating if that vertex is active
      * (received a message on this iteration).
      */
-    dense_bitset active_superstep;
+    automi_frontier active_superstep;
 
     /**
      * \brief  The number of local vertices (masters) that are active on this
@@ -578,10 +917,11 @@ namespace graphlab {
      * \brief A bit indicating (for all vertices) whether to
      * participate in the current minor-step (gather or scatter).
      */
-    dense_bitset active_minorstep;
+    automi_frontier active_minorstep;
 
     /**
-     * \brief Indicating all vertices to have their values reset.
+     * \brief Indicating all vertices to have their values reset.  All
+     * the bits are always set.
      */
     dense_bitset reset_all;
 
@@ -681,6 +1021,65 @@ namespace graphlab {
     update_exchange_type update_exchange;
 
 
+    /**
+     * \brief The lane delta of a vertex data or a message: the mask of
+     * the lanes changed by apply (or carrying a value), whose masked
+     * serialization is written straight into the exchange buffers.
+     */
+    typedef automi_lane_delta lane_delta_type;
+
+    /**
+     * \brief The triple type used to update the changed lanes of
+     * vertex data and activate neighbors.
+     */
+    typedef triple<vertex_id_type, lane_delta_type, vertex_program_type>
+      vid_delta_vprog_triple_type;
+
+    /**
+     * \brief The type of the exchange used to update the changed lanes
+     * of mirrors and activate them
+     */
+    typedef fiber_buffered_exchange<vid_delta_vprog_triple_type>
+      delta_activ_exchange_type;
+
+    /**
+     * \brief The type of buffer used by the exchange to update the
+     * changed lanes of mirrors and activate them
+     */
+    typedef typename delta_activ_exchange_type::buffer_type
+      delta_activ_buffer_type;
+
+    /**
+     * \brief The distributed express used to update the changed lanes
+     * of mirrors and activate them.
+     */
+    delta_activ_exchange_type delta_activ_exchange;
+
+    /**
+     * \brief The pair type used to only update the changed lanes of
+     * vertex data.
+     */
+    typedef std::pair<vertex_id_type, lane_delta_type> vid_delta_pair_type;
+
+    /**
+     * \brief The type of the exchange used to update the changed lanes
+     * of mirrors
+     */
+    typedef fiber_buffered_exchange<vid_delta_pair_type> delta_exchange_type;
+
+    /**
+     * \brief The type of buffer used by the exchange to update the
+     * changed lanes of mirrors
+     */
+    typedef typename delta_exchange_type::buffer_type delta_buffer_type;
+
+    /**
+     * \brief The distributed express used to update the changed lanes
+     * of mirrors.
+     */
+    delta_exchange_type delta_exchange;
+
+
     /**
      * \brief The pair type used to synchronize the results of the gather phase
      */
@@ -713,6 +1112,12 @@ namespace graphlab {
      */
     message_exchange_type message_exchange;
 
+    /**
+     * \brief The distributed exchange used to synchronize the lanes of
+     * messages which carry a value
+     */
+    delta_exchange_type message_delta_exchange;
+
 
     /**
      * \brief The distributed aggregator used to manage background
@@ -778,6 +1183,18 @@ namespace graphlab {
 
     void signal_source(vertex_id_type vertex_id,
                        const message_type& message = message_type());
+
+    /**
+     * \brief Signal a batch of source vertices and run their
+     * source_init and scatter.
+     *
+     * All the sources are seeded before the source phases run, so a
+     * batch of queries pays two barriers and three phases in total
+     * instead of per source.  Messages to the same source are
+     * combined.  Must be called on all machines with the same sources.
+     */
+    void signal_sources(
+        const std::vector<std::pair<vertex_id_type, message_type> >& sources);
     // end of modifications
 
     // documentation inherited from iengine
@@ -833,7 +1250,7 @@ namespace graphlab {
     void init();
 
 
-  private:
+  protected:
 
 
     /**
@@ -929,14 +1346,242 @@ namespace graphlab {
      * void powerlyra_sync_engine::member_fun(size_t threadid);
      * \endcode
      *
+     * and may also be a member of a derived engine.
+     *
      * This function runs an rmi barrier after termination
      *
-     * @tparam the type of the member function.
+     * @tparam Engine the class of the member function.
      * @param [in] member_fun the function to call.
      */
-    template<typename MemberFunction>
-    void run_synchronous(MemberFunction member_fun) {
+    template<typename Engine>
+    void run_synchronous(void (Engine::*member_fun)(size_t)) {
+      run_workers(boost::bind(member_fun, static_cast<Engine*>(this), _1));
+      rmi.barrier();
+    } // end of run_synchronous
+
+    /**
+     * \brief Runs a phase of the superstep of start() like
+     * run_synchronous, and accounts for its overhead.
+     */
+    template<typename Engine>
+    void run_phase(void (Engine::*member_fun)(size_t), superstep_phase phase) {
+#ifdef TUNING
+      graphlab::timer ti;
+      run_workers(boost::bind(&powerlyra_sync_engine::template timed_phase<Engine>,
+                              this, member_fun, _1));
+      rmi.barrier();
+      add_phase_overhead(phase, ti.current_time());
+#else
+      run_synchronous(member_fun);
+#endif
+    } // end of run_phase
+
+    /**
+     * \brief Calls the phase function of a thread and records its
+     * time.
+     */
+    template<typename Engine>
+    void timed_phase(void (Engine::*member_fun)(size_t), size_t thread_id) {
+      graphlab::timer ti;
+      (static_cast<Engine*>(this)->*member_fun)(thread_id);
+      per_thread_phase_time[thread_id] = ti.current_time();
+    }
+
+    /**
+     * \brief Adds the time of a phase not spent by its slowest thread
+     * to its overhead.
+     *
+     * @param [in] elapsed the wall time of the phase.
+     */
+    void add_phase_overhead(superstep_phase phase, double elapsed) {
+      double busy = 0;
+      for (size_t i = 0; i < per_thread_phase_time.size(); ++i) {
+        busy = std::max(busy, per_thread_phase_time[i]);
+      }
+      phase_overhead[phase] += std::max(0.0, elapsed - busy);
+    }
+
+    /**
+     * \brief Fixes the words of the frontiers scanned by the next
+     * phase.  Called by one thread between the phases.
+     */
+    void prepare_frontiers() {
+      has_message.prepare_scan();
+      active_superstep.prepare_scan();
+      active_minorstep.prepare_scan();
+      if (work_stealing) prepare_minorstep_work();
+    }
+
+    /**
+     * \brief Splits the scan of active_minorstep among the threads by
+     * the number of edges of its words.
+     */
+    void prepare_minorstep_work() {
+      const size_t n = active_minorstep.scan_size();
+      const size_t* prefix = &word_edges[0];
+      // a dense scan visits all the words
+      if (!active_minorstep.scan_is_dense()) {
+        scan_edges.resize(n + 1);
+        scan_edges[0] = 0;
+        for (size_t i = 0; i < n; ++i) {
+          const size_t w = active_minorstep.scan_word_index(i);
+          scan_edges[i + 1] = scan_edges[i] + word_edges[w + 1] - word_edges[w];
+        }
+        prefix = &scan_edges[0];
+      }
+      minorstep_work.reset(ncpus, prefix, n);
+    }
+
+    /**
+     * \brief Claims the next word of active_minorstep holding a bit for
+     * the gather and scatter phases.  'next' and 'end' are the chunk of
+     * the thread, both 0 when the phase starts.
+     */
+    inline bool next_minorstep_word(size_t thread_id, size_t& next, size_t& end,
+                                    size_t& block_start, size_t& word) {
+      if (!work_stealing) {
+        return active_minorstep.next_word(shared_lvid_counter, block_start, word);
+      }
+      while (true) {
+        if (next == end && !minorstep_work.next(thread_id, next, end)) return false;
+        if (active_minorstep.scan_word(next++, block_start, word)) return true;
+      }
+    }
+
+    /// Returns true if the gather and scatter of the vertex are split
+    inline bool is_split_hub(lvid_type lvid) {
+      if (hub_split == 0 || ncpus <= 1) return false;
+      const local_vertex_type local_vertex = graph.l_vertex(lvid);
+      return local_vertex.num_in_edges() + local_vertex.num_out_edges() > hub_split;
+    }
+
+    /**
+     * \brief Gathers the hubs met by all the threads, each thread on a
+     * slice of their edges, and sends their accumulators.  Called by all
+     * threads at the end of the gather phase.
+     *
+     * @return the number of hubs gathered by this thread.
+     */
+    size_t gather_hubs(context_type& context, size_t thread_id);
+
+    /**
+     * \brief Scatters the hubs met by all the threads, each thread on a
+     * slice of their edges.  Called by all threads at the end of the
+     * scatter phase.
+     *
+     * @return the number of hubs scattered by this thread.
+     */
+    size_t scatter_hubs(context_type& context, size_t thread_id);
+
+    /// Merges the hubs of the threads into split_hubs; called by thread 0
+    void collect_hubs();
+
+    /// Returns the number of edges of a vertex in direction 'dir'
+    inline size_t vertex_edges(const vertex_type& vertex, edge_dir_type dir) const {
+      size_t nedges = 0;
+      if (dir == IN_EDGES || dir == ALL_EDGES) nedges += vertex.num_in_edges();
+      if (dir == OUT_EDGES || dir == ALL_EDGES) nedges += vertex.num_out_edges();
+      return nedges;
+    }
+
+    /// Gathers the first edge of a local gather, pulling in a pull superstep
+    inline gather_type gather_edge(const vertex_program_type& vprog,
+                                   context_type& context,
+                                   const vertex_type& vertex, edge_type& edge) {
+      if (pulling) return gather_pull(vprog, context, vertex, edge);
+      return vprog.gather(context, vertex, edge);
+    }
+
+    /// Adds the gather of a following edge to the local accumulator
+    inline void accumulate_edge(const vertex_program_type& vprog,
+                                context_type& context, const vertex_type& vertex,
+                                edge_type& edge, gather_type& accum) {
+      if (pulling) accum += gather_pull(vprog, context, vertex, edge);
+      else gather_accumulate(vprog, context, vertex, edge, accum);
+    }
+
+    /**
+     * \brief Schedules the gather of an active master, and activates
+     * its mirrors which have gather edges.
+     */
+    void schedule_gather(context_type& context, const vertex_type& vertex,
+                         lvid_type lvid, size_t thread_id);
+
+    /**
+     * \brief Sums the gather edges of the pull candidates of the
+     * cluster into unexplored_edges, and marks the other masters
+     * settled.
+     */
+    void count_unexplored_edges();
+
+    /**
+     * \brief Reduces the frontier of the last apply over the cluster
+     * and sets pull_next.  Called by one thread between the apply and
+     * scatter phases.
+     */
+    void choose_direction(bool print_this_round);
+
+    /**
+     * \brief Counts the replicas of each master which have local edges
+     * in each direction, with the <b>pipeline</b> option.  Called by
+     * resize() on all machines.
+     */
+    void count_contributors();
+
+    /// Counts a replica of master 'lvid' with local edges in 'dirs' (1 in, 2 out)
+    void add_contributor(lvid_type lvid, unsigned char dirs) {
+      gather_contributors& c = contributors[lvid];
+      if (dirs & 1) ++c.in_edges;
+      if (dirs & 2) ++c.out_edges;
+      if (dirs != 0) ++c.all_edges;
+    }
+
+    /**
+     * \brief Returns the number of accumulators an active master
+     * receives for its gather along 'gather_dir': one from each
+     * replica which gathers and has local edges in that direction.
+     *
+     * @param [in] mirrors_gather set if its mirrors were activated
+     */
+    size_t expected_accums(lvid_type lvid, edge_dir_type gather_dir,
+                           bool mirrors_gather) {
+      const gather_contributors& c = contributors[lvid];
+      const local_vertex_type local_vertex = graph.l_vertex(lvid);
+      switch (gather_dir) {
+      case IN_EDGES:
+        return mirrors_gather ? c.in_edges : local_vertex.num_in_edges() > 0;
+      case OUT_EDGES:
+        return mirrors_gather ? c.out_edges : local_vertex.num_out_edges() > 0;
+      case ALL_EDGES:
+        return mirrors_gather ? c.all_edges
+          : local_vertex.num_in_edges() + local_vertex.num_out_edges() > 0;
+      default:
+        return 0;
+      }
+    }
+
+    /**
+     * \brief Adds the time each thread waited for the slowest one of the
+     * last phase to its idle time; called by thread 0.
+     */
+    void add_idle_time() {
+      double busy = 0;
+      for (size_t i = 0; i < per_thread_busy_time.size(); ++i) {
+        busy = std::max(busy, per_thread_busy_time[i]);
+      }
+      for (size_t i = 0; i < per_thread_busy_time.size(); ++i) {
+        per_thread_idle_time[i] += busy - per_thread_busy_time[i];
+      }
+    }
+
+    /**
+     * \brief Launches ncpus threads calling the worker with their
+     * thread id, and waits for them to finish.
+     */
+    void run_workers(const boost::function<void(size_t)>& worker) {
       shared_lvid_counter = 0;
+      prepare_frontiers();
+      ++num_launches;
       if (ncpus <= 1) {
         INCREMENT_EVENT(EVENT_ACTIVE_CPUS, 1);
       }
@@ -944,7 +1589,7 @@ namespace graphlab {
       for(size_t i = 0; i < ncpus; ++i) {
         fiber_control::affinity_type affinity;
         affinity.clear(); affinity.set_bit(i);
-        boost::function<void(void)> invoke = boost::bind(member_fun, this, i);
+        boost::function<void(void)> invoke = boost::bind(worker, i);
         threads.launch(boost::bind(
               &powerlyra_sync_engine::thread_launch_wrapped_event_counter,
               this,
@@ -952,11 +1597,51 @@ namespace graphlab {
       }
       // Wait for all threads to finish
       threads.join();
-      rmi.barrier();
       if (ncpus <= 1) {
         DECREMENT_EVENT(EVENT_ACTIVE_CPUS, 1);
       }
-    } // end of run_synchronous
+    } // end of run_workers
+
+    /**
+     * \brief Runs all the phases of a superstep in one launch of the
+     * worker threads, with the <b>persistent_workers</b> option.
+     *
+     * @return false if has_active_vertices() is false, in which case
+     * only the messages were exchanged and received.
+     */
+    bool run_superstep(bool print_this_round) {
+      superstep_active = false;
+      run_workers(boost::bind(&powerlyra_sync_engine::execute_superstep,
+                              this, _1, print_this_round));
+      return superstep_active;
+    }
+
+    /**
+     * \brief The worker of a persistent superstep.  The phases are
+     * separated by barriers of the local threads only: each phase
+     * which exchanges data ends with the flush of its exchange, a full
+     * barrier of the cluster, after which all the data it sent has been
+     * delivered.  The remote signals of the scatter phase are delivered
+     * by the barrier at the start of the next superstep.
+     */
+    void execute_superstep(size_t thread_id, bool print_this_round);
+
+    /**
+     * \brief Runs a phase of a persistent superstep on all threads,
+     * which start it together on a fresh lvid counter and wait for each
+     * other at its end.
+     */
+    void run_fused_phase(size_t thread_id,
+                         void (powerlyra_sync_engine::*member_fun)(size_t),
+                         superstep_phase phase);
+
+    /**
+     * \brief Reduces the number of active vertices over the cluster.
+     *
+     * @return false if no vertex is active and has_pending_work() is
+     * false.
+     */
+    bool has_active_vertices(bool print_this_round);
 
     inline bool high_lvid(const lvid_type lvid);  
     inline bool low_lvid(const lvid_type lvid);
@@ -986,7 +1671,7 @@ namespace graphlab {
      * @param thread_id the thread to run this as which determines
      * which vertices to process.
      */
-    void receive_messages(size_t thread_id);
+    virtual void receive_messages(size_t thread_id);
 
 
     /**
@@ -1009,7 +1694,32 @@ namespace graphlab {
      * @param thread_id the thread to run this as which determines
      * which vertices to process.
      */
-    void execute_applys(size_t thread_id);
+    virtual void execute_applys(size_t thread_id);
+
+    /**
+     * \brief Applies an active master, sends its data to its mirrors
+     * and schedules its scatter.
+     *
+     * @param [in,out] stats the frontier of the thread, updated unless
+     *        <b>direction</b> is push.
+     */
+    void apply_vertex(context_type& context, lvid_type lvid,
+                      size_t thread_id, direction_stats& stats);
+
+    /**
+     * \brief The end of the apply phase on each thread: records its
+     * applies and frontier, and exchanges the updates of the mirrors.
+     */
+    void finish_applys(size_t thread_id, size_t napply_inc,
+                       const direction_stats& stats);
+
+    /**
+     * \brief The apply phase with the <b>pipeline</b> option, run at
+     * the end of the gather phase once the local gathers are done.
+     * The threads apply the masters whose accumulators have all
+     * arrived, and receive the others while none is ready.
+     */
+    void apply_pipelined(context_type& context, size_t thread_id);
 
     /**
      * \brief Execute the \ref graphlab::ivertex_program::scatter function on all
@@ -1034,10 +1744,25 @@ namespace graphlab {
 
     void execute_source_flush(size_t thread_id);
 
-    void execute_source_init(size_t thread_id);
+    virtual void execute_source_init(size_t thread_id);
 
     void execute_source_scatter(size_t thread_id);
 
+    /**
+     * \brief Called on every machine between two supersteps, after
+     * the scatter phase.  Derived engines may run additional phases
+     * here; the default does nothing.
+     */
+    virtual void end_superstep() { }
+
+    /**
+     * \brief Called on every machine when no vertex of the cluster is
+     * active.  Derived engines return true if they still have work for
+     * the next supersteps, in which case the superstep runs to its end
+     * rather than terminating.  Must return the same on all machines.
+     */
+    virtual bool has_pending_work() { return false; }
+
     // Data Synchronization ===================================================
     /**
      * \brief Send the activation messages (vertex program and edge set) 
@@ -1091,13 +1816,70 @@ namespace graphlab {
     void recv_updates();
 
     /**
-     * \brief Send the gather accum for the vertex id to its master.
+     * \brief Computes the lane delta of the local vertex data from the
+     * changed lanes of its vertex program.
      *
-     * @param [in] lvid the vertex to send the gather value to
-     * @param [in] accum the locally computed gather value.
+     * Returns false if the vertex program does not track lanes, in
+     * which case the whole vertex data has to be synchronized.  The
+     * delta points to the vertex data, whose lanes are serialized when
+     * the delta is sent.
      */
-    void send_accum(lvid_type lvid, const gather_type& accum,
-                        const size_t thread_id);
+    bool make_lane_delta(lvid_type lvid, lane_delta_type& delta,
+                         boost::true_type);
+    bool make_lane_delta(lvid_type lvid, lane_delta_type& delta,
+                         boost::false_type) { return false; }
+
+    /**
+     * \brief Applies a lane delta received from the master to the
+     * local vertex data.
+     */
+    void apply_lane_delta(lvid_type lvid, const lane_delta_type& delta,
+                          boost::true_type);
+    void apply_lane_delta(lvid_type lvid, const lane_delta_type& delta,
+                          boost::false_type) { }
+
+    /**
+     * \brief Computes the lane delta of the local message from the
+     * lanes carrying a value.
+     *
+     * Returns false if the vertex program does not track lanes, in
+     * which case the whole message has to be sent.  The delta points
+     * to the message, whose lanes are serialized when it is sent.
+     */
+    bool make_message_delta(lvid_type lvid, lane_delta_type& delta,
+                            boost::true_type);
+    bool make_message_delta(lvid_type lvid, lane_delta_type& delta,
+                            boost::false_type) { return false; }
+
+    /**
+     * \brief Loads a lane delta received from a mirror into a default
+     * constructed message.
+     */
+    void load_message_delta(message_type& msg, const lane_delta_type& delta,
+                            boost::true_type);
+    void load_message_delta(message_type& msg, const lane_delta_type& delta,
+                            boost::false_type) { }
+
+    /**
+     * \brief Partially flushes all the exchanges used to update
+     * mirrors.
+     */
+    void partial_flush_updates();
+
+    /**
+     * \brief Flushes all the exchanges used to update mirrors.
+     */
+    void flush_updates();
+
+    /**
+     * \brief Send the gather accum for the vertex id to its master.
+     *
+     * @param [in] lvid the vertex to send the gather value to
+     * @param [in] accum the locally computed gather value, which is
+     *        moved from if the vertex is a master.
+     */
+    void send_accum(lvid_type lvid, gather_type& accum,
+                        const size_t thread_id);
 
 
     /**
@@ -1109,6 +1891,27 @@ namespace graphlab {
      */
     void recv_accums();
 
+    /**
+     * \brief Adds an accumulator to the one of the master vertex, and
+     * with <b>pipeline</b> queues the master once it has all its
+     * accumulators.
+     *
+     * @param [in] lvid the master
+     * @param [in] accum the accumulator, which may be moved from
+     */
+    void merge_accum(lvid_type lvid, gather_type& accum);
+
+    /// Queues a master whose accumulators have all arrived
+    void push_ready(lvid_type lvid);
+
+    /**
+     * \brief Takes up to max_batch queued masters into batch.
+     *
+     * @return the number of masters queued in the superstep so far,
+     * taken or not.
+     */
+    size_t pop_ready(std::vector<lvid_type>& batch, size_t max_batch);
+
     /**
      * \brief Send the scatter messages for the vertex id to its master.
      *
@@ -1181,18 +1984,32 @@ namespace graphlab {
     threads(2*1024*1024 /* 2MB stack per fiber*/),
     thread_barrier(opts.get_ncpus()),
     max_iterations(-1), snapshot_interval(-1), iteration_counter(0),
-    print_interval(5), timeout(0), sched_allv(false),
+    print_interval(5), timeout(0), sched_allv(false), delta_sync(false),
+    masked_messages(false), lane_compaction(false), stream_queries(false),
+    persistent_workers(false), superstep_active(false),
+    work_stealing(false), hub_split(0),
+    direction(DIRECTION_PUSH), direction_alpha(14), direction_beta(24),
+    pulling(false), pull_next(false), unexplored_edges(0),
+    last_frontier_vertices(0), num_pull_supersteps(0),
+    pipeline(false), num_ready_masters(0),
     activ_exchange(dc),
     update_activ_exchange(dc),
     update_exchange(dc),
+    delta_activ_exchange(dc),
+    delta_exchange(dc),
     accum_exchange(dc),
     message_exchange(dc),
+    message_delta_exchange(dc),
     aggregator(dc, graph, new context_type(*this, graph)) {
     post_round_flag = false;
     // end of modifications
     // Process any additional options
     std::vector<std::string> keys = opts.get_engine_args().get_option_keys();
     per_thread_compute_time.resize(opts.get_ncpus());
+    per_thread_phase_time.resize(opts.get_ncpus());
+    per_thread_idle_time.resize(opts.get_ncpus());
+    per_thread_busy_time.resize(opts.get_ncpus());
+    thread_hubs.resize(opts.get_ncpus());
     use_cache = false;
     foreach(std::string opt, keys) {
       if (opt == "max_iterations") {
@@ -1225,6 +2042,67 @@ namespace graphlab {
         if (rmi.procid() == 0)
           logstream(LOG_EMPH) << "Engine Option: sched_allv = "
             << sched_allv << std::endl;
+      } else if (opt == "delta_sync") {
+        opts.get_engine_args().get_option("delta_sync", delta_sync);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: delta_sync = "
+            << delta_sync << std::endl;
+      } else if (opt == "masked_messages") {
+        opts.get_engine_args().get_option("masked_messages", masked_messages);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: masked_messages = "
+            << masked_messages << std::endl;
+      } else if (opt == "lane_compaction") {
+        opts.get_engine_args().get_option("lane_compaction", lane_compaction);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: lane_compaction = "
+            << lane_compaction << std::endl;
+      } else if (opt == "stream_queries") {
+        opts.get_engine_args().get_option("stream_queries", stream_queries);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: stream_queries = "
+            << stream_queries << std::endl;
+      } else if (opt == "persistent_workers") {
+        opts.get_engine_args().get_option("persistent_workers", persistent_workers);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: persistent_workers = "
+            << persistent_workers << std::endl;
+      } else if (opt == "work_stealing") {
+        opts.get_engine_args().get_option("work_stealing", work_stealing);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: work_stealing = "
+            << work_stealing << std::endl;
+      } else if (opt == "hub_split") {
+        opts.get_engine_args().get_option("hub_split", hub_split);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: hub_split = "
+            << hub_split << std::endl;
+      } else if (opt == "direction") {
+        std::string direction_name;
+        opts.get_engine_args().get_option("direction", direction_name);
+        if (direction_name == "push") direction = DIRECTION_PUSH;
+        else if (direction_name == "pull") direction = DIRECTION_PULL;
+        else if (direction_name == "auto") direction = DIRECTION_AUTO;
+        else logstream(LOG_FATAL) << "Unknown direction: " << direction_name
+                                  << " (push, pull or auto)" << std::endl;
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: direction = "
+            << direction_name << std::endl;
+      } else if (opt == "direction_alpha") {
+        opts.get_engine_args().get_option("direction_alpha", direction_alpha);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: direction_alpha = "
+            << direction_alpha << std::endl;
+      } else if (opt == "direction_beta") {
+        opts.get_engine_args().get_option("direction_beta", direction_beta);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: direction_beta = "
+            << direction_beta << std::endl;
+      } else if (opt == "pipeline") {
+        opts.get_engine_args().get_option("pipeline", pipeline);
+        if (rmi.procid() == 0)
+          logstream(LOG_EMPH) << "Engine Option: pipeline = "
+            << pipeline << std::endl;
       } else if (opt == "post_round") {
         opts.get_engine_args().get_option("post_round", post_round_flag);
         if (rmi.procid() == 0)
@@ -1239,6 +2117,35 @@ namespace graphlab {
       logstream(LOG_FATAL)
         << "Snapshot interval specified, but no snapshot path" << std::endl;
     }
+    if (delta_sync && !is_multi_vertex_program<VertexProgram>::value) {
+      logstream(LOG_FATAL)
+        << "delta_sync requires a multi-instance vertex program" << std::endl;
+    }
+    if (masked_messages && !is_multi_vertex_program<VertexProgram>::value) {
+      logstream(LOG_FATAL)
+        << "masked_messages requires a multi-instance vertex program" << std::endl;
+    }
+    if (lane_compaction && !is_multi_vertex_program<VertexProgram>::value) {
+      logstream(LOG_FATAL)
+        << "lane_compaction requires a multi-instance vertex program" << std::endl;
+    }
+    if (stream_queries && !is_multi_vertex_program<VertexProgram>::value) {
+      logstream(LOG_FATAL)
+        << "stream_queries requires a multi-instance vertex program" << std::endl;
+    }
+    if (direction != DIRECTION_PUSH && !has_pull_gather<VertexProgram>::value) {
+      logstream(LOG_FATAL)
+        << "direction requires a vertex program with pull_gather and "
+        << "pull_candidate" << std::endl;
+    }
+    if (direction != DIRECTION_PUSH && use_cache) {
+      logstream(LOG_FATAL)
+        << "direction cannot be used with use_cache" << std::endl;
+    }
+    if (pipeline && (use_cache || sched_allv)) {
+      logstream(LOG_FATAL)
+        << "pipeline cannot be used with use_cache or sched_allv" << std::endl;
+    }
     INITIALIZE_EVENT_LOG(dc);
     ADD_CUMULATIVE_EVENT(EVENT_APPLIES, "Applies", "Calls");
     ADD_CUMULATIVE_EVENT(EVENT_GATHERS , "Gathers", "Calls");
@@ -1285,11 +2192,11 @@ namespace graphlab {
     vertex_programs.resize(l_nverts);
     
     // Allocate messages and message bitset
-    messages.resize(l_nverts, message_type());
+    messages.resize(l_nverts);
     has_message.resize(l_nverts);
     
     // Allocate gather accumulators and accumulator bitset
-    gather_accum.resize(l_nverts, gather_type());
+    gather_accum.resize(l_nverts);
     has_gather_accum.resize(l_nverts);
 
     // If caching is used then allocate cache data-structures
@@ -1302,6 +2209,19 @@ namespace graphlab {
     active_minorstep.resize(l_nverts);
 
     reset_all.resize(l_nverts);
+    reset_all.fill();
+    pull_settled.resize(l_nverts);
+    if (pipeline) count_contributors();
+
+    // Weigh the words of the bitsets by their local edges
+    const size_t nwords = (l_nverts + 8 * sizeof(size_t) - 1) / (8 * sizeof(size_t));
+    word_edges.assign(nwords + 1, 0);
+    for (lvid_type lvid = 0; lvid < l_nverts; ++lvid) {
+      const local_vertex_type local_vertex = graph.l_vertex(lvid);
+      word_edges[lvid / (8 * sizeof(size_t)) + 1] +=
+        1 + local_vertex.num_in_edges() + local_vertex.num_out_edges();
+    }
+    for (size_t i = 0; i < nwords; ++i) word_edges[i + 1] += word_edges[i];
   }
 
 
@@ -1373,7 +2293,7 @@ namespace graphlab {
     if( has_message.get(lvid) ) {
       messages[lvid] += message;
     } else {
-      messages[lvid] = message;
+      messages.assign(lvid, message);
       has_message.set_bit(lvid);
     }
     vlocks[lvid].unlock();
@@ -1384,7 +2304,7 @@ namespace graphlab {
   internal_signal(const vertex_type& vertex) {
     const lvid_type lvid = vertex.local_id();
     // set an empty message
-    messages[lvid] = message_type();
+    messages.reset(lvid);
     // atomic set is enough, without acquiring and releasing lock
     has_message.set_bit(lvid);
   } // end of internal_signal
@@ -1484,19 +2404,27 @@ namespace graphlab {
   }
 
   template<typename VertexProgram> void powerlyra_sync_engine<VertexProgram>::signal_source(vertex_id_type vertex_id, const message_type& message) {
+    signal_sources(std::vector<std::pair<vertex_id_type, message_type> >(
+                     1, std::make_pair(vertex_id, message)));
+  }
+
+  template<typename VertexProgram> void powerlyra_sync_engine<VertexProgram>::
+  signal_sources(const std::vector<std::pair<vertex_id_type, message_type> >& sources) {
     if (vlocks.size() != graph.num_local_vertices())
       resize();
     rmi.barrier();
 
-    if (graph.is_master(vertex_id)) {
+    for (size_t i = 0; i < sources.size(); ++i) {
+      const vertex_id_type vertex_id = sources[i].first;
+      if (!graph.is_master(vertex_id)) continue;
       const vertex_type vertex  = graph.vertex(vertex_id);
       const lvid_type lvid = vertex.local_id();
       vlocks[lvid].lock();
       active_superstep.set_bit(lvid);
       if( has_message.get(lvid) ) {
-        messages[lvid] += message;
+        messages[lvid] += sources[i].second;
       } else {
-        messages[lvid] = message;
+        messages.assign(lvid, sources[i].second);
         has_message.set_bit(lvid);
       }
       vlocks[lvid].unlock();
@@ -1540,8 +2468,16 @@ namespace graphlab {
     exec_time = exch_time = recv_time =
       gather_time = apply_time = scatter_time = 0.0;
     postround_time = 0.0;
+    accum_wait_time = accum_hidden_time = 0.0;
+    std::fill(phase_overhead, phase_overhead + NUM_PHASES, 0.0);
     graphlab::timer ti, bk_ti;
 #endif
+    num_launches = 0;
+    num_pull_supersteps = 0;
+    pulling = pull_next = false;
+    last_frontier_vertices = 0;
+    frontier_vertices = frontier_edges = settled_edges = 0;
+    if (direction == DIRECTION_AUTO) count_unexplored_edges();
     iteration_counter = 0;
     force_abort = false;
     execution_status::status_enum termination_reason = execution_status::UNSET;
@@ -1591,156 +2527,166 @@ namespace graphlab {
       // be set upon receiving messages
       active_superstep.clear(); active_minorstep.clear();
       has_gather_accum.clear();
-      reset_all.fill(); // see if this is necessary
       num_active_vertices = 0;
+      // the direction chosen after the last apply
+      pulling = pull_next;
+      pull_next = false;
+      if (pulling) ++num_pull_supersteps;
+      ready_masters.clear();
+      num_ready_masters = 0;
 // #ifdef COMM_STATS
 //       num_send_messages = num_send_accums = num_send_updates = 
 //         num_send_updates_activs = num_send_activs = 0
 // #endif  // COMM_STATS
       rmi.barrier();
       
-      // Exchange Messages --------------------------------------------------
-      // High: send messages from mirrors to master
-      // Low: none (if only IN_EDGES)
-      //
-      // if (rmi.procid() == 0) std::cout << "Exchange messages..." << std::endl;
+      if (persistent_workers) {
+        // All the phases below in one launch of the worker threads
+        if (!run_superstep(print_this_round)) {
+          termination_reason = execution_status::TASK_DEPLETION;
+          break;
+        }
+      } else {
+        // Exchange Messages --------------------------------------------------
+        // High: send messages from mirrors to master
+        // Low: none (if only IN_EDGES)
+        //
+        // if (rmi.procid() == 0) std::cout << "Exchange messages..." << std::endl;
 #ifdef TUNING
-      bk_ti.start();
+        bk_ti.start();
 #endif
-      run_synchronous( &powerlyra_sync_engine::exchange_messages );
+        run_phase( &powerlyra_sync_engine::exchange_messages, PHASE_EXCHANGE );
 #ifdef TUNING
-      exch_time += bk_ti.current_time();
+        exch_time += bk_ti.current_time();
 #endif
-      /**
-       * Post conditions:
-       *   1) master (high and low) vertices have messages
-       */
+        /**
+         * Post conditions:
+         *   1) master (high and low) vertices have messages
+         */
 
-      // Receive Messages ---------------------------------------------------
-      // 1. calculate the number of active vertices
-      // 2. call init and gather_edges
-      // 3. set active_superstep, active_minorstep and edge_dirs
-      // 4. clear has_message
-      //
-      // High: send vprog and edge_dirs from master to mirrors
-      // Low: none (if only IN_EDGES)
-      //
-      // if (rmi.procid() == 0) std::cout << "Receive messages..." << std::endl;
+        // Receive Messages ---------------------------------------------------
+        // 1. calculate the number of active vertices
+        // 2. call init and gather_edges
+        // 3. set active_superstep, active_minorstep and edge_dirs
+        // 4. clear has_message
+        //
+        // High: send vprog and edge_dirs from master to mirrors
+        // Low: none (if only IN_EDGES)
+        //
+        // if (rmi.procid() == 0) std::cout << "Receive messages..." << std::endl;
 #ifdef TUNING
-      bk_ti.start();
+        bk_ti.start();
 #endif
-      run_synchronous( &powerlyra_sync_engine::receive_messages );
-      if (sched_allv) active_minorstep.fill();
-      has_message.clear();
+        run_phase( &powerlyra_sync_engine::receive_messages, PHASE_RECEIVE );
+        if (sched_allv) active_minorstep.fill();
+        has_message.clear();
 #ifdef TUNING
-      recv_time += bk_ti.current_time();
+        recv_time += bk_ti.current_time();
 #endif
-      /**
-       * Post conditions:
-       *   1) there are no messages remaining
-       *   2) All masters that received messages have their
-       *      active_superstep bit set
-       *   3) All masters and mirrors that are to participate in the
-       *      next gather phases have their active_minorstep bit
-       *      set.
-       *   4) num_active_vertices is the number of vertices that
-       *      received messages.
-       */
+        /**
+         * Post conditions:
+         *   1) there are no messages remaining
+         *   2) All masters that received messages have their
+         *      active_superstep bit set
+         *   3) All masters and mirrors that are to participate in the
+         *      next gather phases have their active_minorstep bit
+         *      set.
+         *   4) num_active_vertices is the number of vertices that
+         *      received messages.
+         */
 
-      // Check termination condition  ---------------------------------------
-      size_t total_active_vertices = num_active_vertices;
-      rmi.all_reduce(total_active_vertices);
-#ifdef ENGINE_DEBUG_PRINT
-      if (rmi.procid() == 0) {
-        logstream(LOG_EMPH) << "\tActive vertices: " << total_active_vertices << std::endl;
-      }
-#else
-      if (rmi.procid() == 0 && print_this_round) {
-        logstream(LOG_EMPH)
-          << "\tActive vertices: " << total_active_vertices << std::endl;
-      }
-#endif  // ENGINE_DEBUG_PRINT     
-      if(total_active_vertices == 0 ) {
-        termination_reason = execution_status::TASK_DEPLETION;
-        break;
-      }
+        // Check termination condition  ---------------------------------------
+        if (!has_active_vertices(print_this_round)) {
+          termination_reason = execution_status::TASK_DEPLETION;
+          break;
+        }
 
 
-      // Execute gather operations-------------------------------------------
-      // 1. call pre_local_gather, gather and post_local_gather
-      // 2. (master) set gather_accum and has_gather_accum
-      // 3. clear active_minorstep
-      //
-      // High: send gather_accum from mirrors to master
-      // Low: none (if only IN_EDGES)
-      //
-      // if (rmi.procid() == 0) std::cout << "Gathering..." << std::endl;
+        // Execute gather operations-------------------------------------------
+        // 1. call pre_local_gather, gather and post_local_gather
+        // 2. (master) set gather_accum and has_gather_accum
+        // 3. clear active_minorstep
+        //
+        // High: send gather_accum from mirrors to master
+        // Low: none (if only IN_EDGES)
+        //
+        // if (rmi.procid() == 0) std::cout << "Gathering..." << std::endl;
 #ifdef TUNING
-      bk_ti.start();
+        bk_ti.start();
 #endif
-      run_synchronous( &powerlyra_sync_engine::execute_gathers );
-      // Clear the minor step bit since only super-step vertices
-      // (only master vertices are required to participate in the
-      // apply step)
-      active_minorstep.clear();
+        run_phase( &powerlyra_sync_engine::execute_gathers, PHASE_GATHER );
+        // Clear the minor step bit since only super-step vertices
+        // (only master vertices are required to participate in the
+        // apply step); with pipeline the gather phase has already
+        // cleared it and run the applies
+        if (!pipeline) active_minorstep.clear();
 #ifdef TUNING
-      gather_time += bk_ti.current_time();
+        gather_time += bk_ti.current_time();
 #endif
-      /**
-       * Post conditions:
-       *   1) gather_accum for all master vertices contains the
-       *      result of all the gathers (even if they are drawn from
-       *      cache)
-       *   2) No minor-step bits are set
-       */
+        /**
+         * Post conditions:
+         *   1) gather_accum for all master vertices contains the
+         *      result of all the gathers (even if they are drawn from
+         *      cache)
+         *   2) No minor-step bits are set
+         */
 
-      // Execute Apply Operations -------------------------------------------
-      // 1. call apply and scatter_edges
-      // 2. set edge_dirs and active_minorstep
-      // 3. send vdata, vprog and edge_dirs from master to replicas
-      //
-      // if (rmi.procid() == 0) std::cout << "Applying..." << std::endl;
+        // Execute Apply Operations -------------------------------------------
+        // 1. call apply and scatter_edges
+        // 2. set edge_dirs and active_minorstep
+        // 3. send vdata, vprog and edge_dirs from master to replicas
+        //
+        // if (rmi.procid() == 0) std::cout << "Applying..." << std::endl;
+        if (!pipeline) {
 #ifdef TUNING
-      bk_ti.start();
+          bk_ti.start();
 #endif
-      run_synchronous( &powerlyra_sync_engine::execute_applys );
+          run_phase( &powerlyra_sync_engine::execute_applys, PHASE_APPLY );
 #ifdef TUNING
-      apply_time += bk_ti.current_time();
+          apply_time += bk_ti.current_time();
 #endif
-      /**
-       * Post conditions:
-       *   1) any changes to the vertex data have been synchronized
-       *      with all mirrors.
-       *   2) all gather accumulators have been cleared
-       *   3) If a vertex program is participating in the scatter
-       *      phase its minor-step bit has been set to active (both
-       *      masters and mirrors) and the vertex program has been
-       *      synchronized with the mirrors.
-       */
+        }
+        if (direction != DIRECTION_PUSH) choose_direction(print_this_round);
+        /**
+         * Post conditions:
+         *   1) any changes to the vertex data have been synchronized
+         *      with all mirrors.
+         *   2) all gather accumulators have been cleared
+         *   3) If a vertex program is participating in the scatter
+         *      phase its minor-step bit has been set to active (both
+         *      masters and mirrors) and the vertex program has been
+         *      synchronized with the mirrors.
+         *   4) pull_next is set if the next superstep pulls, in which
+         *      case the scatter phase only clears the vertex programs.
+         */
 
 
-      // Execute Scatter Operations -----------------------------------------
-      // 1. call scatter (signal: set messages and has_message)
-      //
-      // if (rmi.procid() == 0) std::cout << "Scattering..." << std::endl;
+        // Execute Scatter Operations -----------------------------------------
+        // 1. call scatter (signal: set messages and has_message)
+        //
+        // if (rmi.procid() == 0) std::cout << "Scattering..." << std::endl;
 #ifdef TUNING
-      bk_ti.start();
+        bk_ti.start();
 #endif
-      run_synchronous( &powerlyra_sync_engine::execute_scatters );
+        run_phase( &powerlyra_sync_engine::execute_scatters, PHASE_SCATTER );
 #ifdef TUNING
-      scatter_time += bk_ti.current_time();
+        scatter_time += bk_ti.current_time();
 #endif
 
-      if (post_round_flag) {
+        if (post_round_flag) {
 #ifdef TUNING
-        bk_ti.start();
+          bk_ti.start();
 #endif
-        run_synchronous( &powerlyra_sync_engine::execute_postround );
+          run_phase( &powerlyra_sync_engine::execute_postround, PHASE_POSTROUND );
 #ifdef TUNING
-        postround_time += bk_ti.current_time();
+          postround_time += bk_ti.current_time();
 #endif
+        }
       }
 
+
+      end_superstep();
+
       /**
        * Post conditions:
        *   1) NONE
@@ -1772,6 +2718,21 @@ namespace graphlab {
     std::vector<double> all_compute_time_vec(rmi.numprocs());
     all_compute_time_vec[rmi.procid()] = total_compute_time;
     rmi.all_gather(all_compute_time_vec);
+    // the gather and scatter time lost by the threads waiting for the
+    // slowest thread of their machine
+    double total_idle_time = 0;
+    for (size_t i = 0;i < per_thread_idle_time.size(); ++i) {
+      total_idle_time += per_thread_idle_time[i];
+    }
+    std::vector<double> all_idle_time_vec(rmi.numprocs());
+    all_idle_time_vec[rmi.procid()] = total_idle_time;
+    rmi.all_gather(all_idle_time_vec);
+    logstream(LOG_INFO) << "Thread Idle Time (compute):";
+    for (size_t i = 0;i < per_thread_idle_time.size(); ++i) {
+      logstream(LOG_INFO) << " " << per_thread_idle_time[i]
+                          << " (" << per_thread_compute_time[i] << ")";
+    }
+    logstream(LOG_INFO) << std::endl;
 
     /*logstream(LOG_INFO) << "Local Calls(G|A|S): "
                         << completed_gathers.value << "|" 
@@ -1822,6 +2783,11 @@ namespace graphlab {
         logstream(LOG_EMPH) << all_compute_time_vec[i] << " ";
       }
       logstream(LOG_EMPH) << std::endl;
+      logstream(LOG_EMPH) << "   Idle Balance: ";
+      for (size_t i = 0;i < all_idle_time_vec.size(); ++i) {
+        logstream(LOG_EMPH) << all_idle_time_vec[i] << " ";
+      }
+      logstream(LOG_EMPH) << std::endl;
 #ifdef TUNING
       logstream(LOG_EMPH) << "Total Calls(G|A|S): " 
                           << completed_gathers.value << "|" 
@@ -1838,7 +2804,25 @@ namespace graphlab {
                           << scatter_time << "|"
                           << postround_time
                           << std::endl;
+      logstream(LOG_EMPH) << " Overhead(X|R|G|A|S): "
+                          << phase_overhead[PHASE_EXCHANGE] << "|"
+                          << phase_overhead[PHASE_RECEIVE] << "|"
+                          << phase_overhead[PHASE_GATHER] << "|"
+                          << phase_overhead[PHASE_APPLY] << "|"
+                          << phase_overhead[PHASE_SCATTER] << "|"
+                          << phase_overhead[PHASE_POSTROUND]
+                          << std::endl;
+      logstream(LOG_EMPH) << "    Accum Wait(G->A): " << accum_wait_time;
+      if (pipeline) {
+        logstream(LOG_EMPH) << " (hidden " << accum_hidden_time << ")";
+      }
+      logstream(LOG_EMPH) << std::endl;
+      logstream(LOG_EMPH) << "    Thread Launches: " << num_launches << std::endl;
 #endif
+      if (direction != DIRECTION_PUSH) {
+        logstream(LOG_EMPH) << "Pull Supersteps: " << num_pull_supersteps
+                            << " of " << iteration_counter << std::endl;
+      }
 
 #ifdef COMM_STATS
       logstream(LOG_EMPH) << std::endl;
@@ -1859,6 +2843,181 @@ namespace graphlab {
     return termination_reason;
   } // end of start
 
+  template<typename VertexProgram>
+  bool powerlyra_sync_engine<VertexProgram>::
+  has_active_vertices(const bool print_this_round) {
+    size_t total_active_vertices = num_active_vertices;
+    rmi.all_reduce(total_active_vertices);
+#ifdef ENGINE_DEBUG_PRINT
+    if (rmi.procid() == 0) {
+      logstream(LOG_EMPH) << "\tActive vertices: " << total_active_vertices << std::endl;
+    }
+#else
+    if (rmi.procid() == 0 && print_this_round) {
+      logstream(LOG_EMPH)
+        << "\tActive vertices: " << total_active_vertices << std::endl;
+    }
+#endif  // ENGINE_DEBUG_PRINT
+    return total_active_vertices > 0 || has_pending_work();
+  } // end of has_active_vertices
+
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  count_unexplored_edges() {
+    context_type context(*this, graph);
+    const vertex_program_type vprog = vertex_program_type();
+    size_t nedges = 0;
+    pull_settled.clear();
+    for (lvid_type lvid = 0; lvid < graph.num_local_vertices(); ++lvid) {
+      if (!graph.l_is_master(lvid)) continue;
+      const vertex_type vertex(graph.l_vertex(lvid));
+      if (is_pull_candidate(vprog, context, vertex)) {
+        nedges += vertex_edges(vertex, vprog.gather_edges(context, vertex));
+      } else {
+        pull_settled.set_bit_unsync(lvid);
+      }
+    }
+    rmi.all_reduce(nedges);
+    unexplored_edges = nedges;
+  } // end of count_unexplored_edges
+
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  count_contributors() {
+    const size_t nverts = graph.num_local_vertices();
+    contributors.assign(nverts, gather_contributors());
+    pending_accums.assign(nverts, 0);
+    // the directions in which each mirror has local edges: 1 in, 2 out
+    std::vector<std::vector<std::pair<vertex_id_type, unsigned char> > >
+      mirror_dirs(rmi.numprocs());
+    for (lvid_type lvid = 0; lvid < nverts; ++lvid) {
+      const local_vertex_type local_vertex = graph.l_vertex(lvid);
+      const unsigned char dirs = (local_vertex.num_in_edges() > 0 ? 1 : 0)
+                                 | (local_vertex.num_out_edges() > 0 ? 2 : 0);
+      if (graph.l_is_master(lvid)) {
+        add_contributor(lvid, dirs);
+      } else if (dirs != 0) {
+        mirror_dirs[graph.l_master(lvid)].push_back(
+          std::make_pair(graph.global_vid(lvid), dirs));
+      }
+    }
+    rmi.all_to_all(mirror_dirs);
+    for (procid_t p = 0; p < rmi.numprocs(); ++p) {
+      for (size_t i = 0; i < mirror_dirs[p].size(); ++i) {
+        add_contributor(graph.local_vid(mirror_dirs[p][i].first),
+                        mirror_dirs[p][i].second);
+      }
+    }
+  } // end of count_contributors
+
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  choose_direction(const bool print_this_round) {
+    direction_stats stats;
+    stats.frontier_vertices = frontier_vertices.value;
+    stats.frontier_edges = frontier_edges.value;
+    stats.settled_edges = settled_edges.value;
+    frontier_vertices = frontier_edges = settled_edges = 0;
+    rmi.all_reduce(stats);
+    unexplored_edges -= std::min(unexplored_edges, stats.settled_edges);
+
+    // nothing left to pull from once no vertex has changed
+    bool pull = stats.frontier_vertices > 0;
+    if (pull && direction == DIRECTION_AUTO) {
+      const bool growing = stats.frontier_vertices >= last_frontier_vertices;
+      if (pulling) {
+        // stay bottom-up until the frontier is small and shrinking
+        pull = growing || stats.frontier_vertices * direction_beta
+                          > graph.num_vertices();
+      } else {
+        pull = growing && stats.frontier_edges * direction_alpha
+                          > unexplored_edges;
+      }
+    }
+    last_frontier_vertices = stats.frontier_vertices;
+    pull_next = pull;
+    if (rmi.procid() == 0 && (pull != pulling || print_this_round)) {
+      logstream(LOG_INFO) << "Iteration " << iteration_counter << ": "
+                          << (pull ? "pull" : "push") << " next, frontier "
+                          << stats.frontier_vertices << " vertices "
+                          << stats.frontier_edges << " edges, unexplored "
+                          << unexplored_edges << " edges" << std::endl;
+    }
+  } // end of choose_direction
+
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  execute_superstep(const size_t thread_id, const bool print_this_round) {
+    // The same phases and post conditions as the main loop of start()
+    run_fused_phase(thread_id, &powerlyra_sync_engine::exchange_messages,
+                    PHASE_EXCHANGE);
+    run_fused_phase(thread_id, &powerlyra_sync_engine::receive_messages,
+                    PHASE_RECEIVE);
+    if (thread_id == 0) {
+      if (sched_allv) active_minorstep.fill();
+      has_message.clear();
+      // the only reduction of the superstep: all machines must agree to stop
+      superstep_active = has_active_vertices(print_this_round);
+    }
+    thread_barrier.wait();
+    if (!superstep_active) return;
+    run_fused_phase(thread_id, &powerlyra_sync_engine::execute_gathers,
+                    PHASE_GATHER);
+    // with pipeline the gather phase has run the applies
+    if (!pipeline) {
+      // the other threads wait for the apply phase to start
+      if (thread_id == 0) active_minorstep.clear();
+      run_fused_phase(thread_id, &powerlyra_sync_engine::execute_applys,
+                      PHASE_APPLY);
+    }
+    // ordered before the scatter phase by its first barrier
+    if (thread_id == 0 && direction != DIRECTION_PUSH) {
+      choose_direction(print_this_round);
+    }
+    run_fused_phase(thread_id, &powerlyra_sync_engine::execute_scatters,
+                    PHASE_SCATTER);
+    // postround only touches local vertices
+    if (post_round_flag) {
+      run_fused_phase(thread_id, &powerlyra_sync_engine::execute_postround,
+                      PHASE_POSTROUND);
+    }
+  } // end of execute_superstep
+
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  run_fused_phase(const size_t thread_id,
+                  void (powerlyra_sync_engine::*member_fun)(size_t),
+                  const superstep_phase phase) {
+#ifdef TUNING
+    graphlab::timer phase_ti;
+#endif
+    if (thread_id == 0) {
+      shared_lvid_counter = 0;
+      prepare_frontiers();
+    }
+    thread_barrier.wait();
+#ifdef TUNING
+    timed_phase(member_fun, thread_id);
+#else
+    (this->*member_fun)(thread_id);
+#endif
+    thread_barrier.wait();
+#ifdef TUNING
+    if (thread_id == 0) {
+      const double elapsed = phase_ti.current_time();
+      switch (phase) {
+      case PHASE_EXCHANGE: exch_time += elapsed; break;
+      case PHASE_RECEIVE: recv_time += elapsed; break;
+      case PHASE_GATHER: gather_time += elapsed; break;
+      case PHASE_APPLY: apply_time += elapsed; break;
+      case PHASE_SCATTER: scatter_time += elapsed; break;
+      default: postround_time += elapsed; break;
+      }
+      add_phase_overhead(phase, elapsed);
+    }
+#endif
+  } // end of run_fused_phase
+
   template<typename VertexProgram>
   inline bool powerlyra_sync_engine<VertexProgram>::
   high_lvid(const lvid_type lvid) {
@@ -1879,14 +3038,10 @@ namespace graphlab {
     const size_t TRY_RECV_MOD = 100;
     size_t vcount = 1; // avoid unnecessarily call recv_messages() 
     
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = has_message.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of has_message holding a bit at a time
+    while (has_message.next_word(shared_lvid_counter,
+                                 lvid_block_start, lvid_bit_block)) {
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -1902,16 +3057,20 @@ namespace graphlab {
 #endif // COMM_STATS
           has_message.clear_bit(lvid);
           // clear the message to save memory
-          messages[lvid] = message_type();
+          messages.reset(lvid);
           ++vcount;
         }
         if(vcount % TRY_RECV_MOD == 0) recv_messages();
       }
     } // end of loop over vertices to send messages
     message_exchange.partial_flush();
+    if (masked_messages) message_delta_exchange.partial_flush();
     // Finish sending and receiving all messages
     thread_barrier.wait();
-    if(thread_id == 0) message_exchange.flush();
+    if(thread_id == 0) {
+      message_exchange.flush();
+      if (masked_messages) message_delta_exchange.flush();
+    }
     thread_barrier.wait();
     recv_messages();    
   } // end of exchange_messages
@@ -1926,14 +3085,10 @@ namespace graphlab {
     size_t vcount = 0;
     size_t nactive_inc = 0;
     
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = has_message.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of has_message holding a bit at a time
+    while (has_message.next_word(shared_lvid_counter,
+                                 lvid_block_start, lvid_bit_block)) {
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -1949,24 +3104,27 @@ namespace graphlab {
         const vertex_type vertex(graph.l_vertex(lvid));
         vertex_programs[lvid].init(context, vertex, messages[lvid]);
         // clear the message to save memory
-        messages[lvid] = message_type();
+        messages.reset(lvid);
         if (sched_allv) continue;
         // Determine if the gather should be run
-        const vertex_program_type& const_vprog = vertex_programs[lvid];
-        edge_dir_type gather_dir = const_vprog.gather_edges(context, vertex);
-        if(gather_dir != graphlab::NO_EDGES) {
-          active_minorstep.set_bit(lvid);
-          // send Gx1 msgs
-          if (high_lvid(lvid)
-              || (low_lvid(lvid) // only if gather via out-edge
-                && ((gather_dir == graphlab::ALL_EDGES) 
-                    || (gather_dir == graphlab::OUT_EDGES)))) {
-            send_activs(lvid, thread_id);
-#ifdef COMM_STATS
-            ++num_send_activs;
-#endif // COMM_STATS
-          }
-        }
+        schedule_gather(context, vertex, lvid, thread_id);
+        if(++vcount % TRY_RECV_MOD == 0) recv_activs();
+      }
+    }
+    if (pulling) {
+      // Activate the pull candidates which have not received a message
+      const vertex_program_type pull_vprog = vertex_program_type();
+      const size_t nverts = graph.num_local_vertices();
+      const lvid_type begin = nverts * thread_id / ncpus;
+      const lvid_type end = nverts * (thread_id + 1) / ncpus;
+      for (lvid_type lvid = begin; lvid < end; ++lvid) {
+        if (!graph.l_is_master(lvid) || has_message.get(lvid)) continue;
+        const vertex_type vertex(graph.l_vertex(lvid));
+        if (!is_pull_candidate(pull_vprog, context, vertex)) continue;
+        active_superstep.set_bit(lvid);
+        ++nactive_inc;
+        if (sched_allv) continue;
+        schedule_gather(context, vertex, lvid, thread_id);
         if(++vcount % TRY_RECV_MOD == 0) recv_activs();
       }
     }
@@ -1982,6 +3140,35 @@ namespace graphlab {
   } // end of receive_messages
 
 
+  template<typename VertexProgram>
+  inline void powerlyra_sync_engine<VertexProgram>::
+  schedule_gather(context_type& context, const vertex_type& vertex,
+                  const lvid_type lvid, const size_t thread_id) {
+    const vertex_program_type& const_vprog = vertex_programs[lvid];
+    edge_dir_type gather_dir = const_vprog.gather_edges(context, vertex);
+    bool mirrors_gather = false;
+    if(gather_dir != graphlab::NO_EDGES) {
+      active_minorstep.set_bit(lvid);
+      // send Gx1 msgs
+      if (high_lvid(lvid)
+          || (low_lvid(lvid) // only if gather via out-edge
+            && ((gather_dir == graphlab::ALL_EDGES) 
+                || (gather_dir == graphlab::OUT_EDGES)))) {
+        mirrors_gather = true;
+        send_activs(lvid, thread_id);
+#ifdef COMM_STATS
+        ++num_send_activs;
+#endif // COMM_STATS
+      }
+    }
+    if (pipeline) {
+      pending_accums[lvid] = expected_accums(lvid, gather_dir, mirrors_gather);
+      // nothing to wait for: applied as soon as the apply starts
+      if (pending_accums[lvid] == 0) push_ready(lvid);
+    }
+  } // end of schedule_gather
+
+
   template<typename VertexProgram>
   void powerlyra_sync_engine<VertexProgram>::
   execute_gathers(const size_t thread_id) {
@@ -1989,18 +3176,21 @@ namespace graphlab {
     const bool caching_enabled = !gather_cache.empty();
     fixed_dense_bitset<8 * sizeof(size_t)> local_bitset; // a word-size = 64 bit    
     const size_t TRY_RECV_MOD = 1000;
+    const size_t PIPELINE_FLUSH_WORDS = 16;
     size_t vcount = 0;
+    size_t wcount = 0;
     size_t ngather_inc = 0;
     timer ti;
     
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = active_minorstep.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    size_t next_word = 0, end_word = 0;
+    // a word of active_minorstep holding a bit at a time
+    while (next_minorstep_word(thread_id, next_word, end_word,
+                               lvid_block_start, lvid_bit_block)) {
+      // stream the accumulators gathered so far to their masters
+      if (pipeline && ++wcount % PIPELINE_FLUSH_WORDS == 0) {
+        accum_exchange.partial_flush();
+      }
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -2009,6 +3199,11 @@ namespace graphlab {
         if (lvid >= graph.num_local_vertices()) break;
 
         // [TARGET]: High/Low-degree Masters, and High/Low-degree Mirrors
+        if (is_split_hub(lvid) && !(caching_enabled && has_cache.get(lvid))) {
+          // gathered by all the threads in gather_hubs
+          thread_hubs[thread_id].push_back(lvid);
+          continue;
+        }
         bool accum_is_set = false;
         gather_type accum = gather_type();
         // if caching is enabled and we have a cache entry then use
@@ -2031,9 +3226,9 @@ namespace graphlab {
               edge_type edge(local_edge);
               // elocks[local_edge.id()].lock();
               if(accum_is_set) { // \todo hint likely
-                accum += vprog.gather(context, vertex, edge);
+                accumulate_edge(vprog, context, vertex, edge, accum);
               } else {
-                accum = vprog.gather(context, vertex, edge);
+                accum = gather_edge(vprog, context, vertex, edge);
                 accum_is_set = true;
               }
               // elocks[local_edge.id()].unlock();
@@ -2046,9 +3241,9 @@ namespace graphlab {
               edge_type edge(local_edge);
               // elocks[local_edge.id()].lock();
               if(accum_is_set) { // \todo hint likely
-                accum += vprog.gather(context, vertex, edge);
+                accumulate_edge(vprog, context, vertex, edge, accum);
               } else {
-                accum = vprog.gather(context, vertex, edge);
+                accum = gather_edge(vprog, context, vertex, edge);
                 accum_is_set = true;
               }
               // elocks[local_edge.id()].unlock();
@@ -2077,24 +3272,95 @@ namespace graphlab {
         }
         if(!graph.l_is_master(lvid)) {
           // if this is not the master clear the vertex program
-          vertex_programs[lvid] = vertex_program_type();
+          vertex_programs.reset(lvid);
         }
 
         // try to recv gathers if there are any in the buffer
         if(++vcount % TRY_RECV_MOD == 0) recv_accums();
       }
     } // end of loop over vertices to compute gather accumulators
-    completed_gathers += ngather_inc;
+    // before the barriers of gather_hubs, which times its own slices
     per_thread_compute_time[thread_id] += ti.current_time();
+    per_thread_busy_time[thread_id] = ti.current_time();
+    if (hub_split > 0) ngather_inc += gather_hubs(context, thread_id);
+    completed_gathers += ngather_inc;
     accum_exchange.partial_flush();
+    if (pipeline) {
+      // apply the masters as their last accumulators arrive
+      apply_pipelined(context, thread_id);
+      return;
+    }
     // Finish sending and receiving all gather operations
     thread_barrier.wait();
-    if(thread_id == 0) accum_exchange.flush();
+    if(thread_id == 0) {
+      add_idle_time();
+#ifdef TUNING
+      timer flush_ti;
+#endif
+      accum_exchange.flush();
+#ifdef TUNING
+      accum_wait_time += flush_ti.current_time();
+#endif
+    }
     thread_barrier.wait();
     recv_accums();
   } // end of execute_gathers
 
 
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  apply_pipelined(context_type& context, const size_t thread_id) {
+    const size_t TRY_RECV_MOD = 1000;
+    const size_t READY_CHUNK = 64;
+    size_t vcount = 0;
+    size_t napply_inc = 0;
+    direction_stats stats;
+    std::vector<lvid_type> batch;
+    double wait_time = 0, hidden_time = 0;
+    timer ti, wait_ti;
+    rmi.dc().flush_soon();
+    // No vertex data may change before all the local gathers are done
+    thread_barrier.wait();
+    if (thread_id == 0) {
+      add_idle_time();
+      active_minorstep.clear();
+      applied_masters = 0;
+    }
+    thread_barrier.wait();
+    const size_t nmasters = num_active_vertices.value;
+    while (applied_masters.value < nmasters) {
+      const bool in_flight = pop_ready(batch, READY_CHUNK) < nmasters;
+      if (batch.empty()) {
+        // nothing to overlap with: wait for more accumulators
+        wait_ti.start();
+        recv_accums();
+        recv_updates_activs(); recv_updates();
+        wait_time += wait_ti.current_time();
+        continue;
+      }
+      wait_ti.start();
+      for (size_t i = 0; i < batch.size(); ++i) {
+        apply_vertex(context, batch[i], thread_id, stats);
+        ++napply_inc;
+        if(++vcount % TRY_RECV_MOD == 0) {
+          recv_accums();
+          recv_updates_activs(); recv_updates();
+        }
+      }
+      if (in_flight) hidden_time += wait_ti.current_time();
+      applied_masters += batch.size();
+    }
+#ifdef TUNING
+    if (thread_id == 0) {
+      accum_wait_time += wait_time;
+      accum_hidden_time += hidden_time;
+    }
+#endif
+    per_thread_compute_time[thread_id] += ti.current_time() - wait_time;
+    finish_applys(thread_id, napply_inc, stats);
+  } // end of apply_pipelined
+
+
   template<typename VertexProgram>
   void powerlyra_sync_engine<VertexProgram>::
   execute_applys(const size_t thread_id) {
@@ -2103,16 +3369,13 @@ namespace graphlab {
     const size_t TRY_RECV_MOD = 1000;
     size_t vcount = 0;
     size_t napply_inc = 0;
+    direction_stats stats;
     timer ti;
     
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = active_superstep.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of active_superstep holding a bit at a time
+    while (active_superstep.next_word(shared_lvid_counter,
+                                      lvid_block_start, lvid_bit_block)) {
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -2121,56 +3384,87 @@ namespace graphlab {
         if (lvid >= graph.num_local_vertices()) break;
 
         // [TARGET]: High/Low-degree Masters
-        // Only master vertices can be active in a super-step
-        ASSERT_TRUE(graph.l_is_master(lvid));
-        vertex_type vertex(graph.l_vertex(lvid));
-        // Get the local accumulator.  Note that it is possible that
-        // the gather_accum was not set during the gather.
-        const gather_type& accum = gather_accum[lvid];
-        INCREMENT_EVENT(EVENT_APPLIES, 1);
-        vertex_programs[lvid].apply(context, vertex, accum);
+        apply_vertex(context, lvid, thread_id, stats);
         // record an apply as a completed task
         ++napply_inc;
-        // clear the accumulator to save some memory
-        gather_accum[lvid] = gather_type();
-        // determine if a scatter operation is needed
-        const vertex_program_type& const_vprog = vertex_programs[lvid];
-        const vertex_type const_vertex = vertex;
-        
-        if (const_vprog.scatter_edges(context, const_vertex) 
-            != graphlab::NO_EDGES) {
-          // send Ax1 and Sx1
-          send_updates_activs(lvid, thread_id);
-          active_minorstep.set_bit(lvid);
-#ifdef COMM_STATS
-          ++num_send_updates_activs;
-#endif  // COMM_STATS
-        } else {
-          // send Ax1
-          send_updates(lvid, thread_id);
-          vertex_programs[lvid] = vertex_program_type();
-#ifdef COMM_STATS
-          ++num_send_updates;
-#endif // COMM_STATS
-        }
 
         if(++vcount % TRY_RECV_MOD == 0) {
           recv_updates_activs(); recv_updates();
         }
       }
     } // end of loop over vertices to run apply
-    completed_applys += napply_inc;
     per_thread_compute_time[thread_id] += ti.current_time();
-    update_activ_exchange.partial_flush(); update_exchange.partial_flush();
+    finish_applys(thread_id, napply_inc, stats);
+  } // end of execute_applys
+
+
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  apply_vertex(context_type& context, const lvid_type lvid,
+               const size_t thread_id, direction_stats& stats) {
+    // Only master vertices can be active in a super-step
+    ASSERT_TRUE(graph.l_is_master(lvid));
+    vertex_type vertex(graph.l_vertex(lvid));
+    // Get the local accumulator.  Note that it is possible that
+    // the gather_accum was not set during the gather.
+    const gather_type& accum = gather_accum[lvid];
+    INCREMENT_EVENT(EVENT_APPLIES, 1);
+    vertex_programs[lvid].apply(context, vertex, accum);
+    // clear the accumulator to save some memory
+    gather_accum.reset(lvid);
+    // determine if a scatter operation is needed
+    const vertex_program_type& const_vprog = vertex_programs[lvid];
+    const vertex_type const_vertex = vertex;
+    const edge_dir_type scatter_dir =
+      const_vprog.scatter_edges(context, const_vertex);
+    if (direction != DIRECTION_PUSH) {
+      if (scatter_dir != graphlab::NO_EDGES) {
+        ++stats.frontier_vertices;
+        stats.frontier_edges += vertex_edges(const_vertex, scatter_dir);
+      }
+      if (direction == DIRECTION_AUTO && !pull_settled.get(lvid) &&
+          !is_pull_candidate(const_vprog, context, const_vertex)) {
+        pull_settled.set_bit(lvid);
+        stats.settled_edges += vertex_edges(const_vertex,
+          const_vprog.gather_edges(context, const_vertex));
+      }
+    }
+    
+    if (scatter_dir != graphlab::NO_EDGES) {
+      // send Ax1 and Sx1
+      send_updates_activs(lvid, thread_id);
+      active_minorstep.set_bit(lvid);
+#ifdef COMM_STATS
+      ++num_send_updates_activs;
+#endif  // COMM_STATS
+    } else {
+      // send Ax1
+      send_updates(lvid, thread_id);
+      vertex_programs.reset(lvid);
+#ifdef COMM_STATS
+      ++num_send_updates;
+#endif // COMM_STATS
+    }
+  } // end of apply_vertex
+
+
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::
+  finish_applys(const size_t thread_id, const size_t napply_inc,
+                const direction_stats& stats) {
+    completed_applys += napply_inc;
+    if (direction != DIRECTION_PUSH) {
+      frontier_vertices += stats.frontier_vertices;
+      frontier_edges += stats.frontier_edges;
+      settled_edges += stats.settled_edges;
+    }
+    partial_flush_updates();
     thread_barrier.wait();
     // Flush the buffer and finish receiving any remaining updates.
-    if(thread_id == 0) {
-      update_activ_exchange.flush(); update_exchange.flush();
-    }
+    if(thread_id == 0) flush_updates();
     thread_barrier.wait();
     recv_updates_activs(); recv_updates();
-    
-  } // end of execute_applys
+  } // end of finish_applys
 
 
   template<typename VertexProgram>
@@ -2181,14 +3475,11 @@ namespace graphlab {
     size_t nscatter_inc = 0;
     timer ti;
     
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = active_minorstep.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    size_t next_word = 0, end_word = 0;
+    // a word of active_minorstep holding a bit at a time
+    while (next_minorstep_word(thread_id, next_word, end_word,
+                               lvid_block_start, lvid_bit_block)) {
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -2197,6 +3488,17 @@ namespace graphlab {
         if (lvid >= graph.num_local_vertices()) break;
 
         // [TARGET]: High/Low-degree Masters, and High/Low-degree Mirrors
+        if (pull_next) {
+          // its neighbors pull from it in the next superstep instead
+          vertex_programs.reset(lvid);
+          ++nscatter_inc;
+          continue;
+        }
+        if (is_split_hub(lvid)) {
+          // scattered by all the threads in scatter_hubs
+          thread_hubs[thread_id].push_back(lvid);
+          continue;
+        }
         const vertex_program_type& vprog = vertex_programs[lvid];
         local_vertex_type local_vertex = graph.l_vertex(lvid);
         const vertex_type vertex(local_vertex);
@@ -2225,14 +3527,153 @@ namespace graphlab {
         } // end of if out_edges/all_edges
         INCREMENT_EVENT(EVENT_SCATTERS, edges_touched);
         // Clear the vertex program
-        vertex_programs[lvid] = vertex_program_type();
+        vertex_programs.reset(lvid);
         ++nscatter_inc;
       } // end of if active on this minor step
     } // end of loop over vertices to complete scatter operation
-    completed_scatters += nscatter_inc;
+    // before the barriers of scatter_hubs, which times its own slices
     per_thread_compute_time[thread_id] += ti.current_time();
+    per_thread_busy_time[thread_id] = ti.current_time();
+    if (hub_split > 0) nscatter_inc += scatter_hubs(context, thread_id);
+    completed_scatters += nscatter_inc;
+    thread_barrier.wait();
+    if (thread_id == 0) add_idle_time();
   } // end of execute_scatters
 
+  template<typename VertexProgram>
+  void powerlyra_sync_engine<VertexProgram>::collect_hubs() {
+    split_hubs.clear();
+    for (size_t i = 0; i < thread_hubs.size(); ++i) {
+      split_hubs.insert(split_hubs.end(), thread_hubs[i].begin(), thread_hubs[i].end());
+      thread_hubs[i].clear();
+    }
+  } // end of collect_hubs
+
+  template<typename VertexProgram>
+  size_t powerlyra_sync_engine<VertexProgram>::
+  gather_hubs(context_type& context, const size_t thread_id) {
+    const bool caching_enabled = !gather_cache.empty();
+    thread_barrier.wait();
+    if (thread_id == 0) {
+      collect_hubs();
+      hub_accums.assign(split_hubs.size() * ncpus, gather_type());
+      hub_accum_set.assign(split_hubs.size() * ncpus, false);
+    }
+    thread_barrier.wait();
+    // only the work between the barriers is busy time
+    timer ti;
+    // Each thread gathers its slice of the edges of every hub
+    for (size_t h = 0; h < split_hubs.size(); ++h) {
+      const lvid_type lvid = split_hubs[h];
+      const vertex_program_type& vprog = vertex_programs[lvid];
+      local_vertex_type local_vertex = graph.l_vertex(lvid);
+      const vertex_type vertex(local_vertex);
+      const edge_dir_type gather_dir = vprog.gather_edges(context, vertex);
+      const size_t nin = (gather_dir == IN_EDGES || gather_dir == ALL_EDGES)
+                         ? local_vertex.num_in_edges() : 0;
+      const size_t nout = (gather_dir == OUT_EDGES || gather_dir == ALL_EDGES)
+                          ? local_vertex.num_out_edges() : 0;
+      const size_t begin = (nin + nout) * thread_id / ncpus;
+      const size_t end = (nin + nout) * (thread_id + 1) / ncpus;
+      gather_type& accum = hub_accums[h * ncpus + thread_id];
+      bool accum_is_set = false;
+      for (size_t i = begin; i < end; ++i) {
+        edge_type edge(i < nin ? local_vertex.in_edges()[i]
+                               : local_vertex.out_edges()[i - nin]);
+        if(accum_is_set) {
+          accumulate_edge(vprog, context, vertex, edge, accum);
+        } else {
+          accum = gather_edge(vprog, context, vertex, edge);
+          accum_is_set = true;
+        }
+      }
+      hub_accum_set[h * ncpus + thread_id] = accum_is_set;
+      INCREMENT_EVENT(EVENT_GATHERS, end - begin);
+    }
+    double hub_time = ti.current_time();
+    thread_barrier.wait();
+    ti.start();
+    // The partial accumulators of a hub are summed by one thread
+    size_t ngather_inc = 0;
+    for (size_t h = thread_id; h < split_hubs.size(); h += ncpus) {
+      const lvid_type lvid = split_hubs[h];
+      const vertex_program_type& vprog = vertex_programs[lvid];
+      bool accum_is_set = false;
+      gather_type accum = gather_type();
+      vprog.pre_local_gather(accum);
+      for (size_t t = 0; t < ncpus; ++t) {
+        if (!hub_accum_set[h * ncpus + t]) continue;
+        if (accum_is_set) {
+          accum += hub_accums[h * ncpus + t];
+        } else {
+          accum = hub_accums[h * ncpus + t];
+          accum_is_set = true;
+        }
+      }
+      ++ngather_inc;
+      vprog.post_local_gather(accum);
+      if(caching_enabled && accum_is_set) {
+        gather_cache[lvid] = accum; has_cache.set_bit(lvid);
+      }
+      if(accum_is_set) {
+        send_accum(lvid, accum, thread_id);
+#ifdef COMM_STATS
+        ++num_send_accums;
+#endif // COMM_STATS
+      }
+      if(!graph.l_is_master(lvid)) {
+        vertex_programs.reset(lvid);
+      }
+    }
+    hub_time += ti.current_time();
+    per_thread_compute_time[thread_id] += hub_time;
+    per_thread_busy_time[thread_id] += hub_time;
+    return ngather_inc;
+  } // end of gather_hubs
+
+  template<typename VertexProgram>
+  size_t powerlyra_sync_engine<VertexProgram>::
+  scatter_hubs(context_type& context, const size_t thread_id) {
+    thread_barrier.wait();
+    if (thread_id == 0) collect_hubs();
+    thread_barrier.wait();
+    // only the work between the barriers is busy time
+    timer ti;
+    // Each thread scatters its slice of the edges of every hub
+    for (size_t h = 0; h < split_hubs.size(); ++h) {
+      const lvid_type lvid = split_hubs[h];
+      const vertex_program_type& vprog = vertex_programs[lvid];
+      local_vertex_type local_vertex = graph.l_vertex(lvid);
+      const vertex_type vertex(local_vertex);
+      const edge_dir_type scatter_dir = vprog.scatter_edges(context, vertex);
+      const size_t nin = (scatter_dir == IN_EDGES || scatter_dir == ALL_EDGES)
+                         ? local_vertex.num_in_edges() : 0;
+      const size_t nout = (scatter_dir == OUT_EDGES || scatter_dir == ALL_EDGES)
+                          ? local_vertex.num_out_edges() : 0;
+      const size_t begin = (nin + nout) * thread_id / ncpus;
+      const size_t end = (nin + nout) * (thread_id + 1) / ncpus;
+      for (size_t i = begin; i < end; ++i) {
+        edge_type edge(i < nin ? local_vertex.in_edges()[i]
+                               : local_vertex.out_edges()[i - nin]);
+        vprog.scatter(context, vertex, edge);
+      }
+      INCREMENT_EVENT(EVENT_SCATTERS, end - begin);
+    }
+    double hub_time = ti.current_time();
+    thread_barrier.wait();
+    ti.start();
+    // Clear the vertex programs once all the slices are done
+    size_t nscatter_inc = 0;
+    for (size_t h = thread_id; h < split_hubs.size(); h += ncpus) {
+      vertex_programs.reset(split_hubs[h]);
+      ++nscatter_inc;
+    }
+    hub_time += ti.current_time();
+    per_thread_compute_time[thread_id] += hub_time;
+    per_thread_busy_time[thread_id] += hub_time;
+    return nscatter_inc;
+  } // end of scatter_hubs
+
   template<typename VertexProgram>
   void powerlyra_sync_engine<VertexProgram>::
   execute_resets(const size_t thread_id) {
@@ -2262,7 +3703,7 @@ namespace graphlab {
         // sync_vertex_data(lvid, thread_id);
 
         // clear vertex_program
-        vertex_programs[lvid] = vertex_program_type();
+        vertex_programs.reset(lvid);
       }
     }
   } // end of execute_resets
@@ -2296,7 +3737,7 @@ namespace graphlab {
         // sync_vertex_data(lvid, thread_id);
 
         // we are done so clear vertex_program
-        vertex_programs[lvid] = vertex_program_type();
+        vertex_programs.reset(lvid);
       }
     }
   } // end of execute_postround
@@ -2307,14 +3748,10 @@ namespace graphlab {
     context_type context(*this, graph);
     fixed_dense_bitset<8 * sizeof(size_t)> local_bitset; // a word-size = 64 bit
 
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = has_message.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of has_message holding a bit at a time
+    while (has_message.next_word(shared_lvid_counter,
+                                 lvid_block_start, lvid_bit_block)) {
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -2327,7 +3764,7 @@ namespace graphlab {
           send_message(lvid, thread_id);
           has_message.clear_bit(lvid);
           // clear the message to save memory
-          messages[lvid] = message_type();
+          messages.reset(lvid);
 #ifdef COMM_STATS
           ++num_send_messages;
 #endif // COMM_STATS
@@ -2335,9 +3772,13 @@ namespace graphlab {
       }
     } // end of loop over vertices to send messages
     message_exchange.partial_flush();
+    if (masked_messages) message_delta_exchange.partial_flush();
     // Finish sending and receiving all messages
     thread_barrier.wait();
-    if(thread_id == 0) message_exchange.flush();
+    if(thread_id == 0) {
+      message_exchange.flush();
+      if (masked_messages) message_delta_exchange.flush();
+    }
     thread_barrier.wait();
     recv_messages();
   } // end of execute_source_flush
@@ -2350,14 +3791,10 @@ namespace graphlab {
     const size_t TRY_RECV_MOD = 1000;
     size_t vcount = 0;
 
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = active_superstep.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of active_superstep holding a bit at a time
+    while (active_superstep.next_word(shared_lvid_counter,
+                                      lvid_block_start, lvid_bit_block)) {
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -2371,7 +3808,7 @@ namespace graphlab {
         vertex_type vertex(graph.l_vertex(lvid));
         vertex_programs[lvid].source_init(context, vertex, messages[lvid]);
         // clear the message to save some memory
-        messages[lvid] = message_type();
+        messages.reset(lvid);
         // determine if a scatter operation is needed
         const vertex_program_type& const_vprog = vertex_programs[lvid];
         const vertex_type const_vertex = vertex;
@@ -2387,7 +3824,7 @@ namespace graphlab {
         } else {
           // send Ax1
           send_updates(lvid, thread_id);
-          vertex_programs[lvid] = vertex_program_type();
+          vertex_programs.reset(lvid);
 #ifdef COMM_STATS
           ++num_send_updates;
 #endif // COMM_STATS
@@ -2399,12 +3836,10 @@ namespace graphlab {
       }
     } // end of loop over vertices to run apply
 
-    update_activ_exchange.partial_flush(); update_exchange.partial_flush();
+    partial_flush_updates();
     thread_barrier.wait();
     // Flush the buffer and finish receiving any remaining updates.
-    if(thread_id == 0) {
-      update_activ_exchange.flush(); update_exchange.flush();
-    }
+    if(thread_id == 0) flush_updates();
     thread_barrier.wait();
     recv_updates_activs(); recv_updates();
   } // end of execute_source_init
@@ -2416,14 +3851,10 @@ namespace graphlab {
     fixed_dense_bitset<8 * sizeof(size_t)> local_bitset; // allocate a word size = 64 bits
     size_t nscatter_inc = 0;
 
-    while (1) {
-      // increment by a word at a time
-      lvid_type lvid_block_start =
-                  shared_lvid_counter.inc_ret_last(8 * sizeof(size_t));
-      if (lvid_block_start >= graph.num_local_vertices()) break;
-      // get the bit field from has_message
-      size_t lvid_bit_block = active_minorstep.containing_word(lvid_block_start);
-      if (lvid_bit_block == 0) continue;
+    size_t lvid_block_start, lvid_bit_block;
+    // a word of active_minorstep holding a bit at a time
+    while (active_minorstep.next_word(shared_lvid_counter,
+                                      lvid_block_start, lvid_bit_block)) {
       // initialize a word sized bitfield
       local_bitset.clear();
       local_bitset.initialize_from_mem(&lvid_bit_block, sizeof(size_t));
@@ -2460,7 +3891,7 @@ namespace graphlab {
         } // end of if out_edges/all_edges
         INCREMENT_EVENT(EVENT_SCATTERS, edges_touched);
         // Clear the vertex program
-        vertex_programs[lvid] = vertex_program_type();
+        vertex_programs.reset(lvid);
         ++nscatter_inc;
       } // end of if active on this minor step
     } // end of loop over vertices to complete scatter operation
@@ -2489,10 +3920,11 @@ namespace graphlab {
     while(activ_exchange.recv(recv_buffer)) {
       for (size_t i = 0;i < recv_buffer.size(); ++i) {
         typename activ_exchange_type::buffer_type& buffer = recv_buffer[i].buffer;
-        foreach(const vid_vprog_pair_type& pair, buffer) {
+        // the receive buffer is dropped afterwards, so move out of it
+        foreach(vid_vprog_pair_type& pair, buffer) {
           const lvid_type lvid = graph.local_vid(pair.first);
           ASSERT_FALSE(graph.l_is_master(lvid));
-          vertex_programs[lvid] = pair.second;
+          vertex_programs.assign(lvid, std::move(pair.second));
           active_minorstep.set_bit(lvid);
         }
       }
@@ -2505,6 +3937,16 @@ namespace graphlab {
     ASSERT_TRUE(graph.l_is_master(lvid));
     const vertex_id_type vid = graph.global_vid(lvid);
     local_vertex_type vertex = graph.l_vertex(lvid);
+    lane_delta_type delta;
+    if (delta_sync && vertex.num_mirrors() > 0 &&
+        make_lane_delta(lvid, delta, is_multi_vertex_program<VertexProgram>())) {
+      foreach(const procid_t& mirror, vertex.mirrors()) {
+        delta_activ_exchange.send(mirror,
+                                  make_triple(vid, delta,
+                                              vertex_programs[lvid]));
+      }
+      return;
+    }
     foreach(const procid_t& mirror, vertex.mirrors()) {
       update_activ_exchange.send(mirror, 
                            make_triple(vid, 
@@ -2520,16 +3962,30 @@ namespace graphlab {
     while(update_activ_exchange.recv(recv_buffer)) {
       for (size_t i = 0;i < recv_buffer.size(); ++i) {
         update_activ_buffer_type& buffer = recv_buffer[i].buffer;
-        foreach(const vid_vdata_vprog_triple_type& t, buffer) {
+        foreach(vid_vdata_vprog_triple_type& t, buffer) {
           const lvid_type lvid = graph.local_vid(t.first);
           ASSERT_FALSE(graph.l_is_master(lvid));
-          graph.l_vertex(lvid).data() = t.second;
-          vertex_programs[lvid] = t.third;
+          graph.l_vertex(lvid).data() = std::move(t.second);
+          vertex_programs.assign(lvid, std::move(t.third));
           active_minorstep.set_bit(lvid);
         }
       }
     }
-  } // end of recv_updates
+    typename delta_activ_exchange_type::recv_buffer_type delta_recv_buffer;
+    while(delta_activ_exchange.recv(delta_recv_buffer)) {
+      for (size_t i = 0;i < delta_recv_buffer.size(); ++i) {
+        delta_activ_buffer_type& buffer = delta_recv_buffer[i].buffer;
+        foreach(vid_delta_vprog_triple_type& t, buffer) {
+          const lvid_type lvid = graph.local_vid(t.first);
+          ASSERT_FALSE(graph.l_is_master(lvid));
+          apply_lane_delta(lvid, t.second,
+                           is_multi_vertex_program<VertexProgram>());
+          vertex_programs.assign(lvid, std::move(t.third));
+          active_minorstep.set_bit(lvid);
+        }
+      }
+    }
+  } // end of recv_updates_activs
 
   template<typename VertexProgram>
   inline void powerlyra_sync_engine<VertexProgram>::
@@ -2537,6 +3993,16 @@ namespace graphlab {
     ASSERT_TRUE(graph.l_is_master(lvid));
     const vertex_id_type vid = graph.global_vid(lvid);
     local_vertex_type vertex = graph.l_vertex(lvid);
+    lane_delta_type delta;
+    if (delta_sync && vertex.num_mirrors() > 0 &&
+        make_lane_delta(lvid, delta, is_multi_vertex_program<VertexProgram>())) {
+      // the mirrors are up to date if no lane has changed
+      if (delta.mask.vec_all_zeros()) return;
+      foreach(const procid_t& mirror, vertex.mirrors()) {
+        delta_exchange.send(mirror, std::make_pair(vid, delta));
+      }
+      return;
+    }
     foreach(const procid_t& mirror, vertex.mirrors()) {
       update_exchange.send(mirror, std::make_pair(vid, vertex.data()));
     }
@@ -2549,27 +4015,68 @@ namespace graphlab {
     while(update_exchange.recv(recv_buffer)) {
       for (size_t i = 0;i < recv_buffer.size(); ++i) {
         update_buffer_type& buffer = recv_buffer[i].buffer;
-        foreach(const vid_vdata_pair_type& pair, buffer) {
+        foreach(vid_vdata_pair_type& pair, buffer) {
           const lvid_type lvid = graph.local_vid(pair.first);
           ASSERT_FALSE(graph.l_is_master(lvid));
-          graph.l_vertex(lvid).data() = pair.second;
+          graph.l_vertex(lvid).data() = std::move(pair.second);
+        }
+      }
+    }
+    typename delta_exchange_type::recv_buffer_type delta_recv_buffer;
+    while(delta_exchange.recv(delta_recv_buffer)) {
+      for (size_t i = 0;i < delta_recv_buffer.size(); ++i) {
+        delta_buffer_type& buffer = delta_recv_buffer[i].buffer;
+        foreach(const vid_delta_pair_type& pair, buffer) {
+          const lvid_type lvid = graph.local_vid(pair.first);
+          ASSERT_FALSE(graph.l_is_master(lvid));
+          apply_lane_delta(lvid, pair.second,
+                           is_multi_vertex_program<VertexProgram>());
         }
       }
     }
   } // end of recv_updates
 
+  template<typename VertexProgram>
+  inline bool powerlyra_sync_engine<VertexProgram>::
+  make_lane_delta(lvid_type lvid, lane_delta_type& delta, boost::true_type) {
+    vertex_programs[lvid].changed_lanes(delta.mask);
+    // programs which do not track lanes return an unsized mask
+    if (delta.mask.size() == 0) return false;
+    // serialized by the send() of the delta, in the exchange buffer
+    delta.set_source(graph.l_vertex(lvid).data());
+    return true;
+  } // end of make_lane_delta
+
+  template<typename VertexProgram>
+  inline void powerlyra_sync_engine<VertexProgram>::
+  apply_lane_delta(lvid_type lvid, const lane_delta_type& delta,
+                   boost::true_type) {
+    delta.load_lanes(graph.l_vertex(lvid).data());
+  } // end of apply_lane_delta
+
+  template<typename VertexProgram>
+  inline void powerlyra_sync_engine<VertexProgram>::
+  partial_flush_updates() {
+    update_activ_exchange.partial_flush(); update_exchange.partial_flush();
+    if (delta_sync) {
+      delta_activ_exchange.partial_flush(); delta_exchange.partial_flush();
+    }
+  } // end of partial_flush_updates
+
+  template<typename VertexProgram>
+  inline void powerlyra_sync_engine<VertexProgram>::
+  flush_updates() {
+    update_activ_exchange.flush(); update_exchange.flush();
+    if (delta_sync) {
+      delta_activ_exchange.flush(); delta_exchange.flush();
+    }
+  } // end of flush_updates
+
   template<typename VertexProgram>
   inline void powerlyra_sync_engine<VertexProgram>::
-  send_accum(lvid_type lvid, const gather_type& accum, const size_t thread_id) {
+  send_accum(lvid_type lvid, gather_type& accum, const size_t thread_id) {
     if(graph.l_is_master(lvid)) {
-      vlocks[lvid].lock();
-      if(has_gather_accum.get(lvid)) {
-        gather_accum[lvid] += accum;
-      } else {
-        gather_accum[lvid] = accum;
-        has_gather_accum.set_bit(lvid);
-      }
-      vlocks[lvid].unlock();
+      merge_accum(lvid, accum);
     } else {
       const procid_t master = graph.l_master(lvid);
       const vertex_id_type vid = graph.global_vid(lvid);
@@ -2584,23 +4091,56 @@ namespace graphlab {
     while(accum_exchange.recv(recv_buffer)) {
       for (size_t i = 0; i < recv_buffer.size(); ++i) {
         typename accum_exchange_type::buffer_type& buffer = recv_buffer[i].buffer;
-        foreach(const vid_gather_pair_type& pair, buffer) {
+        foreach(vid_gather_pair_type& pair, buffer) {
           const lvid_type lvid = graph.local_vid(pair.first);
-          const gather_type& acc = pair.second;
+          gather_type& acc = pair.second;
           ASSERT_TRUE(graph.l_is_master(lvid));
-          vlocks[lvid].lock();
-          if(has_gather_accum.get(lvid)) {
-            gather_accum[lvid] += acc;
-          } else {
-            gather_accum[lvid] = acc;
-            has_gather_accum.set_bit(lvid);
-          }
-          vlocks[lvid].unlock();
+          merge_accum(lvid, acc);
         }
       }
     }
   } // end of recv_accums
 
+  template<typename VertexProgram>
+  inline void powerlyra_sync_engine<VertexProgram>::
+  merge_accum(lvid_type lvid, gather_type& accum) {
+    vlocks[lvid].lock();
+    if(has_gather_accum.get(lvid)) {
+      gather_accum[lvid] += accum;
+    } else {
+      gather_accum.assign(lvid, std::move(accum));
+      has_gather_accum.set_bit(lvid);
+    }
+    bool ready = false;
+    if (pipeline) {
+      ASSERT_GT(pending_accums[lvid], 0);
+      ready = --pending_accums[lvid] == 0;
+    }
+    vlocks[lvid].unlock();
+    if (ready) push_ready(lvid);
+  } // end of merge_accum
+
+  template<typename VertexProgram>
+  inline void powerlyra_sync_engine<VertexProgram>::
+  push_ready(lvid_type lvid) {
+    ready_lock.lock();
+    ready_masters.push_back(lvid);
+    ++num_ready_masters;
+    ready_lock.unlock();
+  } // end of push_ready
+
+  template<typename VertexProgram>
+  inline size_t powerlyra_sync_engine<VertexProgram>::
+  pop_ready(std::vector<lvid_type>& batch, const size_t max_batch) {
+    ready_lock.lock();
+    const size_t n = std::min(max_batch, ready_masters.size());
+    batch.assign(ready_masters.end() - n, ready_masters.end());
+    ready_masters.resize(ready_masters.size() - n);
+    const size_t nready = num_ready_masters;
+    ready_lock.unlock();
+    return nready;
+  } // end of pop_ready
+
 
   template<typename VertexProgram>
   inline void powerlyra_sync_engine<VertexProgram>::
@@ -2608,9 +4148,31 @@ namespace graphlab {
     ASSERT_FALSE(graph.l_is_master(lvid));
     const procid_t master = graph.l_master(lvid);
     const vertex_id_type vid = graph.global_vid(lvid);
+    lane_delta_type delta;
+    if (masked_messages &&
+        make_message_delta(lvid, delta, is_multi_vertex_program<VertexProgram>())) {
+      message_delta_exchange.send(master, std::make_pair(vid, delta));
+      return;
+    }
     message_exchange.send(master, std::make_pair(vid, messages[lvid]));
   } // end of send_message
 
+  template<typename VertexProgram>
+  inline bool powerlyra_sync_engine<VertexProgram>::
+  make_message_delta(lvid_type lvid, lane_delta_type& delta, boost::true_type) {
+    vertex_programs[lvid].message_lanes(messages[lvid], delta.mask);
+    if (delta.mask.size() == 0) return false;
+    delta.set_source(messages[lvid]);
+    return true;
+  } // end of make_message_delta
+
+  template<typename VertexProgram>
+  inline void powerlyra_sync_engine<VertexProgram>::
+  load_message_delta(message_type& msg, const lane_delta_type& delta,
+                     boost::true_type) {
+    delta.load_lanes(msg);
+  } // end of load_message_delta
+
   template<typename VertexProgram>
   inline void powerlyra_sync_engine<VertexProgram>::
   recv_messages() {
@@ -2618,15 +4180,36 @@ namespace graphlab {
     while(message_exchange.recv(recv_buffer)) {
       for (size_t i = 0;i < recv_buffer.size(); ++i) {
         typename message_exchange_type::buffer_type& buffer = recv_buffer[i].buffer;
-        foreach(const vid_message_pair_type& pair, buffer) {
+        foreach(vid_message_pair_type& pair, buffer) {
+          const lvid_type lvid = graph.local_vid(pair.first);
+          message_type& msg = pair.second;
+          ASSERT_TRUE(graph.l_is_master(lvid));
+          vlocks[lvid].lock();
+          if(has_message.get(lvid)) {
+            messages[lvid] += msg;
+          } else {
+            messages.assign(lvid, std::move(msg));
+            has_message.set_bit(lvid);
+          }
+          vlocks[lvid].unlock();
+        }
+      }
+    }
+    typename delta_exchange_type::recv_buffer_type delta_recv_buffer;
+    while(message_delta_exchange.recv(delta_recv_buffer)) {
+      for (size_t i = 0;i < delta_recv_buffer.size(); ++i) {
+        delta_buffer_type& buffer = delta_recv_buffer[i].buffer;
+        foreach(const vid_delta_pair_type& pair, buffer) {
           const lvid_type lvid = graph.local_vid(pair.first);
-          const message_type& msg = pair.second;
           ASSERT_TRUE(graph.l_is_master(lvid));
+          message_type msg;
+          load_message_delta(msg, pair.second,
+                             is_multi_vertex_program<VertexProgram>());
           vlocks[lvid].lock();
           if(has_message.get(lvid)) {
             messages[lvid] += msg;
           } else {
-            messages[lvid] = msg;
+            messages.assign(lvid, std::move(msg));
             has_message.set_bit(lvid);
           }
           vlocks[lvid].unlock();
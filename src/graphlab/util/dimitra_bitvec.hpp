@@ -5,45 +5,61 @@
 #include <cstdlib>
 #include <cstring>
 #include <stdint.h>
+#include <utility>
 #include <graphlab/logger/logger.hpp>
 #include <graphlab/parallel/atomic_ops.hpp>
 #include <graphlab/serialization/serialization_includes.hpp>
-
-#include <immintrin.h>
-
-/**
- * Define SSE constants for SIMD operation usage
- */
-__mmask8 sseAllOnes8 = __mmask8(0xFF);
-__mmask8 sseMasks8[8] = {
-        __mmask8(0x1), __mmask8(0x2), __mmask8(0x4), __mmask8(0x8),
-        __mmask8(0x10), __mmask8(0x20), __mmask8(0x40), __mmask8(0x80)
-};
-__m256 sseAllZeroPS256 = _mm256_setzero_ps();
-__m256i sseAllZero256 = _mm256_setzero_si256();
-__m256i sseAllOnes256 = _mm256_cmpeq_epi32(sseAllZero256, sseAllZero256);
+#include <graphlab/util/dimitra_lane_pool.hpp>
+#include <graphlab/util/dimitra_simd.hpp>
 
 /**
  * TODO:
- * (1) add SIMD support
- * (2) add fixed_xxx as friend class
- * (3) finish empty functions
- * (4) add necessary operators
+ * (1) finish empty functions
+ * (2) add necessary operators
+ *
+ * See dimitra_fixedvec.hpp for lane vectors whose size is known at
+ * compile time, and dimitra_hybridvec.hpp for lane vectors which
+ * mostly hold one fill value.
  */
 
 namespace graphlab {
     /**
      * Implements array of int | float | bit for DiMITra
+     *
+     * Besides bool, int and float, lanes may be int16_t or uint8_t,
+     * which pack 2x / 4x as many lanes in a register and on the wire as
+     * int, or int64_t and double for values which overflow or lose
+     * precision in 32 bits (see automi_numeric_bitvec).
+     *
+     * Lanes are grouped in blocks of 8: the functions taking a block
+     * index 'b' only touch lanes [8b, 8b + 8).  Element-wise operations
+     * of int and float vectors run on the SIMD backend selected at
+     * runtime (see dimitra_simd.hpp), and a bool vector stores one
+     * block of 8 lanes per byte.
+     *
+     * The storage of a bool vector is padded to whole 64-bit words, and
+     * its whole-vector operations run on words with the lane mask
+     * kernels of the selected backend.  The lanes past size() and the
+     * padding are kept 0, so that count(), vec_any() and friends need
+     * no tail handling.
+     *
+     * Lane buffers come from the per-thread pool of dimitra_lane_pool.hpp,
+     * and moving a bitvec hands its buffer over without copying.
      */
     /// Primary template class automi_bitvec
     template <typename dtype>
     class automi_bitvec {};
 
+    template<> class automi_bitvec<int>;
+    template<> class automi_bitvec<float>;
+    template <typename T> class automi_numeric_bitvec;
+    template <typename T> class automi_hybridvec;
+
     /// specialized <dtype=bool> class automi_bitvec
     template<>
     class automi_bitvec<bool> {
     public:
-        typedef __mmask8 element;
+        typedef uint8_t element;
         automi_bitvec<bool>() : array(NULL), len(0), arrlen(0) {}
 
         /// Constructs a bitvec with 'size' elements. All elements are 0.
@@ -60,35 +76,93 @@ namespace graphlab {
             *this = db;
         }
 
+        /// Takes over the lanes of bitvec db, leaving it empty
+        automi_bitvec<bool>(automi_bitvec<bool>&& db) noexcept : array(db.array), len(db.len), arrlen(db.arrlen) {
+            db.array = NULL;
+            db.len = 0;
+            db.arrlen = 0;
+        }
+
         /// destructor
-        ~automi_bitvec() { free(array); }
+        ~automi_bitvec() { automi_lane_free(array, storage_bytes(arrlen)); }
 
         /// Make a new copy of the bitvec db
         inline automi_bitvec<bool>& operator=(const automi_bitvec<bool>& db) {
+            if (this == &db) return *this;
             resize(db.size());
-            len = db.len;
-            arrlen = db.arrlen;
-            memcpy(array, db.array, sizeof(__mmask8) * arrlen);
+            memcpy(array, db.array, storage_bytes(arrlen));
             return *this;
         }
 
+        /**
+         * Swaps the lanes with bitvec db, which releases the old lanes of this
+         * one.  Lanes borrowed from an arena stay with their bitvec, so those
+         * are copied instead.
+         */
+        inline automi_bitvec<bool>& operator=(automi_bitvec<bool>&& db) {
+            if (borrows_lanes() || db.borrows_lanes()) return *this = db;
+            std::swap(array, db.array);
+            std::swap(len, db.len);
+            std::swap(arrlen, db.arrlen);
+            return *this;
+        }
+
+        /// Returns the bytes of lane storage, as taken by bind_storage()
+        inline size_t storage_size() const {
+            return storage_bytes(arrlen);
+        }
+
+        /**
+         * Moves the lanes to 'storage', of at least storage_size() bytes in a
+         * registered arena (see automi_lane_arena), which this bitvec then
+         * borrows instead of owning.
+         */
+        inline void bind_storage(void* storage) {
+            if (storage_size() == 0 || storage == array) return;
+            memcpy(storage, array, storage_size());
+            automi_lane_free(array, storage_size());
+            array = reinterpret_cast<element*>(storage);
+        }
+
+        /// Returns true if the lanes are borrowed from an arena
+        inline bool borrows_lanes() const {
+            return array != NULL && automi_lane_in_arena(array);
+        }
+
         /**
          * If new size 'n' is larger than 'len', reallocate memory and set to 0;
-         * if new size 'n' is smaller than 'len', leave 'deleted' memory unattended.
+         * if new size 'n' is smaller than 'len', the lanes past 'n' are cleared.
          */
         inline void resize(size_t n) {
             len = n;
             size_t prev_arrlen = arrlen;
-            arrlen = n / 8;
-            array = (__mmask8 *)realloc(array, sizeof(__mmask8) * arrlen);
+            arrlen = (n + 7) / 8;
+            array = (element*)automi_lane_realloc(array, storage_bytes(prev_arrlen), storage_bytes(arrlen));
             if (arrlen > prev_arrlen) {
-                memset(&array[prev_arrlen], 0, sizeof(__mmask8) * (arrlen - prev_arrlen));
+                memset(&array[prev_arrlen], 0, storage_bytes(arrlen) - prev_arrlen);
+            }
+            else {
+                clear_tail();
             }
         }
 
         /// Set all memory within bitvec to 0
         inline void clear() {
-            memset(array, 0, sizeof(__mmask8) * arrlen);
+            memset(array, 0, storage_bytes(arrlen));
+        }
+
+        /**
+         * Keeps the lanes set in 'keep', moved down to the lowest lanes in
+         * order, and shrinks this bitvec to them.
+         */
+        inline void compact(const automi_bitvec<bool>& keep) {
+            const size_t n = len < keep.len ? len : keep.len;
+            size_t kept = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (keep.test_bit(i)) set_single(test_bit(i), kept++);
+            }
+            resize(kept);
+            clear_tail();
         }
 
         /// Returns the number of elements in this bitvec
@@ -99,10 +173,11 @@ namespace graphlab {
         /// Set all element values using provided val
         inline void set_all(bool val) {
             if (val) {
-                memset(array, sseAllOnes8, sizeof(__mmask8) * arrlen);
+                memset(array, 0xFF, sizeof(element) * arrlen);
+                clear_tail();
             }
             else {
-                memset(array, 0, sizeof(__mmask8) * arrlen);
+                memset(array, 0, sizeof(element) * arrlen);
             }
         }
 
@@ -111,19 +186,19 @@ namespace graphlab {
             size_t arrpos, bitpos;
             bit_to_pos(idx, arrpos, bitpos);
             if (val) {
-                array[arrpos] = array[arrpos] | sseMasks8[bitpos];
+                array[arrpos] = array[arrpos] | element(1 << bitpos);
             }
             else {
-                array[arrpos] = array[arrpos] & (~sseMasks8[bitpos]);
+                array[arrpos] = array[arrpos] & element(~(1 << bitpos));
             }
         }
 
-        inline void set_element(__mmask8 val, size_t b) {
+        inline void set_element(element val, size_t b) {
             size_t arrpos = b;
             array[arrpos] = val;
         }
 
-        inline void masked_set_element(__mmask8 val, size_t b, __mmask8 mask) {
+        inline void masked_set_element(element val, size_t b, element mask) {
             size_t arrpos = b;
             array[arrpos] = mask & val;
         }
@@ -138,15 +213,36 @@ namespace graphlab {
         bool test_bit(size_t b) const {
             size_t arrpos, bitpos;
             bit_to_pos(b, arrpos, bitpos);
-            return (array[arrpos] & sseMasks8[bitpos]);
+            return (array[arrpos] >> bitpos) & 1;
+        }
+
+        /// Returns the number of lanes set
+        inline size_t count() const {
+            return bits().popcount(words(), num_words());
+        }
+
+        /// Returns true if a lane is set
+        inline bool vec_any() const {
+            return bits().any(words(), num_words());
+        }
+
+        /// Returns true if all the lanes are set
+        inline bool vec_all() const {
+            const size_t full = len / 64;
+            if (!bits().all(words(), full)) return false;
+            if (len % 64 == 0) return true;
+            return words()[full] == (uint64_t(1) << (len % 64)) - 1;
+        }
+
+        /// Returns the lowest lane set, or size() if none
+        inline size_t first_set() const {
+            const size_t i = bits().first_set(words(), num_words());
+            return i < len ? i : len;
         }
 
         /// in-place pairwise Or Operator
         static void pair_op_or(automi_bitvec<bool>& a, const automi_bitvec<bool>& b) {
-            // TODO: optimization?
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = a.array[i] | b.array[i];
-            }
+            bits().bit_or(a.words(), a.words(), b.words(), a.num_words());
         }
 
         inline void vec_op_set(const automi_bitvec<bool>& other, size_t b) {
@@ -156,32 +252,29 @@ namespace graphlab {
 
         inline void vec_op_set_mask(const automi_bitvec<bool>& other, const automi_bitvec<bool>& mask, size_t b) {
             size_t arrpos = b;
-            __mmask8 set_val = other.array[arrpos] & mask.array[arrpos];
+            element set_val = other.array[arrpos] & mask.array[arrpos];
             array[arrpos] = set_val;
         }
 
         inline void vec_op_set(const automi_bitvec<bool>& other) {
-            for (size_t i = 0; i < arrlen; i++) {
-                vec_op_set(other, i);
-            }
+            memcpy(array, other.array, storage_bytes(arrlen));
         }
 
         inline void vec_op_set_mask(const automi_bitvec<bool>& mask, const automi_bitvec<bool>& other) {
-            for (size_t i = 0; i < arrlen; i++) {
-                vec_op_set_mask(other, mask, i);
-            }
+            bits().bit_and(words(), other.words(), mask.words(), num_words());
         }
 
         inline void vec_op_set(const automi_bitvec<bool>& mask, bool val) {
-            __m256i valVec = val ? sseAllOnes256 : sseAllZero256;
-            *reinterpret_cast<__m256i*>(array) = valVec;
+            set_all(val);
         }
 
         inline void vec_op_set_mask(const automi_bitvec<bool>& mask, bool val) {
-            __m256i maskVec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask.array));
-            __m256i valVec = val ? sseAllOnes256 : sseAllZero256;
-
-            *reinterpret_cast<__m256i*>(array) = _mm256_blendv_epi8(*reinterpret_cast<__m256i*>(array), valVec, maskVec);
+            if (val) {
+                bits().bit_or(words(), words(), mask.words(), num_words());
+            }
+            else {
+                bits().bit_andnot(words(), mask.words(), words(), num_words());
+            }
         }
 
         /**
@@ -191,177 +284,232 @@ namespace graphlab {
          */
         inline bool vec_op_or_update(const automi_bitvec<bool>& other, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 prev_val = array[arrpos];
-            // array[arrpos] = _kor_mask8(array[arrpos], other.array[arrpos]);
+            element prev_val = array[arrpos];
             array[arrpos] = array[arrpos] | other.array[arrpos];
-            // __mmask8 cmpor_mask = _kandn_mask8(prev_val, array[arrpos]);
-            __mmask8 cmpor_mask = (~prev_val) & array[arrpos];
+            element cmpor_mask = (~prev_val) & array[arrpos];
             return bool(cmpor_mask);
         }
 
+        /// Returns true if a lane of 'this' is set by `bitwise_or` with 'other'
         inline bool vec_op_or_update(const automi_bitvec<bool>& other) {
-            for (size_t arrpos = 0; arrpos < len; arrpos++) {
-                // array[arrpos] = _kor_mask8(array[arrpos], other.array[arrpos]);
-                array[arrpos] = array[arrpos] | other.array[arrpos];
-                // __mmask8 cmpor_mask = _kandn_mask8(prev_val, array[arrpos]);
-            }
-            return true;
+            return bits().or_update(words(), other.words(), num_words());
         }
 
+        /// Returns true if a lane of 'this' is set by `bitwise_or` with 'other' on the lanes of mask
         inline bool vec_op_or_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<bool>& other) {
-            for (size_t arrpos = 0; arrpos < len; arrpos++) {
-                // array[arrpos] = _kor_mask8(array[arrpos], other.array[arrpos]);
-                __mmask8 masked_val = mask.array[arrpos] & other.array[arrpos];
-                array[arrpos] = array[arrpos] | masked_val;
-                // __mmask8 cmpor_mask = _kandn_mask8(prev_val, array[arrpos]);
-            }
-            return true;
+            return bits().or_update_mask(words(), mask.words(), other.words(), num_words());
         }
 
-        inline bool vec_op_or_update(const automi_bitvec<bool>& other1, const __mmask8& other2, size_t b) {
+        inline bool vec_op_or_update(const automi_bitvec<bool>& other1, const element& other2, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 prev_val = other1.array[arrpos];
-            // array[arrpos] = _kor_mask8(other1.array[arrpos], other2);
-            // __mmask8 cmpor_mask = _kandn_mask8(prev_val, array[arrpos]);
+            element prev_val = other1.array[arrpos];
             array[arrpos] = other1.array[arrpos] | other2;
-            __mmask8 cmpor_mask = (~prev_val) & array[arrpos];
+            element cmpor_mask = (~prev_val) & array[arrpos];
             return bool(cmpor_mask);
         }
 
         inline bool vec_op_or_update(const automi_bitvec<bool>& other1, const automi_bitvec<bool>& other2, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 prev_val = other1.array[arrpos];
+            element prev_val = other1.array[arrpos];
             array[arrpos] = other1.array[arrpos] | other2.array[arrpos];
-            __mmask8 cmpor_mask = (~prev_val) & array[arrpos];
+            element cmpor_mask = (~prev_val) & array[arrpos];
             return bool(cmpor_mask);
         }
 
         inline bool vec_op_or_update_mask(const automi_bitvec<bool>& other, const automi_bitvec<bool>& mask, size_t b) {
             size_t arrpos = b; // THIS IS SPECIAL!
-            __mmask8 tmp_mask = mask.array[arrpos];
+            element tmp_mask = mask.array[arrpos];
             if (!tmp_mask)
                 return false;
-            __mmask8 prev_val = array[arrpos];
-            // __mmask8 other_val = _kand_mask8(tmp_mask, other.array[arrpos]);
-            // array[arrpos] = _kor_mask8(array[arrpos], other_val);
-            // __mmask8 cmpor_mask = _kandn_mask8(prev_val, array[arrpos]);
-            __mmask8 other_val = tmp_mask & other.array[arrpos];
+            element prev_val = array[arrpos];
+            element other_val = tmp_mask & other.array[arrpos];
             array[arrpos] = array[arrpos] | other_val;
-            __mmask8 cmpor_mask = (~prev_val) & array[arrpos];
+            element cmpor_mask = (~prev_val) & array[arrpos];
             return bool(cmpor_mask);
         }
 
-        inline bool vec_op_or_update_mask(const automi_bitvec<bool>& other1, const automi_bitvec<bool>& mask, const __mmask8& other2, size_t b) {
+        inline bool vec_op_or_update_mask(const automi_bitvec<bool>& other1, const automi_bitvec<bool>& mask, const element& other2, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 tmp_mask = mask.array[arrpos];
+            element tmp_mask = mask.array[arrpos];
             if (!tmp_mask)
                 return false;
-            __mmask8 prev_val = other1.array[arrpos];
-            // __mmask8 other_val = _kand_mask8(tmp_mask, other2);
-            // array[arrpos] = _kor_mask8(other1.array[arrpos], other_val);
-            // __mmask8 cmpor_mask = _kandn_mask8(prev_val, array[arrpos]);
-            __mmask8 other_val = tmp_mask & other2;
+            element prev_val = other1.array[arrpos];
+            element other_val = tmp_mask & other2;
             array[arrpos] = other1.array[arrpos] | other_val;
-            __mmask8 cmpor_mask = (~prev_val) & array[arrpos];
+            element cmpor_mask = (~prev_val) & array[arrpos];
             return bool(cmpor_mask);
         }
 
+        /// this = ~other1 & other2
         inline void vec_op_andnot_update(const automi_bitvec<bool>& other1, const automi_bitvec<bool>& other2) {
-            *reinterpret_cast<__m256i*>(array) = _mm256_andnot_epi64(
-                *reinterpret_cast<__m256i*>(other1.array), *reinterpret_cast<__m256i*>(other2.array));
+            bits().bit_andnot(words(), other1.words(), other2.words(), num_words());
         }
 
+        /// this = ~other1 & other2 on the lanes of mask
         inline void vec_op_andnot_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<bool>& other1, const automi_bitvec<bool>& other2) {
-            *reinterpret_cast<__m256i*>(array) = _mm256_mask_andnot_si256(
-                *reinterpret_cast<__m256i*>(mask.array),
-                *reinterpret_cast<__m256i*>(other1.array), *reinterpret_cast<__m256i*>(other2.array));
+            bits().andnot_mask(words(), mask.words(), other1.words(), other2.words(), num_words());
         }
 
         inline bool vec_all_zeros() const {
-            return _mm256_testz_si256(*reinterpret_cast<__m256i*>(array), sseAllOnes256);
+            return !vec_any();
         }
 
         inline void vec_op_negate(automi_bitvec<bool>& ret) {
-            *reinterpret_cast<__m256i*>(ret.array) = _mm256_xor_si256(*reinterpret_cast<__m256i*>(array), sseAllOnes256);
+            bits().bit_not(ret.words(), words(), num_words());
+            ret.clear_tail();
         }
 
         inline void vec_op_negate_mask(const automi_bitvec<bool>& mask, automi_bitvec<bool>& ret) {
-            *reinterpret_cast<__m256i*>(ret.array) = _mm256_and_si256(*reinterpret_cast<__m256i*>(mask.array),_mm256_xor_epi64(*reinterpret_cast<__m256i*>(array), sseAllOnes256));
+            bits().bit_andnot(ret.words(), words(), mask.words(), num_words());
         }
 
-        inline void vec_op_cmpgt_update(const automi_bitvec<int>& other1, const automi_bitvec<int>& other2) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_cmpgt_epi32_mask(other1.array[i], other2.array[i]);
-            }
-        }
+        inline void vec_op_cmpgt_update(const automi_bitvec<int>& other1, const automi_bitvec<int>& other2);
 
-        inline void vec_op_cmpgt_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other1, const automi_bitvec<int>& other2) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_cmpgt_epi32_mask(mask, other1.array[i], other2.array[i]);
-            }
-        }
+        inline void vec_op_cmpgt_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other1, const automi_bitvec<int>& other2);
 
-        inline void vec_op_cmpneq_update(const automi_bitvec<int>& other1, const automi_bitvec<int>& other2) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_cmpneq_epi32_mask(other1.array[i], other2.array[i]);
-            }
-        }
+        inline void vec_op_cmpneq_update(const automi_bitvec<int>& other1, const automi_bitvec<int>& other2);
+
+        /// this = other1 > other2, for the lanes of automi_numeric_bitvec
+        template <typename T>
+        inline void vec_op_cmpgt_update(const automi_numeric_bitvec<T>& other1, const automi_numeric_bitvec<T>& other2);
+
+        template <typename T>
+        inline void vec_op_cmpgt_update_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec<T>& other1, const automi_numeric_bitvec<T>& other2);
+
+        template <typename T>
+        inline void vec_op_cmpneq_update(const automi_numeric_bitvec<T>& other1, const automi_numeric_bitvec<T>& other2);
 
         /// Serializes this bitvec to an archive
         inline void save(oarchive& oarc) const {
             oarc << len << arrlen;
             if (arrlen > 0)
-                serialize(oarc, array, arrlen * sizeof(__mmask8));
+                serialize(oarc, array, arrlen * sizeof(element));
         }
 
         /// Masked Serialization (I don't think masking can save traffic)
         inline void masked_save(oarchive& oarc, const automi_bitvec<bool>& mask) const {
-            oarc << len << arrlen;
-            if (arrlen > 0)
-                serialize(oarc, array, arrlen * sizeof(__mmask8));
+            save(oarc);
         }
 
         /// Deserializes this bitvec from an archive
         inline void load(iarchive& iarc) {
-            // I don't think free-up memory used by array is necessary
-            size_t prev_arrlen = arrlen;
-            iarc >> len >> arrlen;
-            if (arrlen > 0) {
-                if (arrlen != prev_arrlen) {
-                    resize(len);
-                }
-                deserialize(iarc, array, arrlen * sizeof(__mmask8));
-            }
+            size_t new_len, new_arrlen;
+            iarc >> new_len >> new_arrlen;
+            resize(new_len);
+            if (arrlen > 0)
+                deserialize(iarc, array, arrlen * sizeof(element));
         }
 
         /// Masked Serialization (coupled with masked_save)
         inline void masked_load(iarchive& iarc, const automi_bitvec<bool>& mask) {
-            // I don't think free-up memory used by array is necessary
-            size_t prev_arrlen = arrlen;
-            iarc >> len >> arrlen;
-            if (arrlen > 0) {
-                if (arrlen != prev_arrlen) {
-                    resize(len);
-                }
-                deserialize(iarc, array, arrlen * sizeof(__mmask8));
-            }
+            load(iarc);
         }
 
-        __mmask8* array;
+        element* array;
         size_t len;
         size_t arrlen;
     private:
+        friend class automi_bitvec<int>;
+        friend class automi_bitvec<float>;
+        template <typename T> friend class automi_numeric_bitvec;
+        template <typename T> friend class automi_hybridvec;
+
         inline static void bit_to_pos(size_t b, size_t& arrpos, size_t& bitpos) {
             arrpos = b / 8;
             bitpos = b % 8;
         }
+
+        /// Returns the bytes allocated for 'n' blocks, padded to whole words
+        inline static size_t storage_bytes(size_t n) {
+            return (n + 7) / 8 * sizeof(uint64_t);
+        }
+
+        inline static const automi_bit_kernels& bits() {
+            return automi_simd_bits();
+        }
+
+        inline size_t num_words() const {
+            return (arrlen + 7) / 8;
+        }
+
+        inline uint64_t* words() {
+            return reinterpret_cast<uint64_t*>(array);
+        }
+
+        inline const uint64_t* words() const {
+            return reinterpret_cast<const uint64_t*>(array);
+        }
+
+        /// Clears the bits past 'len' in the last word
+        inline void clear_tail() {
+            if (len % 64 != 0) {
+                words()[num_words() - 1] &= (uint64_t(1) << (len % 64)) - 1;
+            }
+        }
     };
 
+    /**
+     * \internal Writes the number k of lanes set in the lane mask 'm' as
+     * a raw size_t, then the values of these lanes of 'array' packed in
+     * lane order.  The lanes are packed with the compress kernel straight
+     * into the buffer of a buffered archive, and the count reserved ahead
+     * of them is patched once k is known, so it is never varint encoded.
+     * 'n' is a multiple of 8.
+     */
+    template <typename T>
+    inline void automi_masked_save_lanes(oarchive& oarc, const uint8_t* m,
+                                         const T* array, size_t n) {
+        const automi_lane_kernels<T>& ops = automi_simd_lanes<T>::get();
+        if (oarc.out == NULL) {
+            // reserve the count, then pack at most n lanes after it
+            const size_t head = oarc.off;
+            oarc.advance(sizeof(size_t));
+            oarc.expand_buf(sizeof(T) * n);
+            if (reinterpret_cast<uintptr_t>(oarc.buf + oarc.off) % sizeof(T) == 0) {
+                const size_t k = ops.compress(reinterpret_cast<T*>(oarc.buf + oarc.off), m, array, n);
+                memcpy(oarc.buf + head, &k, sizeof(size_t));
+                oarc.off += sizeof(T) * k;
+                return;
+            }
+            oarc.off = head;
+        }
+        T* packed = (T*)automi_lane_alloc(sizeof(T) * n);
+        const size_t k = ops.compress(packed, m, array, n);
+        oarc.write(reinterpret_cast<const char*>(&k), sizeof(size_t));
+        if (k > 0) serialize(oarc, packed, sizeof(T) * k);
+        automi_lane_free(packed, sizeof(T) * n);
+    }
+
+    /**
+     * \internal Reads the lanes written by automi_masked_save_lanes into
+     * the lanes of 'array' set in 'm', expanding them straight from the
+     * buffer of a buffered archive.
+     */
+    template <typename T>
+    inline void automi_masked_load_lanes(iarchive& iarc, const uint8_t* m,
+                                         T* array, size_t n) {
+        const automi_lane_kernels<T>& ops = automi_simd_lanes<T>::get();
+        size_t k = 0;
+        iarc.read(reinterpret_cast<char*>(&k), sizeof(size_t));
+        if (k == 0) return;
+        if (iarc.buf != NULL &&
+            reinterpret_cast<uintptr_t>(iarc.buf + iarc.off) % sizeof(T) == 0) {
+            ops.expand(array, m, reinterpret_cast<const T*>(iarc.buf + iarc.off), n);
+            iarc.off += sizeof(T) * k;
+            return;
+        }
+        T* packed = (T*)automi_lane_alloc(sizeof(T) * k);
+        deserialize(iarc, packed, sizeof(T) * k);
+        ops.expand(array, m, packed, n);
+        automi_lane_free(packed, sizeof(T) * k);
+    }
+
     /// specialized <dtype=int> class automi_bitvec
     template<>
     class automi_bitvec<int> {
     public:
-        typedef __m256i element;
+        typedef int element;
+        typedef automi_bitvec<bool>::element mask_element;
         /// Constructs an empty automi_bitvec
         automi_bitvec() : array(NULL), len(0), arrlen(0) {}
 
@@ -379,24 +527,63 @@ namespace graphlab {
             *this = db;
         }
 
+        /// Takes over the lanes of bitvec db, leaving it empty
+        automi_bitvec(automi_bitvec<int>&& db) noexcept : array(db.array), len(db.len), arrlen(db.arrlen) {
+            db.array = NULL;
+            db.len = 0;
+            db.arrlen = 0;
+        }
+
         /// destructor
-        ~automi_bitvec() { free(array); }
+        ~automi_bitvec() { automi_lane_free(array, sizeof(element) * lanes()); }
 
         /// Make a new copy of the bitvec db
         inline automi_bitvec<int>& operator=(const automi_bitvec<int>& db) {
+            if (this == &db) return *this;
             resize(db.size());
-            len = db.len;
-            arrlen = db.arrlen;
-            memcpy(array, db.array, sizeof(__m256i) * arrlen);
+            memcpy(array, db.array, sizeof(element) * lanes());
+            return *this;
+        }
+
+        /**
+         * Swaps the lanes with bitvec db, which releases the old lanes of this
+         * one.  Lanes borrowed from an arena stay with their bitvec, so those
+         * are copied instead.
+         */
+        inline automi_bitvec<int>& operator=(automi_bitvec<int>&& db) {
+            if (borrows_lanes() || db.borrows_lanes()) return *this = db;
+            std::swap(array, db.array);
+            std::swap(len, db.len);
+            std::swap(arrlen, db.arrlen);
             return *this;
         }
 
+        /// Returns the bytes of lane storage, as taken by bind_storage()
+        inline size_t storage_size() const {
+            return sizeof(element) * lanes();
+        }
+
+        /**
+         * Moves the lanes to 'storage', of at least storage_size() bytes in a
+         * registered arena (see automi_lane_arena), which this bitvec then
+         * borrows instead of owning.
+         */
+        inline void bind_storage(void* storage) {
+            if (storage_size() == 0 || storage == array) return;
+            memcpy(storage, array, storage_size());
+            automi_lane_free(array, storage_size());
+            array = reinterpret_cast<element*>(storage);
+        }
+
+        /// Returns true if the lanes are borrowed from an arena
+        inline bool borrows_lanes() const {
+            return array != NULL && automi_lane_in_arena(array);
+        }
+
         /// Overload operator+= for gather function
         inline automi_bitvec<int>& operator+=(const automi_bitvec<int>& other) {
             // assume "other" and "this" has same size
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_add_epi32(array[i], other.array[i]);
-            }
+            ops().add(array, array, other.array, lanes());
             return *this;
         }
 
@@ -407,17 +594,32 @@ namespace graphlab {
         inline void resize(size_t n) {
             len = n;
             size_t prev_arrlen = arrlen;
-            arrlen = n / 8;
-            array = (__m256i*)realloc(array, sizeof(__m256i) * arrlen);
+            arrlen = (n + 7) / 8;
+            array = (element*)automi_lane_realloc(array, sizeof(element) * 8 * prev_arrlen, sizeof(element) * lanes());
             // NOT SURE: set newly allocated memory to 0
             if (arrlen > prev_arrlen) {
-                memset(&array[prev_arrlen], 0, sizeof(__m256i) * (arrlen - prev_arrlen));
+                memset(&array[8 * prev_arrlen], 0, sizeof(element) * 8 * (arrlen - prev_arrlen));
             }
         }
 
         /// Set all memory within bitvec to 0
         inline void clear() {
-            memset(array, 0, sizeof(__m256i) * arrlen);
+            memset(array, 0, sizeof(element) * lanes());
+        }
+
+        /**
+         * Keeps the lanes set in 'keep', moved down to the lowest lanes in
+         * order, and shrinks this bitvec to them.
+         */
+        inline void compact(const automi_bitvec<bool>& keep) {
+            const size_t n = len < keep.len ? len : keep.len;
+            size_t kept = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (keep.test_bit(i)) array[kept++] = array[i];
+            }
+            resize(kept);
+            // the padding lanes of the last block must not hold stale values
+            if (lanes() > kept) memset(array + kept, 0, sizeof(element) * (lanes() - kept));
         }
 
         /// Returns the number of elements in this bitvec
@@ -427,171 +629,110 @@ namespace graphlab {
 
         /// Set all elements value using provided val
         inline void set_all(int val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_set1_epi32(val);
-            }
+            ops().set1(array, val, lanes());
         }
 
         /// Set one lane value using provided val and idx
         inline void set_single(int val, size_t idx) {
-            // size_t arrpos, bitpos;
-            // bit_to_pos(idx, arrpos, bitpos);
-            // array[arrpos] = _mm256_mask_set1_epi32(array[arrpos], sseMasks8[bitpos], val);
-            int *tmp_ptr = (int *)(array);
-            tmp_ptr[idx] = val;
+            array[idx] = val;
         }
 
         /// Set lanes to value `val' using provided mask
         inline void set_mask(automi_bitvec<bool>& m, int val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_set1_epi32(array[i], m.array[i], val);
-            }
-        }
-
-        inline void set_element(__m256i val, size_t b) {
-            size_t arrpos = b;
-            array[arrpos] = val;
-        }
-
-        inline void masked_set_element(__m256i val, size_t b, __mmask8 mask) {
-            size_t arrpos = b;
-            array[arrpos] = _mm256_mask_blend_epi32(mask, array[arrpos], val);
+            ops().blend1(array, m.array, val, lanes());
         }
 
         /// Get one single lane in bitvec element values
         inline int get_single(size_t b) {
-            int *tmp_ptr = (int *)(array);
-            return tmp_ptr[b];
+            return array[b];
         }
 
         /// in-place pairwise Min Operator
         static void pair_op_min(automi_bitvec<int>& a, const automi_bitvec<int>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_min_epi32(a.array[i], b.array[i]);
-            }
+            ops().min(a.array, a.array, b.array, a.lanes());
         }
 
         /// in-place pairwise Max Operator
         static void pair_op_max(automi_bitvec<int>& a, const automi_bitvec<int>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_max_epi32(a.array[i], b.array[i]);
-            }
+            ops().max(a.array, a.array, b.array, a.lanes());
         }
 
         static void pair_op_add(automi_bitvec<int>& a, const automi_bitvec<int>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_add_epi32(a.array[i], b.array[i]);
-            }
+            ops().add(a.array, a.array, b.array, a.lanes());
         }
 
         static void pair_op_mul(automi_bitvec<int>& a, const automi_bitvec<int>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_mul_epi32(a.array[i], b.array[i]);
-            }
+            ops().mul(a.array, a.array, b.array, a.lanes());
         }
 
         inline void vec_op_mul_update(const automi_bitvec<int>& other, int val, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            array[arrpos] = _mm256_mul_epi32(other.array[arrpos], _mm256_set1_epi32(val));
+            ops().mul1(block(arrpos), other.block(arrpos), val, 8);
         }
 
         inline void vec_op_mul_update(const automi_bitvec<int>& other, int val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mul_epi32(other.array[i], _mm256_set1_epi32(val));
-            }
+            ops().mul1(array, other.array, val, lanes());
         }
 
         inline void vec_op_masked_mul_update(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other, int val, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_mul_epi32(array[arrpos], mask.array[arrpos], other.array[arrpos], _mm256_set1_epi32(val));
+            ops().mul1_mask(block(arrpos), &mask.array[arrpos], other.block(arrpos), val, 8);
         }
 
         /// Serializes this bitvec to an archive
         inline void save(oarchive& oarc) const {
             oarc << len << arrlen;
             if (arrlen > 0)
-                serialize(oarc, array, arrlen * sizeof(__m256i));
+                serialize(oarc, array, lanes() * sizeof(element));
         }
 
         /// Deserializes this bitvec from an archive
         inline void load(iarchive& iarc) {
-            // I don't think free-up memory used by array is necessary
-            size_t new_arrlen;
-            iarc >> len >> new_arrlen;
-            if (arrlen > 0) {
-                if (arrlen != new_arrlen) {
-                    resize(len);
-                }
-                deserialize(iarc, array, arrlen * sizeof(__m256i));
-            }
+            size_t new_len, new_arrlen;
+            iarc >> new_len >> new_arrlen;
+            resize(new_len);
+            if (arrlen > 0)
+                deserialize(iarc, array, lanes() * sizeof(element));
         }
 
-        /// Masked Serialization
+        /// Masked Serialization: only the lanes set in mask, which has size() lanes
         inline void masked_save(oarchive& oarc, const automi_bitvec<bool>& mask) const {
-            // TODO: need optimization here!
-            oarc << len << arrlen;
-            int *array_ptr;
-            for (size_t i = 0; i < arrlen; i++) {
-                array_ptr = (int *)&array[i];
-                for (int j = 0; j < 8; j++) {
-                    if ((mask.array[i] >> j) & 1) {
-                        oarc << array_ptr[j];
-                    }
-                }
-            }
+            oarc << len;
+            automi_masked_save_lanes(oarc, mask.array, array, lanes());
         }
 
-        /// Masked Deserialization
+        /// Masked Deserialization (coupled with masked_save), the other lanes are kept
         inline void masked_load(iarchive& iarc, const automi_bitvec<bool>& mask) {
-            // TODO: need optimization here!
-            size_t new_arrlen;
-            iarc >> len >> arrlen;
-            if (arrlen != new_arrlen) {
-                resize(len);
-            }
-            for (size_t i = 0; i < arrlen; i++) {
-                int tmp_val;
-                for (int j = 0; j < 8; j++) {
-                    if ((mask.array[i] >> j) & 1) {
-                        iarc >> tmp_val;
-                        array[i] = _mm256_insert_epi32(array[i], tmp_val, j);
-                    }
-                }
-            }
+            size_t new_len;
+            iarc >> new_len;
+            if (len != new_len) resize(new_len);
+            automi_masked_load_lanes(iarc, mask.array, array, lanes());
         }
 
         inline void vec_op_set(const automi_bitvec<int>& other, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = other.array[arrpos];
+            memcpy(block(arrpos), other.block(arrpos), sizeof(element) * 8);
         }
 
         inline void vec_op_set_mask(const automi_bitvec<int>& other, const automi_bitvec<bool>& mask, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_blend_epi32(mask.array[arrpos], array[arrpos], other.array[arrpos]);
+            ops().blend(block(arrpos), &mask.array[arrpos], other.block(arrpos), 8);
         }
 
         inline void vec_op_set(const automi_bitvec<int>& other) {
-            for (size_t i = 0; i < arrlen; i++) {
-                vec_op_set(other, i);
-            }
+            memcpy(array, other.array, sizeof(element) * lanes());
         }
 
         inline void vec_op_set_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other) {
-            for (size_t i = 0; i < arrlen; i++) {
-                vec_op_set_mask(other, mask, i);
-            }
+            ops().blend(array, mask.array, other.array, lanes());
         }
 
         inline void vec_op_set(const automi_bitvec<bool>& mask, int val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_set1_epi32(val);
-            }
+            ops().set1(array, val, lanes());
         }
 
         inline void vec_op_set_mask(const automi_bitvec<bool>& mask, int val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_set1_epi32(array[i], mask.array[i], 1);
-            }
+            ops().blend1(array, mask.array, val, lanes());
         }
 
         /**
@@ -600,139 +741,131 @@ namespace graphlab {
          */
         inline bool vec_op_cmpgt_update(const automi_bitvec<int>& other, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 cmpgt_mask = _mm256_cmpgt_epi32_mask(array[arrpos], other.array[arrpos]);
-            array[arrpos] = _mm256_min_epi32(array[arrpos], other.array[arrpos]);
-            return bool(cmpgt_mask);    // Does this work?
+            return ops().min_gt(block(arrpos), NULL, other.block(arrpos), 8);
         }
 
         inline bool vec_op_masked_cmpgt_update(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 cmpgt_mask = _mm256_cmpgt_epi32_mask(array[arrpos], other.array[arrpos]);
+            mask_element cmpgt_mask;
+            ops().cmpgt(&cmpgt_mask, block(arrpos), other.block(arrpos), 8);
             cmpgt_mask = cmpgt_mask & mask.array[arrpos];
-            array[arrpos] = _mm256_mask_min_epi32(array[arrpos], cmpgt_mask, array[arrpos], other.array[arrpos]);
-            return bool(cmpgt_mask); // Does this work?
-        }
-
-        inline bool vec_op_masked_cmpgt_update(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other1, const __m256i& other2, size_t b) {
-            size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 cmpgt_mask = _mm256_cmpgt_epi32_mask(other1.array[arrpos], other2);
-            cmpgt_mask = cmpgt_mask & mask.array[arrpos];
-            array[arrpos] = _mm256_mask_min_epi32(array[arrpos], cmpgt_mask, other1.array[arrpos], other2);
-            return bool(cmpgt_mask); // Does this work?
-        }
-
-        inline bool vec_op_cmplt_update(const automi_bitvec<int>& other, size_t b) {
-            size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 cmplt_mask = _mm256_cmplt_epi32_mask(array[arrpos], other.array[arrpos]);
-            array[arrpos] = _mm256_max_epi32(array[arrpos], other.array[arrpos]);
-            return bool(cmplt_mask);    // Does this work?
-        }
-
-        inline bool vec_op_cmpgt_update(const automi_bitvec<int>& other1, const __m256i& other2, size_t b) {
-            size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 cmpgt_mask = _mm256_cmpgt_epi32_mask(other1.array[arrpos], other2);
-            array[arrpos] = _mm256_min_epi32(other1.array[arrpos], other2);
+            ops().blend(block(arrpos), &cmpgt_mask, other.block(arrpos), 8);
             return bool(cmpgt_mask);
         }
 
-        inline bool vec_op_cmplt_update(const automi_bitvec<int>& other1, const __m256i& other2, size_t b) {
+        inline bool vec_op_cmplt_update(const automi_bitvec<int>& other, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 cmpgt_mask = _mm256_cmplt_epi32_mask(other1.array[arrpos], other2);
-            array[arrpos] = _mm256_max_epi32(other1.array[arrpos], other2);
-            return bool(cmpgt_mask);
+            return ops().max_lt(block(arrpos), NULL, other.block(arrpos), 8);
         }
 
         // TODO: Mask operator also have push and pull stle?
         inline bool vec_op_cmpgt_update_mask(const automi_bitvec<int>& other, automi_bitvec<bool>& mask, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 tmp_mask = _mm256_cmpgt_epi32_mask(array[arrpos], other.array[arrpos]);
-            array[arrpos] = _mm256_min_epi32(array[arrpos], other.array[arrpos]);   // TODO: should we add mask here?
-            // mask.array[arrpos] = mask.array[arrpos] | tmp_mask;
-            mask.array[arrpos] = tmp_mask;
-            return bool(tmp_mask);
+            return ops().min_gt(block(arrpos), &mask.array[arrpos], other.block(arrpos), 8);
         }
 
         inline bool vec_op_cmplt_update_mask(const automi_bitvec<int>& other, automi_bitvec<bool>& mask, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            __mmask8 tmp_mask = _mm256_cmplt_epi32_mask(array[arrpos], other.array[arrpos]);
-            array[arrpos] = _mm256_max_epi32(array[arrpos], other.array[arrpos]);   // TODO: should we add mask here?
-            // mask.array[arrpos] = mask.array[arrpos] | tmp_mask;
-            mask.array[arrpos] = tmp_mask;
-            return bool(tmp_mask);
-        }
-
-        // inline bool vec_op_cmpgt_update_mask(const automi_bitvec<int>& other1, const __m256i& other2, automi_bitvec<bool>& mask, size_t b) {
-        //     size_t arrpos = b;  // THIS IS SPECIAL!
-        //     __mmask8 cmpgt_mask = _mm256_cmpgt_epi32_mask(other1.array[arrpos], other2);
-        //     array[arrpos] = _mm256_min_epi32(other1.array[arrpos], other2); // TODO: should we add mask here?
-        //     mask.array[arrpos] = mask.array[arrpos] | cmpgt_mask;
-        //     return bool(cmpgt_mask);
-        // }
-
-        inline void vec_op_masked_add_update(__mmask8 mask, int val, size_t b) {
+            return ops().max_lt(block(arrpos), &mask.array[arrpos], other.block(arrpos), 8);
+        }
+
+        inline void vec_op_masked_add_update(mask_element mask, int val, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_add_epi32(array[arrpos], mask, 
-                array[arrpos], _mm256_set1_epi32(val));
+            ops().add1_mask(block(arrpos), &mask, block(arrpos), val, 8);
         }
 
         inline void vec_op_masked_add_update(const automi_bitvec<bool>& mask, int val, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_add_epi32(array[arrpos], mask.array[arrpos], array[arrpos], _mm256_set1_epi32(val));
+            ops().add1_mask(block(arrpos), &mask.array[arrpos], block(arrpos), val, 8);
         }
 
         inline void vec_op_masked_add_update(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_add_epi32(array[arrpos], mask.array[arrpos], array[arrpos], other.array[arrpos]);
+            ops().add_mask(block(arrpos), &mask.array[arrpos], block(arrpos), other.block(arrpos), 8);
         }
 
         inline void vec_op_add_update(const automi_bitvec<int>& other, int val, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_add_epi32(other.array[arrpos], _mm256_set1_epi32(val));
+            ops().add1(block(arrpos), other.block(arrpos), val, 8);
         }
 
         inline void vec_op_add_update(const automi_bitvec<int>& other1, const automi_bitvec<int>& other2, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_add_epi32(other1.array[arrpos], other2.array[arrpos]);
+            ops().add(block(arrpos), other1.block(arrpos), other2.block(arrpos), 8);
         }
 
         inline void vec_op_add_update(const automi_bitvec<int>& other, int val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_add_epi32(other.array[i], _mm256_set1_epi32(val));
-            }
+            ops().add1(array, other.array, val, lanes());
         }
 
         inline void vec_op_add_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other, int val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_add_epi32(array[i], mask.array[i], array[i], _mm256_set1_epi32(val));
-            }
+            ops().add1_mask(array, mask.array, other.array, val, lanes());
         }
 
         inline void vec_op_add_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other1, const automi_bitvec<int>& other2) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_add_epi32(array[i], mask.array[i], other1.array[i], other2.array[i]);
-            }
+            ops().add_mask(array, mask.array, other1.array, other2.array, lanes());
+        }
+
+        /// this = min(this, other + val), without a temporary
+        inline void vec_op_add_min_update(const automi_bitvec<int>& other, int val) {
+            ops().add1_min(array, other.array, val, lanes());
+        }
+
+        /// this = min(this, other + val) on the lanes of mask, without a temporary
+        inline void vec_op_add_min_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other, int val) {
+            ops().add1_min_mask(array, mask.array, other.array, val, lanes());
         }
 
         /**
-         * Return 
+         * this = min(this, other), setting 'changed' to the lanes which
+         * decreased, in one pass.  Returns true if one did.
          */
-        element vec_op_add_val(size_t b, int val) const {
-            size_t arrpos = b;
-            return _mm256_add_epi32(array[arrpos], _mm256_set1_epi32(val));
+        inline bool vec_op_min_update(const automi_bitvec<int>& other, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            const bool any = ops().min_gt(array, changed.array, other.array, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
         }
 
         /**
-         * Return 
+         * this = min(this, other) on the lanes of mask, adding the lanes
+         * which decreased to 'changed', in one pass.  Returns true if one did.
          */
-        element vec_op_min_val(size_t b, int val) const {
-            size_t arrpos = b;
-            return _mm256_min_epi32(array[arrpos], _mm256_set1_epi32(val));
+        inline bool vec_op_min_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            return ops().min_gt_mask(array, mask.array, changed.array, other.array, lanes());
         }
 
-        __m256i* array;
+        /**
+         * this = min(this, other + val), setting 'changed' to the lanes
+         * which decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_add_min_update(const automi_bitvec<int>& other, int val, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            const bool any = ops().add1_min_gt(array, changed.array, other.array, val, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        element* array;
         size_t len;
         size_t arrlen;
     private:
+        friend class automi_bitvec<bool>;
+        friend class automi_bitvec<float>;
+
+        /// The kernels of the selected SIMD backend
+        inline static const automi_lane_kernels<element>& ops() {
+            return automi_simd_lanes<element>::get();
+        }
+
+        /// The number of allocated lanes, a multiple of 8
+        inline size_t lanes() const { return 8 * arrlen; }
+
+        /// The first lane of block 'b'
+        inline element* block(size_t b) { return array + 8 * b; }
+        inline const element* block(size_t b) const { return array + 8 * b; }
+
         inline static void bit_to_pos(size_t b, size_t& arrpos, size_t& bitpos) {
             arrpos = b / 8;
             bitpos = b % 8;
@@ -744,7 +877,7 @@ namespace graphlab {
     template<>
     class automi_bitvec<float> {
     public:
-        typedef __m256 element;
+        typedef float element;
         /// Constructs an empty automi_bitvec
         automi_bitvec() : array(NULL), len(0), arrlen(0) {}
 
@@ -762,24 +895,63 @@ namespace graphlab {
             *this = db;
         }
 
+        /// Takes over the lanes of bitvec db, leaving it empty
+        automi_bitvec(automi_bitvec<float>&& db) noexcept : array(db.array), len(db.len), arrlen(db.arrlen) {
+            db.array = NULL;
+            db.len = 0;
+            db.arrlen = 0;
+        }
+
         /// destructor
-        ~automi_bitvec() { free(array); }
+        ~automi_bitvec() { automi_lane_free(array, sizeof(element) * lanes()); }
 
         /// Make a new copy of the bitvec db
         inline automi_bitvec<float>& operator=(const automi_bitvec<float>& db) {
+            if (this == &db) return *this;
             resize(db.size());
-            len = db.len;
-            arrlen = db.arrlen;
-            memcpy(array, db.array, sizeof(__m256) * arrlen);
+            memcpy(array, db.array, sizeof(element) * lanes());
+            return *this;
+        }
+
+        /**
+         * Swaps the lanes with bitvec db, which releases the old lanes of this
+         * one.  Lanes borrowed from an arena stay with their bitvec, so those
+         * are copied instead.
+         */
+        inline automi_bitvec<float>& operator=(automi_bitvec<float>&& db) {
+            if (borrows_lanes() || db.borrows_lanes()) return *this = db;
+            std::swap(array, db.array);
+            std::swap(len, db.len);
+            std::swap(arrlen, db.arrlen);
             return *this;
         }
 
+        /// Returns the bytes of lane storage, as taken by bind_storage()
+        inline size_t storage_size() const {
+            return sizeof(element) * lanes();
+        }
+
+        /**
+         * Moves the lanes to 'storage', of at least storage_size() bytes in a
+         * registered arena (see automi_lane_arena), which this bitvec then
+         * borrows instead of owning.
+         */
+        inline void bind_storage(void* storage) {
+            if (storage_size() == 0 || storage == array) return;
+            memcpy(storage, array, storage_size());
+            automi_lane_free(array, storage_size());
+            array = reinterpret_cast<element*>(storage);
+        }
+
+        /// Returns true if the lanes are borrowed from an arena
+        inline bool borrows_lanes() const {
+            return array != NULL && automi_lane_in_arena(array);
+        }
+
         /// Overload operator+= for gather function
         inline automi_bitvec<float>& operator+=(const automi_bitvec<float>& other) {
             // assume "other" and "this" has same size
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_add_ps(array[i], other.array[i]);
-            }
+            ops().add(array, array, other.array, lanes());
             return *this;
         }
 
@@ -790,17 +962,32 @@ namespace graphlab {
         inline void resize(size_t n) {
             len = n;
             size_t prev_arrlen = arrlen;
-            arrlen = n / 8;
-            array = (__m256*)realloc(array, sizeof(__m256) * arrlen);
+            arrlen = (n + 7) / 8;
+            array = (element*)automi_lane_realloc(array, sizeof(element) * 8 * prev_arrlen, sizeof(element) * lanes());
             // NOT SURE: set newly allocated memory to 0
             if (arrlen > prev_arrlen) {
-                memset(&array[prev_arrlen], 0, sizeof(__m256) * (arrlen - prev_arrlen));
+                memset(&array[8 * prev_arrlen], 0, sizeof(element) * 8 * (arrlen - prev_arrlen));
             }
         }
 
         /// Set all memory within bitvec to 0
         inline void clear() {
-            memset(array, 0, sizeof(__m256) * arrlen);
+            memset(array, 0, sizeof(element) * lanes());
+        }
+
+        /**
+         * Keeps the lanes set in 'keep', moved down to the lowest lanes in
+         * order, and shrinks this bitvec to them.
+         */
+        inline void compact(const automi_bitvec<bool>& keep) {
+            const size_t n = len < keep.len ? len : keep.len;
+            size_t kept = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (keep.test_bit(i)) array[kept++] = array[i];
+            }
+            resize(kept);
+            // the padding lanes of the last block must not hold stale values
+            if (lanes() > kept) memset(array + kept, 0, sizeof(element) * (lanes() - kept));
         }
 
         /// Returns the number of elements in this bitvec
@@ -810,272 +997,705 @@ namespace graphlab {
 
         /// Set all elements value using provided val
         inline void set_all(float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_set1_ps(val);
-            }
+            ops().set1(array, val, lanes());
         }
 
         /// Set one lane value using provided val and idx
         inline void set_single(float val, size_t idx) {
-            // size_t arrpos, bitpos;
-            // bit_to_pos(idx, arrpos, bitpos);
-            // array[arrpos] = _mm256_mask_set1_epi32(array[arrpos], sseMasks8[bitpos], val);
-            float *tmp_ptr = (float *)(array);
-            tmp_ptr[idx] = val;
+            array[idx] = val;
         }
 
         /// Set lanes to value `val' using provided mask
         inline void set_mask(automi_bitvec<bool>& m, float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_or_ps(array[i], m.array[i],
-                    sseAllZeroPS256, _mm256_set1_ps(val));
-            }
-        }
-
-        inline void set_element(__m256 val, size_t b) {
-            size_t arrpos = b;
-            array[arrpos] = val;
-        }
-
-        inline void masked_set_element(__m256 val, size_t b, __mmask8 mask) {
-            size_t arrpos = b;
-            array[arrpos] = _mm256_mask_blend_ps(mask, array[arrpos], val);
+            ops().blend1(array, m.array, val, lanes());
         }
 
         /// Get one single lane in bitvec element values
         inline float get_single(size_t b) {
-            float *tmp_ptr = (float *)(array);
-            return tmp_ptr[b];
+            return array[b];
         }
 
         /// in-place pairwise Min Operator
         static void pair_op_min(automi_bitvec<float>& a, const automi_bitvec<float>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_min_ps(a.array[i], b.array[i]);
-            }
+            ops().min(a.array, a.array, b.array, a.lanes());
         }
 
         /// in-place pairwise Max Operator
         static void pair_op_max(automi_bitvec<float>& a, const automi_bitvec<float>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_max_ps(a.array[i], b.array[i]);
-            }
+            ops().max(a.array, a.array, b.array, a.lanes());
         }
 
         static void pair_op_add(automi_bitvec<float>& a, const automi_bitvec<float>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_add_ps(a.array[i], b.array[i]);
-            }
+            ops().add(a.array, a.array, b.array, a.lanes());
         }
 
         static void pair_op_mul(automi_bitvec<float>& a, const automi_bitvec<float>& b) {
-            for (size_t i = 0; i < a.arrlen; i++) {
-                a.array[i] = _mm256_mul_ps(a.array[i], b.array[i]);
-            }
+            ops().mul(a.array, a.array, b.array, a.lanes());
         }
 
         /// Serializes this bitvec to an archive
         inline void save(oarchive& oarc) const {
             oarc << len << arrlen;
             if (arrlen > 0)
-                serialize(oarc, array, arrlen * sizeof(__m256));
+                serialize(oarc, array, lanes() * sizeof(element));
         }
 
         /// Deserializes this bitvec from an archive
         inline void load(iarchive& iarc) {
-            // I don't think free-up memory used by array is necessary
-            size_t new_arrlen;
-            iarc >> len >> new_arrlen;
-            if (arrlen > 0) {
-                if (arrlen != new_arrlen) {
-                    resize(len);
-                }
-                deserialize(iarc, array, arrlen * sizeof(__m256));
-            }
+            size_t new_len, new_arrlen;
+            iarc >> new_len >> new_arrlen;
+            resize(new_len);
+            if (arrlen > 0)
+                deserialize(iarc, array, lanes() * sizeof(element));
         }
 
-        /// Masked Serialization
+        /// Masked Serialization: only the lanes set in mask, which has size() lanes
         inline void masked_save(oarchive& oarc, const automi_bitvec<bool>& mask) const {
-            // TODO: need optimization here!
-            oarc << len << arrlen;
-            float *array_ptr;
-            for (size_t i = 0; i < arrlen; i++) {
-                array_ptr = (float *)&array[i];
-                for (int j = 0; j < 8; j++) {
-                    if ((mask.array[i] >> j) & 1) {
-                        oarc << array_ptr[j];
-                    }
-                }
-            }
+            oarc << len;
+            automi_masked_save_lanes(oarc, mask.array, array, lanes());
         }
 
-        /// Masked Deserialization
+        /// Masked Deserialization (coupled with masked_save), the other lanes are kept
         inline void masked_load(iarchive& iarc, const automi_bitvec<bool>& mask) {
-            // TODO: need optimization here!
-            size_t new_arrlen;
-            iarc >> len >> arrlen;
-            if (arrlen != new_arrlen) {
-                resize(len);
-            }
-            float *array_ptr;
-            for (size_t i = 0; i < arrlen; i++) {
-                array_ptr = (float *)&array[i];
-                float tmp_val;
-                for (int j = 0; j < 8; j++) {
-                    if ((mask.array[i] >> j) & 1) {
-                        iarc >> tmp_val;
-                        array_ptr[j] = tmp_val;
-                    }
-                }
-            }
+            size_t new_len;
+            iarc >> new_len;
+            if (len != new_len) resize(new_len);
+            automi_masked_load_lanes(iarc, mask.array, array, lanes());
         }
 
         inline void vec_op_set(const automi_bitvec<float>& other, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = other.array[arrpos];
+            memcpy(block(arrpos), other.block(arrpos), sizeof(element) * 8);
         }
 
         // TODO: rename operators, put `masked` after `vec_op` to differentiate with `mask`
 
         inline void vec_op_set_mask(const automi_bitvec<float>& other, const automi_bitvec<bool>& mask, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_blend_ps(mask.array[arrpos], array[arrpos], other.array[arrpos]);
+            ops().blend(block(arrpos), &mask.array[arrpos], other.block(arrpos), 8);
         }
 
         inline void vec_op_set(const automi_bitvec<float>& other) {
-            for (size_t i = 0; i < arrlen; i++) {
-                vec_op_set(other, i);
-            }
+            memcpy(array, other.array, sizeof(element) * lanes());
         }
 
         inline void vec_op_set_mask(const automi_bitvec<bool>& mask, const automi_bitvec<float>& other) {
-            for (size_t i = 0; i < arrlen; i++) {
-                vec_op_set_mask(other, mask, i);
-            }
+            ops().blend(array, mask.array, other.array, lanes());
         }
 
         inline void vec_op_set(float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_set1_ps(val);
-            }
+            ops().set1(array, val, lanes());
         }
 
         inline void vec_op_set_mask(const automi_bitvec<bool>& mask, float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_blend_ps(array[i], mask.array[i], _mm256_set1_ps(val));
-            }
+            ops().blend1(array, mask.array, val, lanes());
         }
 
         inline void vec_op_div_update(const automi_bitvec<float>& other, float val, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            array[arrpos] = _mm256_div_ps(other.array[arrpos], _mm256_set1_ps(val));
+            ops().div1(block(arrpos), other.block(arrpos), val, 8);
         }
 
         inline void vec_op_div_update(const automi_bitvec<float>& other, float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_div_ps(other.array[i], _mm256_set1_ps(val));
-            }
+            ops().div1(array, other.array, val, lanes());
         }
 
         inline void vec_op_div_update(const automi_bitvec<float>& other1, const automi_bitvec<float>& other2, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            array[arrpos] = _mm256_div_ps(other1.array[arrpos], other2.array[arrpos]);
+            ops().div(block(arrpos), other1.block(arrpos), other2.block(arrpos), 8);
         }
 
         inline void vec_op_masked_div_update(const automi_bitvec<bool>& mask, const automi_bitvec<float>& other, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_div_ps(array[arrpos], mask.array[arrpos], array[arrpos], other.array[arrpos]);
+            ops().div_mask(block(arrpos), &mask.array[arrpos], other.block(arrpos), 8);
         }
 
         inline void vec_op_mul_update(const automi_bitvec<float>& other, float val, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            array[arrpos] = _mm256_mul_ps(other.array[arrpos], _mm256_set1_ps(val));
+            ops().mul1(block(arrpos), other.block(arrpos), val, 8);
         }
 
         inline void vec_op_mul_update(const automi_bitvec<float>& other, float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mul_ps(other.array[i], _mm256_set1_ps(val));
-            }
+            ops().mul1(array, other.array, val, lanes());
         }
 
         inline void vec_op_mul_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<float>& other, float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_mul_ps(array[i], mask.array[i], other.array[i], _mm256_set1_ps(val));
-            }
+            ops().mul1_mask(array, mask.array, other.array, val, lanes());
         }
 
         inline void vec_op_masked_mul_update(const automi_bitvec<bool>& mask, const automi_bitvec<float>& other, float val, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_mul_ps(array[arrpos], mask.array[arrpos], other.array[arrpos], _mm256_set1_ps(val));
+            ops().mul1_mask(block(arrpos), &mask.array[arrpos], other.block(arrpos), val, 8);
         }
 
         inline void vec_op_mul_val_update(float val, size_t b) {
             size_t arrpos = b;  // THIS IS SPECIAL!
-            array[arrpos] = _mm256_mul_ps(array[arrpos], _mm256_set1_ps(val));
+            ops().mul1(block(arrpos), block(arrpos), val, 8);
         }
 
         inline void vec_op_masked_add_update(const automi_bitvec<bool>& mask, float val, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_add_ps(array[arrpos], mask.array[arrpos], array[arrpos], _mm256_set1_ps(val));
+            ops().add1_mask(block(arrpos), &mask.array[arrpos], block(arrpos), val, 8);
         }
 
         inline void vec_op_masked_add_update(const automi_bitvec<bool>& mask, const automi_bitvec<float>& other, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_mask_add_ps(array[arrpos], mask.array[arrpos], array[arrpos], other.array[arrpos]);
-        }
-
-        inline void vec_op_add_update(element val, size_t b) {
-            size_t arrpos = b;  // THIS IS SPECIAL!
-            array[arrpos] = _mm256_add_ps(array[arrpos], val);
+            ops().add_mask(block(arrpos), &mask.array[arrpos], block(arrpos), other.block(arrpos), 8);
         }
 
         inline void vec_op_add_update(const automi_bitvec<float>& other, size_t b) {
             size_t arrpos = b;
-            array[arrpos] = _mm256_add_ps(array[arrpos], other.array[arrpos]);
+            ops().add(block(arrpos), block(arrpos), other.block(arrpos), 8);
         }
 
         inline void vec_op_add_update_mask(const automi_bitvec<bool>& mask, float val) {
-            for (size_t i = 0; i < arrlen; i++) {
-                array[i] = _mm256_mask_add_ps(array[i], mask.array[i], array[i], _mm256_set1_ps(val));
-            }
+            ops().add1_mask(array, mask.array, array, val, lanes());
         }
 
-        inline void vec_op_add_update(const automi_bitvec<int>& other, size_t b) {
-            size_t arrpos = b;
-            array[arrpos] = _mm256_add_ps(array[arrpos], _mm256_cvtepi32_ps(other.array[arrpos]));
+        /// this = min(this, other + val), without a temporary
+        inline void vec_op_add_min_update(const automi_bitvec<float>& other, float val) {
+            ops().add1_min(array, other.array, val, lanes());
         }
 
-        inline void vec_op_add_update(const automi_bitvec<bool>& other, size_t b) {
-            size_t arrpos = b;
-            array[arrpos] = _mm256_add_ps(array[arrpos], _mm256_set1_ps(other.array[arrpos]));
+        /// this = min(this, other + val) on the lanes of mask, without a temporary
+        inline void vec_op_add_min_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<float>& other, float val) {
+            ops().add1_min_mask(array, mask.array, other.array, val, lanes());
         }
 
         /**
-         * Return 
+         * this = min(this, other), setting 'changed' to the lanes which
+         * decreased, in one pass.  Returns true if one did.
          */
-        element vec_op_add_val(size_t b, float val) const {
-            size_t arrpos = b;
-            return _mm256_add_ps(array[arrpos], _mm256_set1_ps(val));
+        inline bool vec_op_min_update(const automi_bitvec<float>& other, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            const bool any = ops().min_gt(array, changed.array, other.array, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
         }
 
         /**
-         * Return 
+         * this = min(this, other) on the lanes of mask, adding the lanes
+         * which decreased to 'changed', in one pass.  Returns true if one did.
          */
-        element vec_op_min_val(size_t b, float val) const {
+        inline bool vec_op_min_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<float>& other, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            return ops().min_gt_mask(array, mask.array, changed.array, other.array, lanes());
+        }
+
+        /**
+         * this = min(this, other + val), setting 'changed' to the lanes
+         * which decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_add_min_update(const automi_bitvec<float>& other, float val, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            const bool any = ops().add1_min_gt(array, changed.array, other.array, val, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        inline void vec_op_add_update(const automi_bitvec<int>& other, size_t b) {
             size_t arrpos = b;
-            return _mm256_min_ps(array[arrpos], _mm256_set1_ps(val));
+            for (size_t i = 8 * arrpos; i < 8 * arrpos + 8; i++) {
+                array[i] += float(other.array[i]);
+            }
         }
 
-        __m256* array;
+        inline void vec_op_add_update(const automi_bitvec<bool>& other, size_t b) {
+            size_t arrpos = b;
+            ops().add1(block(arrpos), block(arrpos), float(other.array[arrpos]), 8);
+        }
+
+        element* array;
         size_t len;
         size_t arrlen;
     private:
+        /// The kernels of the selected SIMD backend
+        inline static const automi_lane_kernels<element>& ops() {
+            return automi_simd_lanes<element>::get();
+        }
+
+        /// The number of allocated lanes, a multiple of 8
+        inline size_t lanes() const { return 8 * arrlen; }
+
+        /// The first lane of block 'b'
+        inline element* block(size_t b) { return array + 8 * b; }
+        inline const element* block(size_t b) const { return array + 8 * b; }
+
         inline static void bit_to_pos(size_t b, size_t& arrpos, size_t& bitpos) {
             arrpos = b / 8;
             bitpos = b % 8;
         }
     };
 
+
+    /**
+     * Lane vector of numeric lanes of type T, the body shared by the
+     * automi_bitvec specializations of the narrow (int16_t, uint8_t) and
+     * 64-bit (int64_t, double) lane types.  It has the operators of
+     * automi_bitvec<int>, plus the division operators of
+     * automi_bitvec<float> for floating point T.
+     *
+     * Lanes run on the kernels of automi_simd_lanes<T>, so each
+     * register holds 16 (int16_t), 32 (uint8_t) or 4 (int64_t, double)
+     * lanes on AVX2.  The add of the narrow integer lanes saturates.
+     */
+    template <typename T>
+    class automi_numeric_bitvec {
+    public:
+        typedef T element;
+        typedef automi_bitvec<bool>::element mask_element;
+        /// Constructs an empty automi_numeric_bitvec
+        automi_numeric_bitvec() : array(NULL), len(0), arrlen(0) {}
+
+        /// Constructs a bitvec with 'size' elements. All elements are 0.
+        explicit automi_numeric_bitvec(size_t size) : array(NULL), len(0), arrlen(0) {
+            resize(size);
+            clear();
+        }
+
+        /// Construct a copy of bitvec db
+        automi_numeric_bitvec(const automi_numeric_bitvec& db) : array(NULL), len(0), arrlen(0) {
+            *this = db;
+        }
+
+        /// Takes over the lanes of bitvec db, leaving it empty
+        automi_numeric_bitvec(automi_numeric_bitvec&& db) noexcept : array(db.array), len(db.len), arrlen(db.arrlen) {
+            db.array = NULL;
+            db.len = 0;
+            db.arrlen = 0;
+        }
+
+        /// destructor
+        ~automi_numeric_bitvec() { automi_lane_free(array, sizeof(element) * lanes()); }
+
+        /// Make a new copy of the bitvec db
+        inline automi_numeric_bitvec& operator=(const automi_numeric_bitvec& db) {
+            if (this == &db) return *this;
+            resize(db.size());
+            memcpy(array, db.array, sizeof(element) * lanes());
+            return *this;
+        }
+
+        /**
+         * Swaps the lanes with bitvec db, which releases the old lanes of this
+         * one.  Lanes borrowed from an arena stay with their bitvec, so those
+         * are copied instead.
+         */
+        inline automi_numeric_bitvec& operator=(automi_numeric_bitvec&& db) {
+            if (borrows_lanes() || db.borrows_lanes()) return *this = db;
+            std::swap(array, db.array);
+            std::swap(len, db.len);
+            std::swap(arrlen, db.arrlen);
+            return *this;
+        }
+
+        /// Returns the bytes of lane storage, as taken by bind_storage()
+        inline size_t storage_size() const {
+            return sizeof(element) * lanes();
+        }
+
+        /**
+         * Moves the lanes to 'storage', of at least storage_size() bytes in a
+         * registered arena (see automi_lane_arena), which this bitvec then
+         * borrows instead of owning.
+         */
+        inline void bind_storage(void* storage) {
+            if (storage_size() == 0 || storage == array) return;
+            memcpy(storage, array, storage_size());
+            automi_lane_free(array, storage_size());
+            array = reinterpret_cast<element*>(storage);
+        }
+
+        /// Returns true if the lanes are borrowed from an arena
+        inline bool borrows_lanes() const {
+            return array != NULL && automi_lane_in_arena(array);
+        }
+
+        /// Overload operator+= for gather function
+        inline automi_numeric_bitvec& operator+=(const automi_numeric_bitvec& other) {
+            // assume "other" and "this" has same size
+            ops().add(array, array, other.array, lanes());
+            return *this;
+        }
+
+        /**
+         * If new size 'n' is larger than 'len', reallocate memory and set to 0;
+         * if new size 'n' is smaller than 'len', leave 'deleted' memory unattended.
+         */
+        inline void resize(size_t n) {
+            len = n;
+            size_t prev_arrlen = arrlen;
+            arrlen = (n + 7) / 8;
+            array = (element*)automi_lane_realloc(array, sizeof(element) * 8 * prev_arrlen, sizeof(element) * lanes());
+            if (arrlen > prev_arrlen) {
+                memset(&array[8 * prev_arrlen], 0, sizeof(element) * 8 * (arrlen - prev_arrlen));
+            }
+        }
+
+        /// Set all memory within bitvec to 0
+        inline void clear() {
+            memset(array, 0, sizeof(element) * lanes());
+        }
+
+        /**
+         * Keeps the lanes set in 'keep', moved down to the lowest lanes in
+         * order, and shrinks this bitvec to them.
+         */
+        inline void compact(const automi_bitvec<bool>& keep) {
+            const size_t n = len < keep.len ? len : keep.len;
+            size_t kept = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (keep.test_bit(i)) array[kept++] = array[i];
+            }
+            resize(kept);
+            // the padding lanes of the last block must not hold stale values
+            if (lanes() > kept) memset(array + kept, 0, sizeof(element) * (lanes() - kept));
+        }
+
+        /// Returns the number of elements in this bitvec
+        inline size_t size() const {
+            return len;
+        }
+
+        /// Set all elements value using provided val
+        inline void set_all(T val) {
+            ops().set1(array, val, lanes());
+        }
+
+        /// Set one lane value using provided val and idx
+        inline void set_single(T val, size_t idx) {
+            array[idx] = val;
+        }
+
+        /// Set lanes to value `val' using provided mask
+        inline void set_mask(const automi_bitvec<bool>& m, T val) {
+            ops().blend1(array, m.array, val, lanes());
+        }
+
+        /// Get one single lane in bitvec element values
+        inline T get_single(size_t b) const {
+            return array[b];
+        }
+
+        /// in-place pairwise Min Operator
+        static void pair_op_min(automi_numeric_bitvec& a, const automi_numeric_bitvec& b) {
+            ops().min(a.array, a.array, b.array, a.lanes());
+        }
+
+        /// in-place pairwise Max Operator
+        static void pair_op_max(automi_numeric_bitvec& a, const automi_numeric_bitvec& b) {
+            ops().max(a.array, a.array, b.array, a.lanes());
+        }
+
+        static void pair_op_add(automi_numeric_bitvec& a, const automi_numeric_bitvec& b) {
+            ops().add(a.array, a.array, b.array, a.lanes());
+        }
+
+        static void pair_op_mul(automi_numeric_bitvec& a, const automi_numeric_bitvec& b) {
+            ops().mul(a.array, a.array, b.array, a.lanes());
+        }
+
+        /// Serializes this bitvec to an archive
+        inline void save(oarchive& oarc) const {
+            oarc << len << arrlen;
+            if (arrlen > 0)
+                serialize(oarc, array, lanes() * sizeof(element));
+        }
+
+        /// Deserializes this bitvec from an archive
+        inline void load(iarchive& iarc) {
+            size_t new_len, new_arrlen;
+            iarc >> new_len >> new_arrlen;
+            resize(new_len);
+            if (arrlen > 0)
+                deserialize(iarc, array, lanes() * sizeof(element));
+        }
+
+        /// Masked Serialization: only the lanes set in mask, which has size() lanes
+        inline void masked_save(oarchive& oarc, const automi_bitvec<bool>& mask) const {
+            oarc << len;
+            automi_masked_save_lanes(oarc, mask.array, array, lanes());
+        }
+
+        /// Masked Deserialization (coupled with masked_save), the other lanes are kept
+        inline void masked_load(iarchive& iarc, const automi_bitvec<bool>& mask) {
+            size_t new_len;
+            iarc >> new_len;
+            if (len != new_len) resize(new_len);
+            automi_masked_load_lanes(iarc, mask.array, array, lanes());
+        }
+
+        inline void vec_op_set(const automi_numeric_bitvec& other, size_t b) {
+            memcpy(block(b), other.block(b), sizeof(element) * 8);
+        }
+
+        inline void vec_op_set_mask(const automi_numeric_bitvec& other, const automi_bitvec<bool>& mask, size_t b) {
+            ops().blend(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline void vec_op_set(const automi_numeric_bitvec& other) {
+            memcpy(array, other.array, sizeof(element) * lanes());
+        }
+
+        inline void vec_op_set_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other) {
+            ops().blend(array, mask.array, other.array, lanes());
+        }
+
+        inline void vec_op_set(T val) {
+            ops().set1(array, val, lanes());
+        }
+
+        inline void vec_op_set(const automi_bitvec<bool>& mask, T val) {
+            ops().set1(array, val, lanes());
+        }
+
+        inline void vec_op_set_mask(const automi_bitvec<bool>& mask, T val) {
+            ops().blend1(array, mask.array, val, lanes());
+        }
+
+        /**
+         * Returns true if 'this' contain elements greater than / less than 'other', set those lanes to other's value.
+         * Returns false if no such elements exists.
+         */
+        inline bool vec_op_cmpgt_update(const automi_numeric_bitvec& other, size_t b) {
+            return ops().min_gt(block(b), NULL, other.block(b), 8);
+        }
+
+        inline bool vec_op_masked_cmpgt_update(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, size_t b) {
+            mask_element cmpgt_mask;
+            ops().cmpgt(&cmpgt_mask, block(b), other.block(b), 8);
+            cmpgt_mask = cmpgt_mask & mask.array[b];
+            ops().blend(block(b), &cmpgt_mask, other.block(b), 8);
+            return bool(cmpgt_mask);
+        }
+
+        inline bool vec_op_cmplt_update(const automi_numeric_bitvec& other, size_t b) {
+            return ops().max_lt(block(b), NULL, other.block(b), 8);
+        }
+
+        inline bool vec_op_cmpgt_update_mask(const automi_numeric_bitvec& other, automi_bitvec<bool>& mask, size_t b) {
+            return ops().min_gt(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline bool vec_op_cmplt_update_mask(const automi_numeric_bitvec& other, automi_bitvec<bool>& mask, size_t b) {
+            return ops().max_lt(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline void vec_op_mul_update(const automi_numeric_bitvec& other, T val, size_t b) {
+            ops().mul1(block(b), other.block(b), val, 8);
+        }
+
+        inline void vec_op_mul_update(const automi_numeric_bitvec& other, T val) {
+            ops().mul1(array, other.array, val, lanes());
+        }
+
+        inline void vec_op_mul_update_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, T val) {
+            ops().mul1_mask(array, mask.array, other.array, val, lanes());
+        }
+
+        inline void vec_op_masked_mul_update(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, T val, size_t b) {
+            ops().mul1_mask(block(b), &mask.array[b], other.block(b), val, 8);
+        }
+
+        inline void vec_op_mul_val_update(T val, size_t b) {
+            ops().mul1(block(b), block(b), val, 8);
+        }
+
+        /// Division operators, floating point lanes only
+        inline void vec_op_div_update(const automi_numeric_bitvec& other, T val, size_t b) {
+            ops().div1(block(b), other.block(b), val, 8);
+        }
+
+        inline void vec_op_div_update(const automi_numeric_bitvec& other, T val) {
+            ops().div1(array, other.array, val, lanes());
+        }
+
+        inline void vec_op_div_update(const automi_numeric_bitvec& other1, const automi_numeric_bitvec& other2, size_t b) {
+            ops().div(block(b), other1.block(b), other2.block(b), 8);
+        }
+
+        inline void vec_op_masked_div_update(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, size_t b) {
+            ops().div_mask(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline void vec_op_masked_add_update(mask_element mask, T val, size_t b) {
+            ops().add1_mask(block(b), &mask, block(b), val, 8);
+        }
+
+        inline void vec_op_masked_add_update(const automi_bitvec<bool>& mask, T val, size_t b) {
+            ops().add1_mask(block(b), &mask.array[b], block(b), val, 8);
+        }
+
+        inline void vec_op_masked_add_update(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, size_t b) {
+            ops().add_mask(block(b), &mask.array[b], block(b), other.block(b), 8);
+        }
+
+        inline void vec_op_add_update(const automi_numeric_bitvec& other, size_t b) {
+            ops().add(block(b), block(b), other.block(b), 8);
+        }
+
+        inline void vec_op_add_update(const automi_numeric_bitvec& other, T val, size_t b) {
+            ops().add1(block(b), other.block(b), val, 8);
+        }
+
+        inline void vec_op_add_update(const automi_numeric_bitvec& other1, const automi_numeric_bitvec& other2, size_t b) {
+            ops().add(block(b), other1.block(b), other2.block(b), 8);
+        }
+
+        inline void vec_op_add_update(const automi_numeric_bitvec& other, T val) {
+            ops().add1(array, other.array, val, lanes());
+        }
+
+        inline void vec_op_add_update_mask(const automi_bitvec<bool>& mask, T val) {
+            ops().add1_mask(array, mask.array, array, val, lanes());
+        }
+
+        inline void vec_op_add_update_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, T val) {
+            ops().add1_mask(array, mask.array, other.array, val, lanes());
+        }
+
+        inline void vec_op_add_update_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other1, const automi_numeric_bitvec& other2) {
+            ops().add_mask(array, mask.array, other1.array, other2.array, lanes());
+        }
+
+        /// this = min(this, other + val), without a temporary
+        inline void vec_op_add_min_update(const automi_numeric_bitvec& other, T val) {
+            ops().add1_min(array, other.array, val, lanes());
+        }
+
+        /// this = min(this, other + val) on the lanes of mask, without a temporary
+        inline void vec_op_add_min_update_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, T val) {
+            ops().add1_min_mask(array, mask.array, other.array, val, lanes());
+        }
+
+        /**
+         * this = min(this, other), setting 'changed' to the lanes which
+         * decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_min_update(const automi_numeric_bitvec& other, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            const bool any = ops().min_gt(array, changed.array, other.array, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        /**
+         * this = min(this, other) on the lanes of mask, adding the lanes
+         * which decreased to 'changed', in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_min_update_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec& other, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            return ops().min_gt_mask(array, mask.array, changed.array, other.array, lanes());
+        }
+
+        /**
+         * this = min(this, other + val), setting 'changed' to the lanes
+         * which decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_add_min_update(const automi_numeric_bitvec& other, T val, automi_bitvec<bool>& changed) {
+            if (changed.len != len) changed.resize(len);
+            const bool any = ops().add1_min_gt(array, changed.array, other.array, val, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        element* array;
+        size_t len;
+        size_t arrlen;
+    private:
+        friend class automi_bitvec<bool>;
+
+        /// The kernels of the selected SIMD backend
+        inline static const automi_lane_kernels<element>& ops() {
+            return automi_simd_lanes<element>::get();
+        }
+
+        /// The number of allocated lanes, a multiple of 8
+        inline size_t lanes() const { return 8 * arrlen; }
+
+        /// The first lane of block 'b'
+        inline element* block(size_t b) { return array + 8 * b; }
+        inline const element* block(size_t b) const { return array + 8 * b; }
+    };
+
+    /// specialized <dtype=int16_t> class automi_bitvec, with saturating add
+    template<>
+    class automi_bitvec<int16_t> : public automi_numeric_bitvec<int16_t> {
+    public:
+        automi_bitvec() {}
+
+        /// Constructs a bitvec with 'size' elements. All elements are 0.
+        explicit automi_bitvec(size_t size) : automi_numeric_bitvec<int16_t>(size) {}
+    };
+
+    /// specialized <dtype=uint8_t> class automi_bitvec, with saturating add
+    template<>
+    class automi_bitvec<uint8_t> : public automi_numeric_bitvec<uint8_t> {
+    public:
+        automi_bitvec() {}
+
+        /// Constructs a bitvec with 'size' elements. All elements are 0.
+        explicit automi_bitvec(size_t size) : automi_numeric_bitvec<uint8_t>(size) {}
+    };
+
+    /// specialized <dtype=int64_t> class automi_bitvec
+    template<>
+    class automi_bitvec<int64_t> : public automi_numeric_bitvec<int64_t> {
+    public:
+        automi_bitvec() {}
+
+        /// Constructs a bitvec with 'size' elements. All elements are 0.
+        explicit automi_bitvec(size_t size) : automi_numeric_bitvec<int64_t>(size) {}
+    };
+
+    /// specialized <dtype=double> class automi_bitvec
+    template<>
+    class automi_bitvec<double> : public automi_numeric_bitvec<double> {
+    public:
+        automi_bitvec() {}
+
+        /// Constructs a bitvec with 'size' elements. All elements are 0.
+        explicit automi_bitvec(size_t size) : automi_numeric_bitvec<double>(size) {}
+    };
+
+
+    inline void automi_bitvec<bool>::vec_op_cmpgt_update(const automi_bitvec<int>& other1, const automi_bitvec<int>& other2) {
+        automi_bitvec<int>::ops().cmpgt(array, other1.array, other2.array, 8 * arrlen);
+        clear_tail();
+    }
+
+    inline void automi_bitvec<bool>::vec_op_cmpgt_update_mask(const automi_bitvec<bool>& mask, const automi_bitvec<int>& other1, const automi_bitvec<int>& other2) {
+        automi_bitvec<int>::ops().cmpgt(array, other1.array, other2.array, 8 * arrlen);
+        for (size_t i = 0; i < arrlen; i++) {
+            array[i] = array[i] & mask.array[i];
+        }
+    }
+
+    inline void automi_bitvec<bool>::vec_op_cmpneq_update(const automi_bitvec<int>& other1, const automi_bitvec<int>& other2) {
+        automi_bitvec<int>::ops().cmpneq(array, other1.array, other2.array, 8 * arrlen);
+        clear_tail();
+    }
+
+    template <typename T>
+    inline void automi_bitvec<bool>::vec_op_cmpgt_update(const automi_numeric_bitvec<T>& other1, const automi_numeric_bitvec<T>& other2) {
+        automi_numeric_bitvec<T>::ops().cmpgt(array, other1.array, other2.array, 8 * arrlen);
+        clear_tail();
+    }
+
+    template <typename T>
+    inline void automi_bitvec<bool>::vec_op_cmpgt_update_mask(const automi_bitvec<bool>& mask, const automi_numeric_bitvec<T>& other1, const automi_numeric_bitvec<T>& other2) {
+        automi_numeric_bitvec<T>::ops().cmpgt(array, other1.array, other2.array, 8 * arrlen);
+        for (size_t i = 0; i < arrlen; i++) {
+            array[i] = array[i] & mask.array[i];
+        }
+    }
+
+    template <typename T>
+    inline void automi_bitvec<bool>::vec_op_cmpneq_update(const automi_numeric_bitvec<T>& other1, const automi_numeric_bitvec<T>& other2) {
+        automi_numeric_bitvec<T>::ops().cmpneq(array, other1.array, other2.array, 8 * arrlen);
+        clear_tail();
+    }
+
 }
 
 #endif  // GRAPHLAB_automi_bitvec_HPP
@@ -0,0 +1,793 @@
+#ifndef GRAPHLAB_DIMITRA_FIXEDVEC_HPP
+#define GRAPHLAB_DIMITRA_FIXEDVEC_HPP
+
+#include <cstring>
+#include <stdint.h>
+#include <graphlab/logger/assertions.hpp>
+#include <graphlab/serialization/serialization_includes.hpp>
+#include <graphlab/util/dimitra_bitvec.hpp>
+
+namespace graphlab {
+    /**
+     * Implements array of int | float | bit with N lanes known at compile time
+     *
+     * automi_fixedvec offers the vec_op_* and pair_op_* operators of
+     * automi_bitvec, but stores its lanes inline: constructing, copying
+     * and serializing a fixedvec never touches the allocator, so a
+     * gather returning a fresh message per edge costs no malloc/free.
+     * A fixedvec is trivially copyable and is serialized as a POD.
+     *
+     * The size() of a fixedvec is always N.  The constructor taking a
+     * size and resize() are kept so that code written against
+     * automi_bitvec compiles unchanged; they only check that the
+     * requested number of lanes fits in N.
+     *
+     * Masks are automi_fixedvec<bool, N>, which has the layout of an
+     * automi_bitvec<bool> of N lanes and can be converted from one.
+     * Its whole-mask operations run on 64-bit words, unrolled at
+     * compile time.
+     */
+    /// Primary template class automi_fixedvec
+    template <typename dtype, size_t N>
+    class automi_fixedvec {};
+
+    /// specialized <dtype=bool> class automi_fixedvec
+    template <size_t N>
+    class automi_fixedvec<bool, N> : public IS_POD_TYPE {
+    public:
+        typedef uint8_t element;
+        enum { len = N, arrlen = (N + 7) / 8, nwords = (N + 63) / 64 };
+
+        /// Constructs a fixedvec. All elements are 0.
+        automi_fixedvec() { clear(); }
+
+        /// Constructs a fixedvec of 'size' <= N elements. All elements are 0.
+        explicit automi_fixedvec(size_t size) {
+            resize(size);
+            clear();
+        }
+
+        /// Constructs a copy of the lanes of a bitvec of at most N elements
+        explicit automi_fixedvec(const automi_bitvec<bool>& db) {
+            ASSERT_LE(db.size(), size_t(N));
+            clear();
+            memcpy(array, db.array, sizeof(element) * db.arrlen);
+        }
+
+        /// Copies the lanes of this fixedvec to the bitvec db
+        inline void to_bitvec(automi_bitvec<bool>& db) const {
+            db.resize(N);
+            memcpy(db.array, array, sizeof(element) * arrlen);
+        }
+
+        /// Checks that 'n' lanes fit in this fixedvec
+        inline void resize(size_t n) {
+            ASSERT_LE(n, size_t(N));
+        }
+
+        /// Set all memory within fixedvec to 0
+        inline void clear() {
+            memset(array, 0, sizeof(array));
+        }
+
+        /// Returns the number of elements in this fixedvec
+        inline size_t size() const {
+            return N;
+        }
+
+        /// Set all element values using provided val
+        inline void set_all(bool val) {
+            if (val) {
+                memset(array, 0xFF, sizeof(array));
+                clear_tail();
+            }
+            else {
+                clear();
+            }
+        }
+
+        /// Set one position using provided val and idx
+        inline void set_single(bool val, size_t idx) {
+            if (val) {
+                array[idx / 8] = array[idx / 8] | element(1 << (idx % 8));
+            }
+            else {
+                array[idx / 8] = array[idx / 8] & element(~(1 << (idx % 8)));
+            }
+        }
+
+        inline void set_element(element val, size_t b) {
+            array[b] = val;
+        }
+
+        inline void masked_set_element(element val, size_t b, element mask) {
+            array[b] = mask & val;
+        }
+
+        /// Get the block of 8 lanes 'b'
+        element get_single(size_t b) const {
+            return array[b];
+        }
+
+        // test if bit is set to 1
+        bool test_bit(size_t b) const {
+            return (array[b / 8] >> (b % 8)) & 1;
+        }
+
+        /// Returns the number of lanes set
+        inline size_t count() const {
+            size_t n = 0;
+            for (size_t i = 0; i < nwords; i++) {
+                n += __builtin_popcountll(words[i]);
+            }
+            return n;
+        }
+
+        /// Returns true if a lane is set
+        inline bool vec_any() const {
+            uint64_t any = 0;
+            for (size_t i = 0; i < nwords; i++) {
+                any |= words[i];
+            }
+            return any != 0;
+        }
+
+        /// Returns true if all the lanes are set
+        inline bool vec_all() const {
+            for (size_t i = 0; i < N / 64; i++) {
+                if (words[i] != ~uint64_t(0)) return false;
+            }
+            return N % 64 == 0 || words[N / 64] == (uint64_t(1) << (N % 64)) - 1;
+        }
+
+        /// Returns the lowest lane set, or N if none
+        inline size_t first_set() const {
+            for (size_t i = 0; i < nwords; i++) {
+                if (words[i] != 0) return 64 * i + __builtin_ctzll(words[i]);
+            }
+            return N;
+        }
+
+        /// in-place pairwise Or Operator
+        static void pair_op_or(automi_fixedvec& a, const automi_fixedvec& b) {
+            for (size_t i = 0; i < nwords; i++) {
+                a.words[i] = a.words[i] | b.words[i];
+            }
+        }
+
+        inline void vec_op_set(const automi_fixedvec& other, size_t b) {
+            array[b] = other.array[b];
+        }
+
+        inline void vec_op_set_mask(const automi_fixedvec& other, const automi_fixedvec& mask, size_t b) {
+            array[b] = other.array[b] & mask.array[b];
+        }
+
+        inline void vec_op_set(const automi_fixedvec& other) {
+            memcpy(array, other.array, sizeof(array));
+        }
+
+        inline void vec_op_set_mask(const automi_fixedvec& mask, const automi_fixedvec& other) {
+            for (size_t i = 0; i < nwords; i++) {
+                words[i] = other.words[i] & mask.words[i];
+            }
+        }
+
+        inline void vec_op_set(const automi_fixedvec& mask, bool val) {
+            set_all(val);
+        }
+
+        inline void vec_op_set_mask(const automi_fixedvec& mask, bool val) {
+            for (size_t i = 0; i < nwords; i++) {
+                words[i] = val ? (words[i] | mask.words[i]) : (words[i] & ~mask.words[i]);
+            }
+        }
+
+        /**
+         * Returns true if a bit of block 'b' changes after `bitwise_or`
+         * with 'other'.  Returns false if no such bit exists.
+         */
+        inline bool vec_op_or_update(const automi_fixedvec& other, size_t b) {
+            element prev_val = array[b];
+            array[b] = array[b] | other.array[b];
+            return bool((~prev_val) & array[b]);
+        }
+
+        /// Returns true if a lane of 'this' is set by `bitwise_or` with 'other'
+        inline bool vec_op_or_update(const automi_fixedvec& other) {
+            uint64_t gained = 0;
+            for (size_t i = 0; i < nwords; i++) {
+                gained |= ~words[i] & other.words[i];
+                words[i] = words[i] | other.words[i];
+            }
+            return gained != 0;
+        }
+
+        /// Returns true if a lane of 'this' is set by `bitwise_or` with 'other' on the lanes of mask
+        inline bool vec_op_or_update_mask(const automi_fixedvec& mask, const automi_fixedvec& other) {
+            uint64_t gained = 0;
+            for (size_t i = 0; i < nwords; i++) {
+                const uint64_t masked_val = mask.words[i] & other.words[i];
+                gained |= ~words[i] & masked_val;
+                words[i] = words[i] | masked_val;
+            }
+            return gained != 0;
+        }
+
+        inline bool vec_op_or_update(const automi_fixedvec& other1, const element& other2, size_t b) {
+            element prev_val = other1.array[b];
+            array[b] = other1.array[b] | other2;
+            return bool((~prev_val) & array[b]);
+        }
+
+        inline bool vec_op_or_update(const automi_fixedvec& other1, const automi_fixedvec& other2, size_t b) {
+            element prev_val = other1.array[b];
+            array[b] = other1.array[b] | other2.array[b];
+            return bool((~prev_val) & array[b]);
+        }
+
+        inline bool vec_op_or_update_mask(const automi_fixedvec& other, const automi_fixedvec& mask, size_t b) {
+            element tmp_mask = mask.array[b];
+            if (!tmp_mask)
+                return false;
+            element prev_val = array[b];
+            array[b] = array[b] | (tmp_mask & other.array[b]);
+            return bool((~prev_val) & array[b]);
+        }
+
+        inline bool vec_op_or_update_mask(const automi_fixedvec& other1, const automi_fixedvec& mask, const element& other2, size_t b) {
+            element tmp_mask = mask.array[b];
+            if (!tmp_mask)
+                return false;
+            element prev_val = other1.array[b];
+            array[b] = other1.array[b] | (tmp_mask & other2);
+            return bool((~prev_val) & array[b]);
+        }
+
+        /// this = ~other1 & other2
+        inline void vec_op_andnot_update(const automi_fixedvec& other1, const automi_fixedvec& other2) {
+            for (size_t i = 0; i < nwords; i++) {
+                words[i] = ~other1.words[i] & other2.words[i];
+            }
+        }
+
+        /// this = ~other1 & other2 on the lanes of mask
+        inline void vec_op_andnot_update_mask(const automi_fixedvec& mask, const automi_fixedvec& other1, const automi_fixedvec& other2) {
+            for (size_t i = 0; i < nwords; i++) {
+                words[i] = (words[i] & ~mask.words[i]) |
+                           (mask.words[i] & ~other1.words[i] & other2.words[i]);
+            }
+        }
+
+        inline bool vec_all_zeros() const {
+            return !vec_any();
+        }
+
+        inline void vec_op_negate(automi_fixedvec& ret) {
+            for (size_t i = 0; i < nwords; i++) {
+                ret.words[i] = ~words[i];
+            }
+            ret.clear_tail();
+        }
+
+        inline void vec_op_negate_mask(const automi_fixedvec& mask, automi_fixedvec& ret) {
+            for (size_t i = 0; i < nwords; i++) {
+                ret.words[i] = mask.words[i] & ~words[i];
+            }
+        }
+
+        inline void vec_op_cmpgt_update(const automi_fixedvec<int, N>& other1, const automi_fixedvec<int, N>& other2) {
+            automi_simd_lanes<int>::get().cmpgt(array, other1.array, other2.array, 8 * arrlen);
+            clear_tail();
+        }
+
+        inline void vec_op_cmpgt_update_mask(const automi_fixedvec& mask, const automi_fixedvec<int, N>& other1, const automi_fixedvec<int, N>& other2) {
+            automi_simd_lanes<int>::get().cmpgt(array, other1.array, other2.array, 8 * arrlen);
+            for (size_t i = 0; i < arrlen; i++) {
+                array[i] = array[i] & mask.array[i];
+            }
+        }
+
+        inline void vec_op_cmpneq_update(const automi_fixedvec<int, N>& other1, const automi_fixedvec<int, N>& other2) {
+            automi_simd_lanes<int>::get().cmpneq(array, other1.array, other2.array, 8 * arrlen);
+            clear_tail();
+        }
+
+        /// Masked Serialization (I don't think masking can save traffic)
+        template <typename Mask>
+        inline void masked_save(oarchive& oarc, const Mask& mask) const {
+            oarc << *this;
+        }
+
+        /// Masked Serialization (coupled with masked_save)
+        template <typename Mask>
+        inline void masked_load(iarchive& iarc, const Mask& mask) {
+            iarc >> *this;
+        }
+
+        /// The lanes, padded to whole words which are kept 0 past N
+        union {
+            element array[8 * nwords];
+            uint64_t words[nwords];
+        };
+    private:
+        template <typename T, size_t M> friend class automi_fixedvec;
+
+        /// Clears the bits past N
+        inline void clear_tail() {
+            if (N % 64 != 0) {
+                words[nwords - 1] &= (uint64_t(1) << (N % 64)) - 1;
+            }
+        }
+    };
+
+    /// specialized <dtype=int> class automi_fixedvec
+    template <size_t N>
+    class automi_fixedvec<int, N> : public IS_POD_TYPE {
+    public:
+        typedef int element;
+        typedef automi_fixedvec<bool, N> mask_type;
+        typedef typename mask_type::element mask_element;
+        enum { len = N, arrlen = (N + 7) / 8 };
+
+        /// Constructs a fixedvec. All elements are 0.
+        automi_fixedvec() { clear(); }
+
+        /// Constructs a fixedvec of 'size' <= N elements. All elements are 0.
+        explicit automi_fixedvec(size_t size) {
+            resize(size);
+            clear();
+        }
+
+        /// Overload operator+= for gather function
+        inline automi_fixedvec& operator+=(const automi_fixedvec& other) {
+            ops().add(array, array, other.array, lanes());
+            return *this;
+        }
+
+        /// Checks that 'n' lanes fit in this fixedvec
+        inline void resize(size_t n) {
+            ASSERT_LE(n, size_t(N));
+        }
+
+        /// Set all memory within fixedvec to 0
+        inline void clear() {
+            memset(array, 0, sizeof(array));
+        }
+
+        /// Returns the number of elements in this fixedvec
+        inline size_t size() const {
+            return N;
+        }
+
+        /// Set all elements value using provided val
+        inline void set_all(int val) {
+            ops().set1(array, val, lanes());
+        }
+
+        /// Set one lane value using provided val and idx
+        inline void set_single(int val, size_t idx) {
+            array[idx] = val;
+        }
+
+        /// Set lanes to value `val' using provided mask
+        inline void set_mask(const mask_type& m, int val) {
+            ops().blend1(array, m.array, val, lanes());
+        }
+
+        /// Get one single lane in fixedvec element values
+        inline int get_single(size_t b) const {
+            return array[b];
+        }
+
+        /// in-place pairwise Min Operator
+        static void pair_op_min(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().min(a.array, a.array, b.array, lanes());
+        }
+
+        /// in-place pairwise Max Operator
+        static void pair_op_max(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().max(a.array, a.array, b.array, lanes());
+        }
+
+        static void pair_op_add(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().add(a.array, a.array, b.array, lanes());
+        }
+
+        static void pair_op_mul(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().mul(a.array, a.array, b.array, lanes());
+        }
+
+        inline void vec_op_mul_update(const automi_fixedvec& other, int val, size_t b) {
+            ops().mul1(block(b), other.block(b), val, 8);
+        }
+
+        inline void vec_op_mul_update(const automi_fixedvec& other, int val) {
+            ops().mul1(array, other.array, val, lanes());
+        }
+
+        inline void vec_op_masked_mul_update(const mask_type& mask, const automi_fixedvec& other, int val, size_t b) {
+            ops().mul1_mask(block(b), &mask.array[b], other.block(b), val, 8);
+        }
+
+        /// Masked Serialization, the receiver knows N so only the lane count is sent
+        template <typename Mask>
+        inline void masked_save(oarchive& oarc, const Mask& mask) const {
+            automi_masked_save_lanes(oarc, mask.array, array, lanes());
+        }
+
+        /// Masked Deserialization
+        template <typename Mask>
+        inline void masked_load(iarchive& iarc, const Mask& mask) {
+            automi_masked_load_lanes(iarc, mask.array, array, lanes());
+        }
+
+        inline void vec_op_set(const automi_fixedvec& other, size_t b) {
+            memcpy(block(b), other.block(b), sizeof(element) * 8);
+        }
+
+        inline void vec_op_set_mask(const automi_fixedvec& other, const mask_type& mask, size_t b) {
+            ops().blend(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline void vec_op_set(const automi_fixedvec& other) {
+            memcpy(array, other.array, sizeof(array));
+        }
+
+        inline void vec_op_set_mask(const mask_type& mask, const automi_fixedvec& other) {
+            ops().blend(array, mask.array, other.array, lanes());
+        }
+
+        inline void vec_op_set(const mask_type& mask, int val) {
+            ops().set1(array, val, lanes());
+        }
+
+        inline void vec_op_set_mask(const mask_type& mask, int val) {
+            ops().blend1(array, mask.array, val, lanes());
+        }
+
+        /**
+         * Returns true if 'this' contain elements greater than / less than 'other', set those lanes to other's value.
+         * Returns false if no such elements exists.
+         */
+        inline bool vec_op_cmpgt_update(const automi_fixedvec& other, size_t b) {
+            return ops().min_gt(block(b), NULL, other.block(b), 8);
+        }
+
+        inline bool vec_op_masked_cmpgt_update(const mask_type& mask, const automi_fixedvec& other, size_t b) {
+            mask_element cmpgt_mask;
+            ops().cmpgt(&cmpgt_mask, block(b), other.block(b), 8);
+            cmpgt_mask = cmpgt_mask & mask.array[b];
+            ops().blend(block(b), &cmpgt_mask, other.block(b), 8);
+            return bool(cmpgt_mask);
+        }
+
+        inline bool vec_op_cmplt_update(const automi_fixedvec& other, size_t b) {
+            return ops().max_lt(block(b), NULL, other.block(b), 8);
+        }
+
+        inline bool vec_op_cmpgt_update_mask(const automi_fixedvec& other, mask_type& mask, size_t b) {
+            return ops().min_gt(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline bool vec_op_cmplt_update_mask(const automi_fixedvec& other, mask_type& mask, size_t b) {
+            return ops().max_lt(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline void vec_op_masked_add_update(mask_element mask, int val, size_t b) {
+            ops().add1_mask(block(b), &mask, block(b), val, 8);
+        }
+
+        inline void vec_op_masked_add_update(const mask_type& mask, int val, size_t b) {
+            ops().add1_mask(block(b), &mask.array[b], block(b), val, 8);
+        }
+
+        inline void vec_op_masked_add_update(const mask_type& mask, const automi_fixedvec& other, size_t b) {
+            ops().add_mask(block(b), &mask.array[b], block(b), other.block(b), 8);
+        }
+
+        inline void vec_op_add_update(const automi_fixedvec& other, int val, size_t b) {
+            ops().add1(block(b), other.block(b), val, 8);
+        }
+
+        inline void vec_op_add_update(const automi_fixedvec& other1, const automi_fixedvec& other2, size_t b) {
+            ops().add(block(b), other1.block(b), other2.block(b), 8);
+        }
+
+        inline void vec_op_add_update(const automi_fixedvec& other, int val) {
+            ops().add1(array, other.array, val, lanes());
+        }
+
+        inline void vec_op_add_update_mask(const mask_type& mask, const automi_fixedvec& other, int val) {
+            ops().add1_mask(array, mask.array, other.array, val, lanes());
+        }
+
+        inline void vec_op_add_update_mask(const mask_type& mask, const automi_fixedvec& other1, const automi_fixedvec& other2) {
+            ops().add_mask(array, mask.array, other1.array, other2.array, lanes());
+        }
+
+        /// this = min(this, other + val), without a temporary
+        inline void vec_op_add_min_update(const automi_fixedvec& other, int val) {
+            ops().add1_min(array, other.array, val, lanes());
+        }
+
+        /// this = min(this, other + val) on the lanes of mask, without a temporary
+        inline void vec_op_add_min_update_mask(const mask_type& mask, const automi_fixedvec& other, int val) {
+            ops().add1_min_mask(array, mask.array, other.array, val, lanes());
+        }
+
+        /**
+         * this = min(this, other), setting 'changed' to the lanes which
+         * decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_min_update(const automi_fixedvec& other, mask_type& changed) {
+            const bool any = ops().min_gt(array, changed.array, other.array, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        /**
+         * this = min(this, other) on the lanes of mask, adding the lanes
+         * which decreased to 'changed', in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_min_update_mask(const mask_type& mask, const automi_fixedvec& other, mask_type& changed) {
+            return ops().min_gt_mask(array, mask.array, changed.array, other.array, lanes());
+        }
+
+        /**
+         * this = min(this, other + val), setting 'changed' to the lanes
+         * which decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_add_min_update(const automi_fixedvec& other, int val, mask_type& changed) {
+            const bool any = ops().add1_min_gt(array, changed.array, other.array, val, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        /// the kernels don't need aligned lanes, but keep blocks in one cache line
+        alignas(32) element array[8 * arrlen];
+    private:
+        /// The kernels of the selected SIMD backend
+        inline static const automi_lane_kernels<element>& ops() {
+            return automi_simd_lanes<element>::get();
+        }
+
+        /// The number of stored lanes, a multiple of 8
+        inline static size_t lanes() { return 8 * arrlen; }
+
+        /// The first lane of block 'b'
+        inline element* block(size_t b) { return array + 8 * b; }
+        inline const element* block(size_t b) const { return array + 8 * b; }
+    };
+
+    /// specialized <dtype=float> class automi_fixedvec
+    template <size_t N>
+    class automi_fixedvec<float, N> : public IS_POD_TYPE {
+    public:
+        typedef float element;
+        typedef automi_fixedvec<bool, N> mask_type;
+        enum { len = N, arrlen = (N + 7) / 8 };
+
+        /// Constructs a fixedvec. All elements are 0.
+        automi_fixedvec() { clear(); }
+
+        /// Constructs a fixedvec of 'size' <= N elements. All elements are 0.
+        explicit automi_fixedvec(size_t size) {
+            resize(size);
+            clear();
+        }
+
+        /// Overload operator+= for gather function
+        inline automi_fixedvec& operator+=(const automi_fixedvec& other) {
+            ops().add(array, array, other.array, lanes());
+            return *this;
+        }
+
+        /// Checks that 'n' lanes fit in this fixedvec
+        inline void resize(size_t n) {
+            ASSERT_LE(n, size_t(N));
+        }
+
+        /// Set all memory within fixedvec to 0
+        inline void clear() {
+            memset(array, 0, sizeof(array));
+        }
+
+        /// Returns the number of elements in this fixedvec
+        inline size_t size() const {
+            return N;
+        }
+
+        /// Set all elements value using provided val
+        inline void set_all(float val) {
+            ops().set1(array, val, lanes());
+        }
+
+        /// Set one lane value using provided val and idx
+        inline void set_single(float val, size_t idx) {
+            array[idx] = val;
+        }
+
+        /// Set lanes to value `val' using provided mask
+        inline void set_mask(const mask_type& m, float val) {
+            ops().blend1(array, m.array, val, lanes());
+        }
+
+        /// Get one single lane in fixedvec element values
+        inline float get_single(size_t b) const {
+            return array[b];
+        }
+
+        /// in-place pairwise Min Operator
+        static void pair_op_min(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().min(a.array, a.array, b.array, lanes());
+        }
+
+        /// in-place pairwise Max Operator
+        static void pair_op_max(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().max(a.array, a.array, b.array, lanes());
+        }
+
+        static void pair_op_add(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().add(a.array, a.array, b.array, lanes());
+        }
+
+        static void pair_op_mul(automi_fixedvec& a, const automi_fixedvec& b) {
+            ops().mul(a.array, a.array, b.array, lanes());
+        }
+
+        /// Masked Serialization, the receiver knows N so only the lane count is sent
+        template <typename Mask>
+        inline void masked_save(oarchive& oarc, const Mask& mask) const {
+            automi_masked_save_lanes(oarc, mask.array, array, lanes());
+        }
+
+        /// Masked Deserialization
+        template <typename Mask>
+        inline void masked_load(iarchive& iarc, const Mask& mask) {
+            automi_masked_load_lanes(iarc, mask.array, array, lanes());
+        }
+
+        inline void vec_op_set(const automi_fixedvec& other, size_t b) {
+            memcpy(block(b), other.block(b), sizeof(element) * 8);
+        }
+
+        inline void vec_op_set_mask(const automi_fixedvec& other, const mask_type& mask, size_t b) {
+            ops().blend(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline void vec_op_set(const automi_fixedvec& other) {
+            memcpy(array, other.array, sizeof(array));
+        }
+
+        inline void vec_op_set_mask(const mask_type& mask, const automi_fixedvec& other) {
+            ops().blend(array, mask.array, other.array, lanes());
+        }
+
+        inline void vec_op_set(float val) {
+            ops().set1(array, val, lanes());
+        }
+
+        inline void vec_op_set_mask(const mask_type& mask, float val) {
+            ops().blend1(array, mask.array, val, lanes());
+        }
+
+        inline void vec_op_div_update(const automi_fixedvec& other, float val, size_t b) {
+            ops().div1(block(b), other.block(b), val, 8);
+        }
+
+        inline void vec_op_div_update(const automi_fixedvec& other, float val) {
+            ops().div1(array, other.array, val, lanes());
+        }
+
+        inline void vec_op_div_update(const automi_fixedvec& other1, const automi_fixedvec& other2, size_t b) {
+            ops().div(block(b), other1.block(b), other2.block(b), 8);
+        }
+
+        inline void vec_op_masked_div_update(const mask_type& mask, const automi_fixedvec& other, size_t b) {
+            ops().div_mask(block(b), &mask.array[b], other.block(b), 8);
+        }
+
+        inline void vec_op_mul_update(const automi_fixedvec& other, float val, size_t b) {
+            ops().mul1(block(b), other.block(b), val, 8);
+        }
+
+        inline void vec_op_mul_update(const automi_fixedvec& other, float val) {
+            ops().mul1(array, other.array, val, lanes());
+        }
+
+        inline void vec_op_mul_update_mask(const mask_type& mask, const automi_fixedvec& other, float val) {
+            ops().mul1_mask(array, mask.array, other.array, val, lanes());
+        }
+
+        inline void vec_op_masked_mul_update(const mask_type& mask, const automi_fixedvec& other, float val, size_t b) {
+            ops().mul1_mask(block(b), &mask.array[b], other.block(b), val, 8);
+        }
+
+        inline void vec_op_mul_val_update(float val, size_t b) {
+            ops().mul1(block(b), block(b), val, 8);
+        }
+
+        inline void vec_op_masked_add_update(const mask_type& mask, float val, size_t b) {
+            ops().add1_mask(block(b), &mask.array[b], block(b), val, 8);
+        }
+
+        inline void vec_op_masked_add_update(const mask_type& mask, const automi_fixedvec& other, size_t b) {
+            ops().add_mask(block(b), &mask.array[b], block(b), other.block(b), 8);
+        }
+
+        inline void vec_op_add_update(const automi_fixedvec& other, size_t b) {
+            ops().add(block(b), block(b), other.block(b), 8);
+        }
+
+        inline void vec_op_add_update_mask(const mask_type& mask, float val) {
+            ops().add1_mask(array, mask.array, array, val, lanes());
+        }
+
+        /// this = min(this, other + val), without a temporary
+        inline void vec_op_add_min_update(const automi_fixedvec& other, float val) {
+            ops().add1_min(array, other.array, val, lanes());
+        }
+
+        /// this = min(this, other + val) on the lanes of mask, without a temporary
+        inline void vec_op_add_min_update_mask(const mask_type& mask, const automi_fixedvec& other, float val) {
+            ops().add1_min_mask(array, mask.array, other.array, val, lanes());
+        }
+
+        /**
+         * this = min(this, other), setting 'changed' to the lanes which
+         * decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_min_update(const automi_fixedvec& other, mask_type& changed) {
+            const bool any = ops().min_gt(array, changed.array, other.array, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        /**
+         * this = min(this, other) on the lanes of mask, adding the lanes
+         * which decreased to 'changed', in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_min_update_mask(const mask_type& mask, const automi_fixedvec& other, mask_type& changed) {
+            return ops().min_gt_mask(array, mask.array, changed.array, other.array, lanes());
+        }
+
+        /**
+         * this = min(this, other + val), setting 'changed' to the lanes
+         * which decreased, in one pass.  Returns true if one did.
+         */
+        inline bool vec_op_add_min_update(const automi_fixedvec& other, float val, mask_type& changed) {
+            const bool any = ops().add1_min_gt(array, changed.array, other.array, val, lanes());
+            changed.clear_tail();
+            return any && changed.vec_any();
+        }
+
+        inline void vec_op_add_update(const automi_fixedvec<int, N>& other, size_t b) {
+            for (size_t i = 8 * b; i < 8 * b + 8; i++) {
+                array[i] += float(other.array[i]);
+            }
+        }
+
+        inline void vec_op_add_update(const mask_type& other, size_t b) {
+            ops().add1(block(b), block(b), float(other.array[b]), 8);
+        }
+
+        /// the kernels don't need aligned lanes, but keep blocks in one cache line
+        alignas(32) element array[8 * arrlen];
+    private:
+        /// The kernels of the selected SIMD backend
+        inline static const automi_lane_kernels<element>& ops() {
+            return automi_simd_lanes<element>::get();
+        }
+
+        /// The number of stored lanes, a multiple of 8
+        inline static size_t lanes() { return 8 * arrlen; }
+
+        /// The first lane of block 'b'
+        inline element* block(size_t b) { return array + 8 * b; }
+        inline const element* block(size_t b) const { return array + 8 * b; }
+    };
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_FIXEDVEC_HPP
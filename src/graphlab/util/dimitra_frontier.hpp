@@ -0,0 +1,191 @@
+#ifndef GRAPHLAB_DIMITRA_FRONTIER_HPP
+#define GRAPHLAB_DIMITRA_FRONTIER_HPP
+
+#include <algorithm>
+#include <vector>
+#include <graphlab/parallel/atomic.hpp>
+#include <graphlab/util/dense_bitset.hpp>
+
+namespace graphlab {
+
+    /**
+     * \brief A per-vertex bitset of an engine (the active vertices, the
+     * vertices with a message, ...) which is cheap to scan and to clear
+     * when only a few of its bits are set.
+     *
+     * The bits are held in 64-bit words like a graphlab::dense_bitset,
+     * with the same atomic set_bit() and clear_bit().  In addition, each
+     * word which becomes non-zero after the last clear() is appended to
+     * a list, as long as the list holds at most 1/SPARSE_RATIO of the
+     * words.  While the list has not overflowed, the frontier is sparse:
+     * clear() only zeros the listed words and next_word() only visits
+     * them, in increasing order.  Once it has overflowed, the frontier is
+     * dense until the next clear(), which then zeros all the words, and
+     * next_word() scans all the words like the engines always did.
+     *
+     * Bits set while the threads scan the frontier are not visited by
+     * that scan when it is sparse, so bits must not be set in a bitset
+     * which is being scanned by a phase that expects to see them.
+     */
+    class automi_frontier {
+    public:
+        /// The maximum fraction of words listed by a sparse frontier
+        enum { SPARSE_RATIO = 16 };
+
+        automi_frontier() : len(0), nsorted(0), nscan(0), scan_dense(true) {}
+
+        /**
+         * Resizes to 'n' bits, keeping the existing ones; the new bits are
+         * 0.  The frontier is dense until the next clear().
+         */
+        void resize(size_t n) {
+            len = n;
+            const size_t nwords = (n + WORD_BITS - 1) / WORD_BITS;
+            words.resize(nwords, 0);
+            if (n % WORD_BITS) words[nwords - 1] &= (size_t(1) << (n % WORD_BITS)) - 1;
+            listed.resize(nwords);
+            list.resize(nwords / SPARSE_RATIO);
+            nlisted = list.size() + 1;
+            nsorted = nscan = 0;
+            scan_dense = true;
+        }
+
+        inline size_t size() const { return len; }
+
+        /// Returns true while at most 1/SPARSE_RATIO of the words are listed
+        inline bool is_sparse() const { return nlisted.value <= list.size(); }
+
+        /// Returns the value of bit 'b'
+        inline bool get(size_t b) const {
+            return words[b / WORD_BITS] & (size_t(1) << (b % WORD_BITS));
+        }
+
+        /// Atomically sets bit 'b', returning its old value
+        inline bool set_bit(size_t b) {
+            const size_t w = b / WORD_BITS;
+            const size_t mask = size_t(1) << (b % WORD_BITS);
+            const size_t old = __sync_fetch_and_or(&words[w], mask);
+            if (old == 0 && is_sparse()) list_word(w);
+            return old & mask;
+        }
+
+        /// Atomically clears bit 'b', returning its old value
+        inline bool clear_bit(size_t b) {
+            const size_t mask = size_t(1) << (b % WORD_BITS);
+            return __sync_fetch_and_and(&words[b / WORD_BITS], ~mask) & mask;
+        }
+
+        /// Returns the word holding bit 'b'
+        inline size_t containing_word(size_t b) const { return words[b / WORD_BITS]; }
+
+        /// Clears all the bits, in O(listed words) if sparse
+        void clear() {
+            if (is_sparse()) {
+                for (size_t i = 0; i < nlisted.value; ++i) {
+                    words[list[i]] = 0;
+                    listed.clear_bit_unsync(list[i]);
+                }
+            } else {
+                std::fill(words.begin(), words.end(), 0);
+                listed.clear();
+            }
+            nlisted = 0;
+            nsorted = nscan = 0;
+        }
+
+        /// Sets all the bits; the frontier is dense until the next clear()
+        void fill() {
+            std::fill(words.begin(), words.end(), size_t(-1));
+            if (len % WORD_BITS) words.back() = (size_t(1) << (len % WORD_BITS)) - 1;
+            nlisted = list.size() + 1;
+        }
+
+        /**
+         * Fixes the words visited by next_word() to those holding a bit
+         * now, sorting the listed words if needed.  Called by one thread,
+         * while no bit is set, before the threads scan the frontier.
+         */
+        void prepare_scan() {
+            scan_dense = !is_sparse();
+            if (scan_dense) return;
+            nscan = nlisted.value;
+            if (nsorted != nscan) {
+                std::sort(list.begin(), list.begin() + nscan);
+                nsorted = nscan;
+            }
+        }
+
+        /**
+         * Claims the next non-zero word of the scan prepared by
+         * prepare_scan() for the calling thread.  'counter' is shared by
+         * the scanning threads and is 0 when the scan starts.
+         *
+         * @param [out] block_start the index of the first bit of the word
+         * @param [out] word the bits of the word
+         * @return false once the scan is over
+         */
+        inline bool next_word(atomic<size_t>& counter, size_t& block_start,
+                              size_t& word) const {
+            while (true) {
+                const size_t i = counter.inc_ret_last();
+                if (i >= scan_size()) return false;
+                if (scan_word(i, block_start, word)) return true;
+            }
+        }
+
+        /// Returns true if the prepared scan visits all the words
+        inline bool scan_is_dense() const { return scan_dense; }
+
+        /// Returns the number of words of the prepared scan
+        inline size_t scan_size() const {
+            return scan_dense ? words.size() : nscan;
+        }
+
+        /// Returns the index in the bitset of word 'i' of the prepared scan
+        inline size_t scan_word_index(size_t i) const {
+            return scan_dense ? i : list[i];
+        }
+
+        /**
+         * Reads word 'i' of the prepared scan, for threads which split the
+         * scan among themselves instead of using next_word().
+         *
+         * @return false if the word holds no bit.
+         */
+        inline bool scan_word(size_t i, size_t& block_start, size_t& word) const {
+            const size_t w = scan_word_index(i);
+            word = words[w];
+            block_start = w * WORD_BITS;
+            return word != 0;
+        }
+
+    private:
+        enum { WORD_BITS = 8 * sizeof(size_t) };
+
+        /// Appends word 'w' to the list unless it is already listed
+        inline void list_word(size_t w) {
+            if (listed.set_bit(w)) return;
+            const size_t i = nlisted.inc_ret_last();
+            // past the end the frontier has become dense
+            if (i < list.size()) list[i] = w;
+        }
+
+        size_t len;
+        std::vector<size_t> words;
+        /// The words in the list
+        dense_bitset listed;
+        /// The words which became non-zero since the last clear()
+        std::vector<size_t> list;
+        /// The number of words appended to the list, past its size if dense
+        atomic<size_t> nlisted;
+        /// The length of the sorted prefix of the list
+        size_t nsorted;
+        /// The number of listed words visited by next_word()
+        size_t nscan;
+        /// Set if next_word() scans all the words
+        bool scan_dense;
+    };
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_FRONTIER_HPP
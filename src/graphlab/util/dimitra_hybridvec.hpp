@@ -0,0 +1,518 @@
+#ifndef GRAPHLAB_DIMITRA_HYBRIDVEC_HPP
+#define GRAPHLAB_DIMITRA_HYBRIDVEC_HPP
+
+#include <cstring>
+#include <limits>
+#include <stdint.h>
+#include <utility>
+#include <graphlab/logger/assertions.hpp>
+#include <graphlab/serialization/serialization_includes.hpp>
+#include <graphlab/util/dimitra_bitvec.hpp>
+
+namespace graphlab {
+    /**
+     * Implements a lane vector of int | float | ... whose lanes mostly
+     * hold one fill value, such as the "unreached" distance of the
+     * queries a vertex has not been reached by yet.
+     *
+     * A sparse hybridvec stores a presence mask (automi_bitvec<bool>)
+     * of the lanes which differ from the fill value, and the values of
+     * those lanes packed in lane order.  Once more than 1/DENSE_RATIO
+     * of the lanes are present it switches to a plain automi_bitvec<T>.
+     * The conversions run on the compress / expand kernels of the
+     * selected SIMD backend (see dimitra_simd.hpp).  shrink() goes back
+     * to the sparse form once enough lanes hold the fill value again,
+     * and save() picks the smaller of the two encodings, so a dense
+     * vector which is mostly fill values is still sent sparse.
+     *
+     * The fill value is the identity of the combining operation: the
+     * default, the largest value of T, suits pair_op_min() and
+     * min_into().  Those skip the lanes which are not present, so their
+     * cost follows the number of present lanes rather than size().
+     *
+     * Lane arithmetic goes through densify(), which returns the dense
+     * automi_bitvec<T> to run the usual vec_op_* operators on.
+     *
+     * Invariant: a present lane never holds the fill value.
+     */
+    template <typename T>
+    class automi_hybridvec {
+    public:
+        typedef T element;
+        typedef automi_bitvec<T> dense_type;
+        typedef automi_bitvec<bool> mask_type;
+
+        /// A sparse vector goes dense once more than 1/DENSE_RATIO of its lanes are present
+        static const size_t DENSE_RATIO = 4;
+
+        /// Constructs an empty hybridvec
+        automi_hybridvec() : len(0), fill(std::numeric_limits<T>::max()),
+                             dense_mode(false), packed(NULL), npacked(0), capacity(0) {}
+
+        /// Constructs a hybridvec with 'size' lanes, all holding 'fill_value'
+        explicit automi_hybridvec(size_t size, T fill_value = std::numeric_limits<T>::max())
+            : len(size), fill(fill_value), dense_mode(false), present(size),
+              packed(NULL), npacked(0), capacity(0) {}
+
+        /// Construct a copy of hybridvec hv
+        automi_hybridvec(const automi_hybridvec<T>& hv)
+            : len(0), fill(hv.fill), dense_mode(false), packed(NULL), npacked(0), capacity(0) {
+            *this = hv;
+        }
+
+        /// Takes over the lanes of hybridvec hv, leaving it empty
+        automi_hybridvec(automi_hybridvec<T>&& hv)
+            : len(hv.len), fill(hv.fill), dense_mode(hv.dense_mode),
+              dense(std::move(hv.dense)), present(std::move(hv.present)),
+              packed(hv.packed), npacked(hv.npacked), capacity(hv.capacity) {
+            hv.len = 0;
+            hv.dense_mode = false;
+            hv.packed = NULL;
+            hv.npacked = 0;
+            hv.capacity = 0;
+        }
+
+        /// destructor
+        ~automi_hybridvec() { automi_lane_free(packed, sizeof(element) * capacity); }
+
+        /// Make a new copy of the hybridvec hv
+        inline automi_hybridvec<T>& operator=(const automi_hybridvec<T>& hv) {
+            if (this == &hv) return *this;
+            len = hv.len;
+            fill = hv.fill;
+            dense_mode = hv.dense_mode;
+            if (dense_mode) {
+                dense = hv.dense;
+                release_sparse();
+            } else {
+                dense = dense_type();
+                present = hv.present;
+                reserve(hv.npacked);
+                npacked = hv.npacked;
+                if (npacked > 0) memcpy(packed, hv.packed, sizeof(element) * npacked);
+            }
+            return *this;
+        }
+
+        /// Swaps the lanes with hybridvec hv, which releases the old lanes of this one
+        inline automi_hybridvec<T>& operator=(automi_hybridvec<T>&& hv) {
+            std::swap(len, hv.len);
+            std::swap(fill, hv.fill);
+            std::swap(dense_mode, hv.dense_mode);
+            std::swap(dense, hv.dense);
+            std::swap(present, hv.present);
+            std::swap(packed, hv.packed);
+            std::swap(npacked, hv.npacked);
+            std::swap(capacity, hv.capacity);
+            return *this;
+        }
+
+        /// Returns the number of lanes in this hybridvec
+        inline size_t size() const {
+            return len;
+        }
+
+        /// Returns the value of the lanes which are not present
+        inline T fill_value() const {
+            return fill;
+        }
+
+        /// Returns true if the lanes are stored as a dense automi_bitvec<T>
+        inline bool is_dense() const {
+            return dense_mode;
+        }
+
+        /// Returns the number of lanes not holding the fill value
+        inline size_t count() const {
+            if (!dense_mode) return npacked;
+            mask_type mask;
+            return nonfill_lanes(dense, mask);
+        }
+
+        /// Sets 'ret' to the lanes not holding the fill value
+        inline void present_lanes(mask_type& ret) const {
+            if (dense_mode) nonfill_lanes(dense, ret);
+            else ret = present;
+        }
+
+        /**
+         * Changes the number of lanes; new lanes hold the fill value and
+         * the lanes past 'n' are dropped.
+         */
+        inline void resize(size_t n) {
+            const size_t old_len = len;
+            len = n;
+            if (dense_mode) {
+                dense.resize(n);
+                for (size_t i = old_len; i < n; i++) dense.set_single(fill, i);
+            } else {
+                present.resize(n);
+                npacked = present.count();
+            }
+        }
+
+        /// Sets all lanes back to the fill value, going sparse
+        inline void clear() {
+            dense_mode = false;
+            dense = dense_type();
+            present = mask_type(len);
+            npacked = 0;
+        }
+
+        /// Set all lanes value using provided val
+        inline void set_all(T val) {
+            if (val == fill) {
+                clear();
+                return;
+            }
+            densify().set_all(val);
+        }
+
+        /// Get one single lane value
+        inline T get_single(size_t b) const {
+            if (dense_mode) return dense.array[b];
+            if (!present.test_bit(b)) return fill;
+            return packed[rank(b)];
+        }
+
+        /// Set one lane value using provided val and idx
+        inline void set_single(T val, size_t idx) {
+            if (dense_mode) {
+                dense.set_single(val, idx);
+                return;
+            }
+            const size_t r = rank(idx);
+            if (present.test_bit(idx)) {
+                if (val != fill) {
+                    packed[r] = val;
+                    return;
+                }
+                memmove(packed + r, packed + r + 1, sizeof(element) * (npacked - r - 1));
+                --npacked;
+                present.set_single(false, idx);
+                return;
+            }
+            if (val == fill) return;
+            reserve(npacked + 1);
+            memmove(packed + r + 1, packed + r, sizeof(element) * (npacked - r));
+            packed[r] = val;
+            ++npacked;
+            present.set_single(true, idx);
+            if (npacked * DENSE_RATIO > len) densify();
+        }
+
+        /**
+         * Sets the lanes of 'mask' to the lanes of 'src' and the others
+         * to the fill value, packing the lanes with the compress kernel.
+         */
+        inline void assign_mask(const mask_type& mask, const dense_type& src) {
+            len = src.size();
+            mask_type lanes;
+            nonfill_lanes(src, lanes);
+            lanes.bits().bit_and(lanes.words(), lanes.words(), mask.words(), lanes.num_words());
+            const size_t k = lanes.count();
+            if (k * DENSE_RATIO > len) {
+                dense_mode = true;
+                dense = dense_type(len);
+                dense.set_all(fill);
+                dense.vec_op_set_mask(lanes, src);
+                release_sparse();
+                return;
+            }
+            dense_mode = false;
+            dense = dense_type();
+            present = std::move(lanes);
+            reserve(k);
+            npacked = ops().compress(packed, present.array, src.array, 8 * src.arrlen);
+        }
+
+        /**
+         * Switches to the dense form, expanding the packed lanes, and
+         * returns it for the vec_op_* operators of automi_bitvec<T>.
+         */
+        inline dense_type& densify() {
+            if (dense_mode) return dense;
+            dense = dense_type(len);
+            dense.set_all(fill);
+            if (npacked > 0) ops().expand(dense.array, present.array, packed, 8 * dense.arrlen);
+            dense_mode = true;
+            release_sparse();
+            return dense;
+        }
+
+        /// Switches back to the sparse form if few enough lanes hold other than the fill value
+        inline void shrink() {
+            if (!dense_mode) return;
+            mask_type lanes;
+            const size_t k = nonfill_lanes(dense, lanes);
+            if (k * DENSE_RATIO > len) return;
+            present = std::move(lanes);
+            reserve(k);
+            npacked = ops().compress(packed, present.array, dense.array, 8 * dense.arrlen);
+            dense = dense_type();
+            dense_mode = false;
+        }
+
+        /**
+         * Keeps the lanes set in 'keep', moved down to the lowest lanes in
+         * order, and shrinks this hybridvec to them.
+         */
+        inline void compact(const mask_type& keep) {
+            if (dense_mode) {
+                dense.compact(keep);
+                len = dense.size();
+                return;
+            }
+            const size_t n = len < keep.len ? len : keep.len;
+            mask_type kept_lanes(n);
+            size_t kept = 0, k = 0, out = 0;
+            for (size_t i = 0; i < n; i++) {
+                const bool is_present = present.test_bit(i);
+                if (keep.test_bit(i)) {
+                    if (is_present) {
+                        packed[out++] = packed[k];
+                        kept_lanes.set_single(true, kept);
+                    }
+                    ++kept;
+                }
+                if (is_present) ++k;
+            }
+            kept_lanes.resize(kept);
+            present = std::move(kept_lanes);
+            len = kept;
+            npacked = out;
+        }
+
+        /**
+         * In-place pairwise Min Operator.  Two sparse vectors are merged
+         * on their present lanes; the result goes dense if too many are.
+         */
+        static void pair_op_min(automi_hybridvec<T>& a, const automi_hybridvec<T>& b) {
+            if (b.dense_mode) {
+                dense_type::pair_op_min(a.densify(), b.dense);
+                return;
+            }
+            if (b.npacked == 0) return;
+            if (a.dense_mode) {
+                b.min_into(a.dense);
+                return;
+            }
+            mask_type lanes(a.present);
+            lanes.vec_op_or_update(b.present);
+            const size_t k = lanes.count();
+            if (k * DENSE_RATIO > a.len) {
+                b.min_into(a.densify());
+                return;
+            }
+            element* merged = (element*)automi_lane_alloc(sizeof(element) * k);
+            const uint64_t* aw = a.present.words();
+            const uint64_t* bw = b.present.words();
+            size_t ia = 0, ib = 0, out = 0;
+            for (size_t w = 0; w < lanes.num_words(); w++) {
+                for (uint64_t bits = aw[w] | bw[w]; bits != 0; bits &= bits - 1) {
+                    const uint64_t bit = bits & (~bits + 1);
+                    if ((aw[w] & bit) && (bw[w] & bit)) {
+                        const element x = a.packed[ia++], y = b.packed[ib++];
+                        merged[out++] = y < x ? y : x;
+                    } else if (aw[w] & bit) {
+                        merged[out++] = a.packed[ia++];
+                    } else {
+                        merged[out++] = b.packed[ib++];
+                    }
+                }
+            }
+            automi_lane_free(a.packed, sizeof(element) * a.capacity);
+            a.packed = merged;
+            a.capacity = k;
+            a.npacked = k;
+            a.present = std::move(lanes);
+        }
+
+        /// d = min(d, this) on the present lanes
+        inline void min_into(dense_type& d) const {
+            if (dense_mode) {
+                dense_type::pair_op_min(d, dense);
+                return;
+            }
+            const uint64_t* w = present.words();
+            size_t k = 0;
+            for (size_t i = 0; i < present.num_words(); i++) {
+                for (uint64_t bits = w[i]; bits != 0; bits &= bits - 1) {
+                    const size_t lane = 64 * i + __builtin_ctzll(bits);
+                    if (packed[k] < d.array[lane]) d.array[lane] = packed[k];
+                    ++k;
+                }
+            }
+        }
+
+        /**
+         * d = min(d, this) on the present lanes, setting 'changed' to the
+         * lanes of d which decreased.  Returns true if one did.
+         */
+        inline bool min_into(dense_type& d, mask_type& changed) const {
+            changed = mask_type(len);
+            if (dense_mode) {
+                const bool any = ops().min_gt(d.array, changed.array, dense.array, 8 * d.arrlen);
+                changed.clear_tail();
+                return any && changed.vec_any();
+            }
+            const uint64_t* w = present.words();
+            uint64_t* cw = changed.words();
+            size_t k = 0;
+            bool any = false;
+            for (size_t i = 0; i < present.num_words(); i++) {
+                for (uint64_t bits = w[i]; bits != 0; bits &= bits - 1) {
+                    const size_t lane = 64 * i + __builtin_ctzll(bits);
+                    if (packed[k] < d.array[lane]) {
+                        d.array[lane] = packed[k];
+                        cw[i] |= bits & (~bits + 1);
+                        any = true;
+                    }
+                    ++k;
+                }
+            }
+            return any;
+        }
+
+        /// Serializes this hybridvec, sparse if few enough lanes are present
+        inline void save(oarchive& oarc) const {
+            oarc << len << fill;
+            if (!dense_mode) {
+                save_sparse(oarc, present, packed, npacked);
+                return;
+            }
+            mask_type lanes;
+            const size_t k = nonfill_lanes(dense, lanes);
+            if (k * DENSE_RATIO > len) {
+                oarc << true << dense;
+                return;
+            }
+            element* buf = (element*)automi_lane_alloc(sizeof(element) * k);
+            ops().compress(buf, lanes.array, dense.array, 8 * dense.arrlen);
+            save_sparse(oarc, lanes, buf, k);
+            automi_lane_free(buf, sizeof(element) * k);
+        }
+
+        /**
+         * Masked Serialization, in the format of automi_bitvec<T>::masked_save.
+         * A sparse hybridvec masked with its present lanes sends its packed
+         * lanes as they are.
+         */
+        inline void masked_save(oarchive& oarc, const mask_type& mask) const {
+            if (dense_mode) {
+                dense.masked_save(oarc, mask);
+                return;
+            }
+            if (mask.len == len && memcmp(mask.array, present.array, mask.arrlen) == 0) {
+                oarc << len;
+                oarc.write(reinterpret_cast<const char*>(&npacked), sizeof(size_t));
+                if (npacked > 0) serialize(oarc, packed, sizeof(element) * npacked);
+                return;
+            }
+            automi_hybridvec<T> tmp(*this);
+            tmp.densify().masked_save(oarc, mask);
+        }
+
+        /// Masked Deserialization (coupled with masked_save), the other lanes are kept
+        inline void masked_load(iarchive& iarc, const mask_type& mask) {
+            if (dense_mode || npacked > 0) {
+                densify().masked_load(iarc, mask);
+                len = dense.size();
+                shrink();
+                return;
+            }
+            // all lanes hold the fill value: the masked lanes become the packed ones
+            size_t k = 0;
+            iarc >> len;
+            iarc.read(reinterpret_cast<char*>(&k), sizeof(size_t));
+            present = mask;
+            reserve(k);
+            npacked = k;
+            if (k > 0) deserialize(iarc, packed, sizeof(element) * k);
+            for (size_t i = 0; i < k; i++) {
+                if (packed[i] == fill) {
+                    densify();
+                    break;
+                }
+            }
+            if (dense_mode) shrink();
+            else if (npacked * DENSE_RATIO > len) densify();
+        }
+
+        /// Deserializes this hybridvec from an archive
+        inline void load(iarchive& iarc) {
+            iarc >> len >> fill >> dense_mode;
+            if (dense_mode) {
+                iarc >> dense;
+                release_sparse();
+                return;
+            }
+            dense = dense_type();
+            size_t k;
+            iarc >> present >> k;
+            reserve(k);
+            npacked = k;
+            if (k > 0) deserialize(iarc, packed, sizeof(element) * k);
+        }
+
+    private:
+        size_t len;
+        T fill;
+        bool dense_mode;
+        /// The lanes of a dense hybridvec, empty while sparse
+        dense_type dense;
+        /// The present lanes of a sparse hybridvec, empty while dense
+        mask_type present;
+        /// The values of the present lanes, in lane order
+        element* packed;
+        size_t npacked;
+        size_t capacity;
+
+        /// The kernels of the selected SIMD backend
+        inline static const automi_lane_kernels<element>& ops() {
+            return automi_simd_lanes<element>::get();
+        }
+
+        /// Returns the number of present lanes below lane 'b'
+        inline size_t rank(size_t b) const {
+            const uint64_t* w = present.words();
+            size_t r = present.bits().popcount(w, b / 64);
+            if (b % 64 != 0) r += __builtin_popcountll(w[b / 64] & ((uint64_t(1) << (b % 64)) - 1));
+            return r;
+        }
+
+        /// Makes room for 'k' packed lanes
+        inline void reserve(size_t k) {
+            if (k <= capacity) return;
+            size_t cap = capacity < 8 ? 8 : capacity;
+            while (cap < k) cap *= 2;
+            packed = (element*)automi_lane_realloc(packed, sizeof(element) * capacity, sizeof(element) * cap);
+            capacity = cap;
+        }
+
+        /// Drops the sparse form
+        inline void release_sparse() {
+            present = mask_type();
+            npacked = 0;
+        }
+
+        /// Sets 'ret' to the lanes of 'src' not holding the fill value, returns their number
+        inline size_t nonfill_lanes(const dense_type& src, mask_type& ret) const {
+            dense_type fills(src.size());
+            fills.set_all(fill);
+            ret = mask_type(src.size());
+            ops().cmpneq(ret.array, src.array, fills.array, 8 * src.arrlen);
+            ret.clear_tail();
+            return ret.count();
+        }
+
+        static void save_sparse(oarchive& oarc, const mask_type& lanes,
+                                const element* values, size_t k) {
+            oarc << false << lanes << k;
+            if (k > 0) serialize(oarc, values, sizeof(element) * k);
+        }
+    };
+
+} // namespace graphlab
+
+#endif  // GRAPHLAB_DIMITRA_HYBRIDVEC_HPP
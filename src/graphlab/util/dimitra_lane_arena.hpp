@@ -0,0 +1,138 @@
+#ifndef GRAPHLAB_DIMITRA_LANE_ARENA_HPP
+#define GRAPHLAB_DIMITRA_LANE_ARENA_HPP
+
+#include <cstdlib>
+#include <string>
+#include <graphlab/logger/logger.hpp>
+#include <graphlab/util/dimitra_lane_pool.hpp>
+
+namespace graphlab {
+
+    /// The placement of the rows of an automi_lane_arena
+    enum automi_lane_layout {
+        /// The rows of consecutive lvids back to back
+        AUTOMI_LANES_PACKED,
+        /// Each row padded to whole cache lines, so no two rows share a line
+        AUTOMI_LANES_ALIGNED
+    };
+
+    /**
+     * Parses "packed" or "aligned" into 'layout'; returns false otherwise.
+     */
+    inline bool automi_parse_lane_layout(const std::string& name,
+                                         automi_lane_layout& layout) {
+        if (name == "packed") layout = AUTOMI_LANES_PACKED;
+        else if (name == "aligned") layout = AUTOMI_LANES_ALIGNED;
+        else return false;
+        return true;
+    }
+
+    /**
+     * \brief A graph-wide, lane-major store of one lane vector field of
+     * the vertex data.
+     *
+     * By default each vertex owns its lane vector (graphlab::automi_bitvec)
+     * as a separate heap buffer.  bind() moves the field of every local
+     * vertex into one cache-line aligned allocation, with the lanes of
+     * vertex lvid in row lvid, and leaves each vertex data with a view of
+     * its row: vertex.data() is unchanged for the vertex program, but a
+     * sweep over the vertices in lvid order reads contiguous memory.
+     *
+     * The views keep working through assignments, serialization and lane
+     * compaction.  A view which grows past its row moves its lanes back to
+     * the heap.  The arena must outlive the vertex data it is bound to, so
+     * it is declared before the graph.
+     *
+     * \code
+     * graphlab::automi_lane_arena ans_arena;
+     * graph_type graph(dc, clopts);
+     * ...
+     * graph.finalize();
+     * ans_arena.bind(graph, &vertex_data::ans, graphlab::AUTOMI_LANES_PACKED);
+     * \endcode
+     */
+    class automi_lane_arena {
+    public:
+        automi_lane_arena() : base(NULL), nrows(0), stride(0) {}
+
+        ~automi_lane_arena() { release(); }
+
+        /**
+         * Allocates 'rows' rows of 'row_bytes' bytes in one block, releasing
+         * the previous ones.  The rows are not initialized.
+         */
+        void reserve(size_t rows, size_t row_bytes, automi_lane_layout layout) {
+            release();
+            stride = layout == AUTOMI_LANES_ALIGNED
+                     ? (row_bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE
+                     : row_bytes;
+            nrows = rows;
+            if (bytes() == 0) return;
+            void* ptr = NULL;
+            if (posix_memalign(&ptr, CACHE_LINE, bytes()) != 0) {
+                logstream(LOG_FATAL) << "Cannot allocate a lane arena of "
+                                     << bytes() << " bytes" << std::endl;
+            }
+            base = reinterpret_cast<char*>(ptr);
+            automi_lane_register_arena(base, bytes());
+        }
+
+        /// Frees the rows; nothing may still view them
+        void release() {
+            if (base == NULL) return;
+            automi_lane_unregister_arena(base);
+            free(base);
+            base = NULL;
+            nrows = 0;
+            stride = 0;
+        }
+
+        /// Returns row 'i'
+        inline void* row(size_t i) { return base + i * stride; }
+
+        inline size_t num_rows() const { return nrows; }
+
+        /// Returns the distance in bytes between consecutive rows
+        inline size_t row_stride() const { return stride; }
+
+        /// Returns the bytes allocated for all the rows
+        inline size_t bytes() const { return nrows * stride; }
+
+        /**
+         * Moves the lane vector 'field' of the data of every local vertex of
+         * 'graph' to row lvid of this arena.  Call after graph.finalize().
+         */
+        template <typename Graph, typename VertexData, typename Vec>
+        void bind(Graph& graph, Vec VertexData::* field, automi_lane_layout layout) {
+            const size_t n = graph.num_local_vertices();
+            size_t row_bytes = 0;
+            for (size_t lvid = 0; lvid < n; ++lvid) {
+                const size_t b = (graph.l_vertex(lvid).data().*field).storage_size();
+                if (b > row_bytes) row_bytes = b;
+            }
+            reserve(n, row_bytes, layout);
+            if (bytes() == 0) return;
+            // each thread first touches the rows it binds
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int lvid = 0; lvid < (int)n; ++lvid) {
+                (graph.l_vertex(lvid).data().*field).bind_storage(row(lvid));
+            }
+        }
+
+    private:
+        enum { CACHE_LINE = 64 };
+
+        char* base;
+        size_t nrows;
+        size_t stride;
+
+        // not copyable: the vertex data views the rows
+        automi_lane_arena(const automi_lane_arena&);
+        automi_lane_arena& operator=(const automi_lane_arena&);
+    };
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_LANE_ARENA_HPP
@@ -0,0 +1,104 @@
+#ifndef GRAPHLAB_DIMITRA_LANE_DELTA_HPP
+#define GRAPHLAB_DIMITRA_LANE_DELTA_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <graphlab/serialization/serialization_includes.hpp>
+#include <graphlab/util/dimitra_bitvec.hpp>
+
+namespace graphlab {
+
+    /**
+     * \brief Some lanes of a value sent by an engine exchange (the lanes
+     * of the vertex data changed by apply, the lanes of a message which
+     * carry a value): a lane mask, and the masked_save() of these lanes.
+     *
+     * On the sending side the delta only points to the value, set by
+     * set_source(), and save() calls its masked_save() straight into the
+     * buffer of the exchange, behind the mask and the byte length of the
+     * lanes.  The value must outlive the send() of the delta, which
+     * serializes it.  On the receiving side load() keeps the serialized
+     * lanes, which load_lanes() reads into the target value with its
+     * masked_load().
+     *
+     * The lanes are serialized through a function pointer, so the value
+     * type only needs masked_save() where set_source() is called.
+     */
+    class automi_lane_delta {
+    public:
+        typedef automi_bitvec<bool> mask_type;
+
+        /// The lanes carried by the delta
+        mask_type mask;
+
+        automi_lane_delta() : source(NULL), save_lanes(NULL) {}
+
+        /// Sends the lanes of 'value' in the mask
+        template <typename T>
+        void set_source(const T& value) {
+            source = &value;
+            save_lanes = &masked_save_of<T>;
+        }
+
+        /// Reads the received lanes into 'value', keeping its other lanes
+        template <typename T>
+        void load_lanes(T& value) const {
+            iarchive iarc(lanes.data(), lanes.size());
+            value.masked_load(iarc, mask);
+        }
+
+        void save(oarchive& oarc) const {
+            oarc << mask;
+            // the length is written raw, so that it can be patched
+            if (source == NULL) {
+                // a received delta sends the lanes it holds
+                save_length(oarc, lanes.size());
+                oarc.write(lanes.data(), lanes.size());
+            } else if (oarc.out != NULL) {
+                // the length of the lanes cannot be patched in a stream
+                oarchive tmp;
+                save_lanes(tmp, source, mask);
+                save_length(oarc, tmp.off);
+                oarc.write(tmp.buf, tmp.off);
+                free(tmp.buf);
+            } else {
+                const size_t len_off = oarc.off;
+                oarc.advance(sizeof(size_t));
+                save_lanes(oarc, source, mask);
+                const size_t len = oarc.off - len_off - sizeof(size_t);
+                memcpy(oarc.buf + len_off, &len, sizeof(size_t));
+            }
+        }
+
+        void load(iarchive& iarc) {
+            source = NULL;
+            save_lanes = NULL;
+            iarc >> mask;
+            size_t len = 0;
+            iarc.read(reinterpret_cast<char*>(&len), sizeof(size_t));
+            lanes.resize(len);
+            if (len > 0) iarc.read(&lanes[0], len);
+        }
+
+    private:
+        static void save_length(oarchive& oarc, size_t len) {
+            oarc.write(reinterpret_cast<const char*>(&len), sizeof(size_t));
+        }
+
+        template <typename T>
+        static void masked_save_of(oarchive& oarc, const void* value,
+                                   const mask_type& mask) {
+            static_cast<const T*>(value)->masked_save(oarc, mask);
+        }
+
+        /// The value whose lanes are sent, NULL once received
+        const void* source;
+        void (*save_lanes)(oarchive&, const void*, const mask_type&);
+        /// The serialized lanes, once received
+        std::string lanes;
+    };
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_LANE_DELTA_HPP
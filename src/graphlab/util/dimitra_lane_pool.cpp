@@ -0,0 +1,169 @@
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+
+#include <graphlab/logger/logger.hpp>
+#include <graphlab/util/branch_hints.hpp>
+#include <graphlab/util/dimitra_lane_pool.hpp>
+
+namespace graphlab {
+
+    namespace {
+
+        /// The smallest size class holds 2^MIN_CLASS_SHIFT bytes
+        const size_t MIN_CLASS_SHIFT = 4;
+        /// The largest size class holds 2^MAX_CLASS_SHIFT bytes
+        const size_t MAX_CLASS_SHIFT = 16;
+        const size_t NUM_CLASSES = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+        /// Bytes kept on the free list of one size class of one thread
+        const size_t MAX_POOLED_BYTES = size_t(1) << 22;
+
+        /// A free buffer, linked through its first bytes
+        struct free_buffer {
+            free_buffer* next;
+        };
+
+        struct lane_pool {
+            free_buffer* head[NUM_CLASSES];
+            size_t count[NUM_CLASSES];
+        };
+
+        /// Returns the size class of 'bytes', or NUM_CLASSES if too large
+        inline size_t size_class(size_t bytes) {
+            size_t c = 0;
+            while (c < NUM_CLASSES && (size_t(1) << (c + MIN_CLASS_SHIFT)) < bytes) ++c;
+            return c;
+        }
+
+        inline size_t class_bytes(size_t c) {
+            return size_t(1) << (c + MIN_CLASS_SHIFT);
+        }
+
+        /// The pool of this thread, cached to avoid pthread_getspecific
+        __thread lane_pool* thread_pool = NULL;
+
+        void destroy_lane_pool(void* ptr) {
+            lane_pool* pool = reinterpret_cast<lane_pool*>(ptr);
+            for (size_t c = 0; c < NUM_CLASSES; ++c) {
+                while (pool->head[c] != NULL) {
+                    free_buffer* buf = pool->head[c];
+                    pool->head[c] = buf->next;
+                    free(buf);
+                }
+            }
+            free(pool);
+            // buffers released by later thread-exit destructors get a new pool
+            thread_pool = NULL;
+        }
+
+        pthread_key_t create_lane_pool_key() {
+            pthread_key_t key;
+            pthread_key_create(&key, destroy_lane_pool);
+            return key;
+        }
+
+        /// Frees the pool of a thread when the thread exits
+        pthread_key_t lane_pool_key = create_lane_pool_key();
+
+        inline lane_pool& get_lane_pool() {
+            if (__unlikely__(thread_pool == NULL)) {
+                thread_pool = reinterpret_cast<lane_pool*>(calloc(1, sizeof(lane_pool)));
+                pthread_setspecific(lane_pool_key, thread_pool);
+            }
+            return *thread_pool;
+        }
+
+        /// The most arenas registered at once
+        const size_t MAX_LANE_ARENAS = 16;
+
+        struct arena_range {
+            const char* begin;
+            const char* end;
+        };
+
+        arena_range lane_arenas[MAX_LANE_ARENAS];
+        size_t num_lane_arenas = 0;
+
+    } // anonymous namespace
+
+    void automi_lane_register_arena(const void* begin, size_t bytes) {
+        if (num_lane_arenas == MAX_LANE_ARENAS) {
+            logstream(LOG_FATAL) << "Too many lane arenas" << std::endl;
+        }
+        lane_arenas[num_lane_arenas].begin = reinterpret_cast<const char*>(begin);
+        lane_arenas[num_lane_arenas].end = reinterpret_cast<const char*>(begin) + bytes;
+        ++num_lane_arenas;
+    }
+
+    void automi_lane_unregister_arena(const void* begin) {
+        for (size_t i = 0; i < num_lane_arenas; ++i) {
+            if (lane_arenas[i].begin == begin) {
+                lane_arenas[i] = lane_arenas[--num_lane_arenas];
+                return;
+            }
+        }
+    }
+
+    bool automi_lane_in_arena(const void* ptr) {
+        const char* p = reinterpret_cast<const char*>(ptr);
+        for (size_t i = 0; i < num_lane_arenas; ++i) {
+            if (p >= lane_arenas[i].begin && p < lane_arenas[i].end) return true;
+        }
+        return false;
+    }
+
+    void* automi_lane_alloc(size_t bytes) {
+        if (bytes == 0) return NULL;
+        const size_t c = size_class(bytes);
+        if (c == NUM_CLASSES) return malloc(bytes);
+        lane_pool& pool = get_lane_pool();
+        free_buffer* buf = pool.head[c];
+        if (buf == NULL) return malloc(class_bytes(c));
+        pool.head[c] = buf->next;
+        --pool.count[c];
+        return buf;
+    }
+
+    void automi_lane_free(void* ptr, size_t bytes) {
+        if (ptr == NULL) return;
+        if (__unlikely__(num_lane_arenas > 0) && automi_lane_in_arena(ptr)) return;
+        const size_t c = size_class(bytes);
+        if (c == NUM_CLASSES) {
+            free(ptr);
+            return;
+        }
+        lane_pool& pool = get_lane_pool();
+        if (pool.count[c] * class_bytes(c) >= MAX_POOLED_BYTES) {
+            free(ptr);
+            return;
+        }
+        free_buffer* buf = reinterpret_cast<free_buffer*>(ptr);
+        buf->next = pool.head[c];
+        pool.head[c] = buf;
+        ++pool.count[c];
+    }
+
+    void* automi_lane_realloc(void* ptr, size_t old_bytes, size_t new_bytes) {
+        if (__unlikely__(num_lane_arenas > 0) && ptr != NULL && automi_lane_in_arena(ptr)) {
+            // shrink in place, grow out of the arena
+            if (new_bytes <= old_bytes && new_bytes > 0) return ptr;
+            void* buf = automi_lane_alloc(new_bytes);
+            if (buf != NULL) memcpy(buf, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+            return buf;
+        }
+        if (ptr != NULL && new_bytes > 0) {
+            const size_t c = size_class(new_bytes);
+            if (c < NUM_CLASSES && c == size_class(old_bytes)) return ptr;
+            if (c == NUM_CLASSES && size_class(old_bytes) == NUM_CLASSES) {
+                return realloc(ptr, new_bytes);
+            }
+        }
+        void* buf = automi_lane_alloc(new_bytes);
+        if (ptr != NULL) {
+            if (buf != NULL) memcpy(buf, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+            automi_lane_free(ptr, old_bytes);
+        }
+        return buf;
+    }
+
+}
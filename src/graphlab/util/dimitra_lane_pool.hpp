@@ -0,0 +1,57 @@
+#ifndef GRAPHLAB_DIMITRA_LANE_POOL_HPP
+#define GRAPHLAB_DIMITRA_LANE_POOL_HPP
+
+#include <cstddef>
+
+/**
+ * Per-thread pool of lane buffers for the AutoMI lane vectors
+ * (see graphlab::automi_bitvec).
+ *
+ * Buffers are grouped in power-of-two size classes from 16 bytes to
+ * 64KB.  A released buffer is kept on a free list of the releasing
+ * thread and handed out again by the next allocation of the same class
+ * on that thread, so the messages and accumulators created and dropped
+ * during a superstep recycle each other's storage instead of going
+ * through malloc/free.  Each free list is bounded, and larger buffers
+ * bypass the pool.
+ *
+ * A buffer may be released by a different thread than the one which
+ * allocated it; the caller passes the size it was requested with.
+ *
+ * Lane vectors may also borrow their lanes from a registered arena (see
+ * graphlab::automi_lane_arena).  Releasing such lanes is a no-op, and
+ * reallocating them to a larger size copies them out of the arena.
+ */
+
+namespace graphlab {
+
+    /// Returns a buffer of at least 'bytes' bytes, or NULL if 'bytes' is 0
+    void* automi_lane_alloc(size_t bytes);
+
+    /// Returns the buffer 'ptr' of 'bytes' bytes to the pool
+    void automi_lane_free(void* ptr, size_t bytes);
+
+    /**
+     * \brief Resizes the buffer 'ptr' of 'old_bytes' bytes to
+     * 'new_bytes' bytes, keeping its first min(old_bytes, new_bytes)
+     * bytes.  The buffer is reused in place if both sizes fall in the
+     * same size class.
+     */
+    void* automi_lane_realloc(void* ptr, size_t old_bytes, size_t new_bytes);
+
+    /**
+     * \brief Registers the arena [begin, begin + bytes), whose lanes are
+     * never released to the pool.  Arenas are registered and unregistered
+     * while no lane vector is allocated or released by other threads.
+     */
+    void automi_lane_register_arena(const void* begin, size_t bytes);
+
+    /// Unregisters the arena starting at 'begin'
+    void automi_lane_unregister_arena(const void* begin);
+
+    /// Returns true if 'ptr' lies in a registered arena
+    bool automi_lane_in_arena(const void* ptr);
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_LANE_POOL_HPP
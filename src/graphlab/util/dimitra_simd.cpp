@@ -0,0 +1,92 @@
+#include <cstdlib>
+#include <cstring>
+
+#include <graphlab/logger/logger.hpp>
+#include <graphlab/util/dimitra_simd_kernels.hpp>
+
+namespace graphlab {
+
+    const automi_simd_kernels* automi_simd_active = NULL;
+
+    namespace automi_simd_backends {
+        const automi_simd_kernels* scalar() {
+            static const automi_simd_kernels kernels =
+                make_simd_kernels<scalar_backend>(AUTOMI_ISA_SCALAR, "scalar");
+            return &kernels;
+        }
+    }
+
+    const char* automi_isa_name(automi_isa_type isa) {
+        switch (isa) {
+            case AUTOMI_ISA_SCALAR: return "scalar";
+            case AUTOMI_ISA_SSE4: return "sse4";
+            case AUTOMI_ISA_AVX2: return "avx2";
+            case AUTOMI_ISA_AVX512: return "avx512";
+            case AUTOMI_ISA_AVX512_ZMM: return "avx512zmm";
+            default: return "unknown";
+        }
+    }
+
+    automi_isa_type automi_detect_isa() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("avx512vl") &&
+            __builtin_cpu_supports("avx512bw") &&
+            __builtin_cpu_supports("avx512dq"))
+            return AUTOMI_ISA_AVX512_ZMM;
+        if (__builtin_cpu_supports("avx2"))
+            return AUTOMI_ISA_AVX2;
+        // the sse4 backend is built with -msse4.2, which also emits popcnt
+        if (__builtin_cpu_supports("sse4.2") &&
+            __builtin_cpu_supports("popcnt"))
+            return AUTOMI_ISA_SSE4;
+#endif
+        return AUTOMI_ISA_SCALAR;
+    }
+
+    const automi_simd_kernels* automi_simd_backend(automi_isa_type isa) {
+        if (isa > automi_detect_isa()) return NULL;
+        switch (isa) {
+            case AUTOMI_ISA_SCALAR: return automi_simd_backends::scalar();
+            case AUTOMI_ISA_SSE4: return automi_simd_backends::sse4();
+            case AUTOMI_ISA_AVX2: return automi_simd_backends::avx2();
+            case AUTOMI_ISA_AVX512: return automi_simd_backends::avx512();
+            case AUTOMI_ISA_AVX512_ZMM: return automi_simd_backends::avx512_zmm();
+            default: return NULL;
+        }
+    }
+
+    bool automi_select_isa(automi_isa_type isa) {
+        const automi_simd_kernels* kernels = automi_simd_backend(isa);
+        if (kernels == NULL) return false;
+        automi_simd_active = kernels;
+        return true;
+    }
+
+    const automi_simd_kernels* automi_simd_init() {
+        int isa = automi_detect_isa();
+        // AUTOMI_ISA can only lower the detected instruction set
+        const char* requested = getenv("AUTOMI_ISA");
+        if (requested != NULL) {
+            int i = 0;
+            for (; i < AUTOMI_ISA_COUNT; ++i) {
+                if (strcmp(requested, automi_isa_name(automi_isa_type(i))) == 0) break;
+            }
+            if (i == AUTOMI_ISA_COUNT) {
+                logstream(LOG_WARNING) << "Unknown AUTOMI_ISA: " << requested << std::endl;
+            } else if (i < isa) {
+                isa = i;
+            }
+        }
+        // fall back to the next backend if this one was not compiled in
+        const automi_simd_kernels* kernels = NULL;
+        for (; kernels == NULL; --isa) {
+            kernels = automi_simd_backend(automi_isa_type(isa));
+        }
+        logstream(LOG_INFO) << "AutoMI SIMD backend: " << kernels->name << std::endl;
+        automi_simd_active = kernels;
+        return kernels;
+    }
+
+}
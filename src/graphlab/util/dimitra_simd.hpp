@@ -0,0 +1,220 @@
+#ifndef GRAPHLAB_DIMITRA_SIMD_HPP
+#define GRAPHLAB_DIMITRA_SIMD_HPP
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <graphlab/util/branch_hints.hpp>
+
+/**
+ * Runtime dispatched SIMD kernels for the AutoMI lane vectors
+ * (see graphlab::automi_bitvec).
+ *
+ * The kernels are compiled once per instruction set in their own
+ * translation unit (dimitra_simd_<isa>.cpp), so the rest of the
+ * library is built for the baseline x86-64 target.  The best backend
+ * supported by the running CPU is selected on first use, and may be
+ * lowered with the AUTOMI_ISA environment variable
+ * (scalar | sse4 | avx2 | avx512 | avx512zmm).
+ *
+ * Both AVX-512 backends need avx512f/vl/bw/dq.  avx512 keeps the lane
+ * vectors on 256-bit registers with mask registers, avx512zmm runs
+ * them on full 512-bit registers (16 int or float lanes per
+ * operation).  avx512zmm is the default; AUTOMI_ISA=avx512 avoids the
+ * 512-bit frequency license on CPUs where it costs more than the
+ * wider registers gain.
+ *
+ * All kernels work on flat lane arrays of n lanes, where n is a
+ * multiple of 8.  Lane masks store 8 lanes per byte, lane i being bit
+ * (i % 8) of byte (i / 8).  Arrays need not be aligned.
+ *
+ * The kernels of whole lane masks (automi_bit_kernels) work on n 64-bit
+ * words instead, lane i being bit (i % 64) of word (i / 64), which is
+ * the same layout on little-endian targets.
+ */
+
+namespace graphlab {
+
+    /// The instruction sets with an AutoMI kernel backend
+    enum automi_isa_type {
+        AUTOMI_ISA_SCALAR = 0,
+        AUTOMI_ISA_SSE4 = 1,
+        AUTOMI_ISA_AVX2 = 2,
+        AUTOMI_ISA_AVX512 = 3,
+        AUTOMI_ISA_AVX512_ZMM = 4,
+        AUTOMI_ISA_COUNT = 5
+    };
+
+    /// The lane-wise kernels of one lane type
+    template <typename T>
+    struct automi_lane_kernels {
+        /// d = v
+        void (*set1)(T* d, T v, size_t n);
+        /// d = m ? s : d
+        void (*blend)(T* d, const uint8_t* m, const T* s, size_t n);
+        /// d = m ? v : d
+        void (*blend1)(T* d, const uint8_t* m, T v, size_t n);
+        /// d = a + b
+        void (*add)(T* d, const T* a, const T* b, size_t n);
+        /// d = a + v
+        void (*add1)(T* d, const T* a, T v, size_t n);
+        /// d = m ? a + b : d
+        void (*add_mask)(T* d, const uint8_t* m, const T* a, const T* b, size_t n);
+        /// d = m ? a + v : d
+        void (*add1_mask)(T* d, const uint8_t* m, const T* a, T v, size_t n);
+        /// d = min(d, a + v)
+        void (*add1_min)(T* d, const T* a, T v, size_t n);
+        /// d = m ? min(d, a + v) : d
+        void (*add1_min_mask)(T* d, const uint8_t* m, const T* a, T v, size_t n);
+        /// d = a * b
+        void (*mul)(T* d, const T* a, const T* b, size_t n);
+        /// d = a * v
+        void (*mul1)(T* d, const T* a, T v, size_t n);
+        /// d = m ? a * v : d
+        void (*mul1_mask)(T* d, const uint8_t* m, const T* a, T v, size_t n);
+        /// d = a / b (floating point lanes only, NULL otherwise)
+        void (*div)(T* d, const T* a, const T* b, size_t n);
+        /// d = a / v (floating point lanes only, NULL otherwise)
+        void (*div1)(T* d, const T* a, T v, size_t n);
+        /// d = m ? d / s : d (floating point lanes only, NULL otherwise)
+        void (*div_mask)(T* d, const uint8_t* m, const T* s, size_t n);
+        /// d = min(a, b)
+        void (*min)(T* d, const T* a, const T* b, size_t n);
+        /// d = max(a, b)
+        void (*max)(T* d, const T* a, const T* b, size_t n);
+        /// o = a > b
+        void (*cmpgt)(uint8_t* o, const T* a, const T* b, size_t n);
+        /// o = a < b
+        void (*cmplt)(uint8_t* o, const T* a, const T* b, size_t n);
+        /// o = a == b
+        void (*cmpeq)(uint8_t* o, const T* a, const T* b, size_t n);
+        /// o = a != b
+        void (*cmpneq)(uint8_t* o, const T* a, const T* b, size_t n);
+        /// o = d > s, d = min(d, s); returns true if any lane of o is set.
+        /// o may be NULL.
+        bool (*min_gt)(T* d, uint8_t* o, const T* s, size_t n);
+        /// o |= m & (d > s), d = m ? min(d, s) : d; returns true if any
+        /// lane was or'ed into o.  o may be NULL.
+        bool (*min_gt_mask)(T* d, const uint8_t* m, uint8_t* o, const T* s, size_t n);
+        /// o = d > a + v, d = min(d, a + v); returns true if any lane of o
+        /// is set.  o may be NULL.
+        bool (*add1_min_gt)(T* d, uint8_t* o, const T* a, T v, size_t n);
+        /// o = d < s, d = max(d, s); returns true if any lane of o is set.
+        /// o may be NULL.
+        bool (*max_lt)(T* d, uint8_t* o, const T* s, size_t n);
+        /// Packs the lanes of s set in m to d[0..k); returns k
+        size_t (*compress)(T* d, const uint8_t* m, const T* s, size_t n);
+        /// Unpacks s[0..k) to the lanes of d set in m; returns k
+        size_t (*expand)(T* d, const uint8_t* m, const T* s, size_t n);
+    };
+
+    /// The kernels of lane masks, on arrays of n 64-bit words
+    struct automi_bit_kernels {
+        /// d = a | b
+        void (*bit_or)(uint64_t* d, const uint64_t* a, const uint64_t* b, size_t n);
+        /// d = a & b
+        void (*bit_and)(uint64_t* d, const uint64_t* a, const uint64_t* b, size_t n);
+        /// d = ~a & b
+        void (*bit_andnot)(uint64_t* d, const uint64_t* a, const uint64_t* b, size_t n);
+        /// d = ~a
+        void (*bit_not)(uint64_t* d, const uint64_t* a, size_t n);
+        /// d = m ? a : d
+        void (*blend)(uint64_t* d, const uint64_t* m, const uint64_t* a, size_t n);
+        /// d = m ? ~a & b : d
+        void (*andnot_mask)(uint64_t* d, const uint64_t* m, const uint64_t* a,
+                            const uint64_t* b, size_t n);
+        /// d |= a; returns true if a bit of d was set
+        bool (*or_update)(uint64_t* d, const uint64_t* a, size_t n);
+        /// d |= m & a; returns true if a bit of d was set
+        bool (*or_update_mask)(uint64_t* d, const uint64_t* m, const uint64_t* a, size_t n);
+        /// Returns the number of set bits of a
+        size_t (*popcount)(const uint64_t* a, size_t n);
+        /// Returns true if a bit of a is set
+        bool (*any)(const uint64_t* a, size_t n);
+        /// Returns true if all the bits of a are set
+        bool (*all)(const uint64_t* a, size_t n);
+        /// Returns the index of the lowest set bit of a, or 64 * n if none
+        size_t (*first_set)(const uint64_t* a, size_t n);
+    };
+
+    /// The kernel table of one backend
+    struct automi_simd_kernels {
+        automi_isa_type isa;
+        const char* name;
+        automi_lane_kernels<int> i32;
+        automi_lane_kernels<float> f32;
+        /// saturating add
+        automi_lane_kernels<int16_t> i16;
+        /// saturating add
+        automi_lane_kernels<uint8_t> u8;
+        automi_lane_kernels<int64_t> i64;
+        automi_lane_kernels<double> f64;
+        automi_bit_kernels bits;
+    };
+
+    /**
+     * \brief Returns the kernel table of a backend, or NULL if the
+     * backend was not compiled in or is not supported by this CPU.
+     */
+    const automi_simd_kernels* automi_simd_backend(automi_isa_type isa);
+
+    /// Returns the best instruction set supported by this CPU
+    automi_isa_type automi_detect_isa();
+
+    /// Returns the name of an instruction set
+    const char* automi_isa_name(automi_isa_type isa);
+
+    /**
+     * \brief Selects the backend used by all lane vectors.  Returns
+     * false, keeping the current backend, if it is not available.
+     */
+    bool automi_select_isa(automi_isa_type isa);
+
+    /// \internal Selects the default backend
+    const automi_simd_kernels* automi_simd_init();
+
+    /// \internal The selected backend, NULL until first use
+    extern const automi_simd_kernels* automi_simd_active;
+
+    /// Returns the kernel table of the selected backend
+    inline const automi_simd_kernels& automi_simd() {
+        const automi_simd_kernels* k = automi_simd_active;
+        if (__unlikely__(k == NULL)) k = automi_simd_init();
+        return *k;
+    }
+
+    /// Returns the selected kernels of lane masks
+    inline const automi_bit_kernels& automi_simd_bits() {
+        return automi_simd().bits;
+    }
+
+    /// Returns the selected kernels for lane type T
+    template <typename T> struct automi_simd_lanes { };
+
+    template <> struct automi_simd_lanes<int> {
+        static const automi_lane_kernels<int>& get() { return automi_simd().i32; }
+    };
+
+    template <> struct automi_simd_lanes<float> {
+        static const automi_lane_kernels<float>& get() { return automi_simd().f32; }
+    };
+
+    template <> struct automi_simd_lanes<int16_t> {
+        static const automi_lane_kernels<int16_t>& get() { return automi_simd().i16; }
+    };
+
+    template <> struct automi_simd_lanes<uint8_t> {
+        static const automi_lane_kernels<uint8_t>& get() { return automi_simd().u8; }
+    };
+
+    template <> struct automi_simd_lanes<int64_t> {
+        static const automi_lane_kernels<int64_t>& get() { return automi_simd().i64; }
+    };
+
+    template <> struct automi_simd_lanes<double> {
+        static const automi_lane_kernels<double>& get() { return automi_simd().f64; }
+    };
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_SIMD_HPP
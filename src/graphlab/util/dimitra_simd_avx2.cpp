@@ -0,0 +1,230 @@
+#include <graphlab/util/dimitra_simd_kernels.hpp>
+
+// compiled with -mavx -mavx2, see src/graphlab/CMakeLists.txt
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace graphlab {
+
+    namespace {
+
+        /// Expands 8 mask bits to 8 lane-wide masks
+        inline __m256i avx2_expand_bits(unsigned m) {
+            const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(int(m)), bits), bits);
+        }
+
+        struct avx2_int_traits {
+            typedef int value_type;
+            typedef __m256i vec;
+            enum { width = 8 };
+            static vec load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(int* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(int v) { return _mm256_set1_epi32(v); }
+            static vec add(vec a, vec b) { return _mm256_add_epi32(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mullo_epi32(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+            static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+            static unsigned movemask(vec v) { return _mm256_movemask_ps(_mm256_castsi256_ps(v)); }
+            static unsigned cmpgt(vec a, vec b) { return movemask(_mm256_cmpgt_epi32(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return movemask(_mm256_cmpgt_epi32(b, a)); }
+            static unsigned cmpeq(vec a, vec b) { return movemask(_mm256_cmpeq_epi32(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b) & 0xFF; }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_blendv_epi8(a, b, avx2_expand_bits(m));
+            }
+        };
+
+        struct avx2_float_traits {
+            typedef float value_type;
+            typedef __m256 vec;
+            enum { width = 8 };
+            static vec load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+            static vec set1(float v) { return _mm256_set1_ps(v); }
+            static vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mul_ps(a, b); }
+            static vec div(vec a, vec b) { return _mm256_div_ps(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_ps(b, a); }
+            static vec max(vec a, vec b) { return _mm256_max_ps(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(avx2_expand_bits(m)));
+            }
+        };
+
+        /// Expands 16 mask bits to 16 16-bit lane masks
+        inline __m256i avx2_expand_bits16(unsigned m) {
+            const __m256i bits = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024,
+                                                   2048, 4096, 8192, 16384, short(0x8000));
+            return _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(short(m)), bits), bits);
+        }
+
+        /// Expands 32 mask bits to 32 byte lane masks
+        inline __m256i avx2_expand_bits8(unsigned m) {
+            // both 128-bit halves hold the 4 mask bytes after the broadcast
+            const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                    2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+            const __m256i bits = _mm256_set1_epi64x(int64_t(0x8040201008040201ULL));
+            const __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(int(m)), spread);
+            return _mm256_cmpeq_epi8(_mm256_and_si256(v, bits), bits);
+        }
+
+        /// The low byte of the products of the byte lanes
+        inline __m256i avx2_mullo_epu8(__m256i a, __m256i b) {
+            const __m256i even = _mm256_mullo_epi16(a, b);
+            const __m256i odd = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+            return _mm256_or_si256(_mm256_and_si256(even, _mm256_set1_epi16(0xFF)),
+                                   _mm256_slli_epi16(odd, 8));
+        }
+
+        struct avx2_int16_traits {
+            typedef int16_t value_type;
+            typedef __m256i vec;
+            enum { width = 16 };
+            static vec load(const int16_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(int16_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(int16_t v) { return _mm256_set1_epi16(v); }
+            static vec add(vec a, vec b) { return _mm256_adds_epi16(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mullo_epi16(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_epi16(a, b); }
+            static vec max(vec a, vec b) { return _mm256_max_epi16(a, b); }
+            static unsigned movemask(vec v) {
+                // the pack interleaves the 128-bit halves: bytes 0-7 and 16-23 hold the lanes
+                const unsigned m = _mm256_movemask_epi8(_mm256_packs_epi16(v, v));
+                return (m & 0xFF) | ((m >> 8) & 0xFF00);
+            }
+            static unsigned cmpgt(vec a, vec b) { return movemask(_mm256_cmpgt_epi16(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return movemask(_mm256_cmpgt_epi16(b, a)); }
+            static unsigned cmpeq(vec a, vec b) { return movemask(_mm256_cmpeq_epi16(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b) & 0xFFFF; }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_blendv_epi8(a, b, avx2_expand_bits16(m));
+            }
+        };
+
+        struct avx2_uint8_traits {
+            typedef uint8_t value_type;
+            typedef __m256i vec;
+            enum { width = 32 };
+            static vec load(const uint8_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(uint8_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(uint8_t v) { return _mm256_set1_epi8(char(v)); }
+            static vec add(vec a, vec b) { return _mm256_adds_epu8(a, b); }
+            static vec mul(vec a, vec b) { return avx2_mullo_epu8(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_epu8(a, b); }
+            static vec max(vec a, vec b) { return _mm256_max_epu8(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b); }
+            // a > b unless max(a, b) == b
+            static unsigned cmpgt(vec a, vec b) { return ~cmpeq(_mm256_max_epu8(a, b), b); }
+            static unsigned cmplt(vec a, vec b) { return cmpgt(b, a); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_blendv_epi8(a, b, avx2_expand_bits8(m));
+            }
+        };
+
+        /// Expands 4 mask bits to 4 64-bit lane masks
+        inline __m256i avx2_expand_bits64(unsigned m) {
+            const __m256i bits = _mm256_setr_epi64x(1, 2, 4, 8);
+            return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(m), bits), bits);
+        }
+
+        /// The low 64 bits of the products of the 64-bit lanes
+        inline __m256i avx2_mullo_epi64(__m256i a, __m256i b) {
+            const __m256i lo = _mm256_mul_epu32(a, b);
+            const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                                   _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+            return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+        }
+
+        struct avx2_int64_traits {
+            typedef int64_t value_type;
+            typedef __m256i vec;
+            enum { width = 4 };
+            static vec load(const int64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(int64_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(int64_t v) { return _mm256_set1_epi64x(v); }
+            static vec add(vec a, vec b) { return _mm256_add_epi64(a, b); }
+            static vec mul(vec a, vec b) { return avx2_mullo_epi64(a, b); }
+            static vec min(vec a, vec b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+            static vec max(vec a, vec b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+            static unsigned movemask(vec v) { return _mm256_movemask_pd(_mm256_castsi256_pd(v)); }
+            static unsigned cmpgt(vec a, vec b) { return movemask(_mm256_cmpgt_epi64(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return movemask(_mm256_cmpgt_epi64(b, a)); }
+            static unsigned cmpeq(vec a, vec b) { return movemask(_mm256_cmpeq_epi64(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b) & 0xF; }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_blendv_epi8(a, b, avx2_expand_bits64(m));
+            }
+        };
+
+        struct avx2_double_traits {
+            typedef double value_type;
+            typedef __m256d vec;
+            enum { width = 4 };
+            static vec load(const double* p) { return _mm256_loadu_pd(p); }
+            static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+            static vec set1(double v) { return _mm256_set1_pd(v); }
+            static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+            static vec div(vec a, vec b) { return _mm256_div_pd(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_pd(b, a); }
+            static vec max(vec a, vec b) { return _mm256_max_pd(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ)); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_blendv_pd(a, b, _mm256_castsi256_pd(avx2_expand_bits64(m)));
+            }
+        };
+
+        struct avx2_bit_traits {
+            typedef __m256i vec;
+            enum { width = 4 };
+            static vec load(const uint64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(uint64_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec bit_or(vec a, vec b) { return _mm256_or_si256(a, b); }
+            static vec bit_and(vec a, vec b) { return _mm256_and_si256(a, b); }
+            static vec bit_andnot(vec a, vec b) { return _mm256_andnot_si256(a, b); }
+            static vec bit_not(vec a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+            static bool zeros(vec a) { return _mm256_testz_si256(a, a); }
+            static bool ones(vec a) { return _mm256_testc_si256(a, _mm256_set1_epi32(-1)); }
+        };
+
+        struct avx2_backend {
+            typedef avx2_int_traits i32;
+            typedef avx2_float_traits f32;
+            typedef avx2_int16_traits i16;
+            typedef avx2_uint8_traits u8;
+            typedef avx2_int64_traits i64;
+            typedef avx2_double_traits f64;
+            typedef avx2_bit_traits bits;
+        };
+
+    } // anonymous namespace
+
+    namespace automi_simd_backends {
+        const automi_simd_kernels* avx2() {
+            static const automi_simd_kernels kernels =
+                make_simd_kernels<avx2_backend>(AUTOMI_ISA_AVX2, "avx2");
+            return &kernels;
+        }
+    }
+
+}
+
+#else
+
+namespace graphlab {
+    namespace automi_simd_backends {
+        const automi_simd_kernels* avx2() { return NULL; }
+    }
+}
+
+#endif
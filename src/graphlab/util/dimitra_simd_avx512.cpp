@@ -0,0 +1,374 @@
+// GCC 12 flags the _mm512_undefined_* placeholders inlined from the
+// intrinsics as maybe uninitialized (GCC bug 105593)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include <graphlab/util/dimitra_simd_kernels.hpp>
+
+// compiled with -mavx512f -mavx512vl -mavx512bw -mavx512dq if the
+// compiler supports them, see src/graphlab/CMakeLists.txt
+#if defined(__AVX512F__) && defined(__AVX512VL__) && defined(__AVX512BW__) && defined(__AVX512DQ__)
+
+#include <immintrin.h>
+
+namespace graphlab {
+
+    namespace {
+
+        /// 256-bit registers with native AVX-512 mask registers
+        struct avx512_int_traits {
+            typedef int value_type;
+            typedef __m256i vec;
+            enum { width = 8 };
+            static vec load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(int* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(int v) { return _mm256_set1_epi32(v); }
+            static vec add(vec a, vec b) { return _mm256_add_epi32(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mullo_epi32(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+            static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_cmpgt_epi32_mask(a, b); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_cmplt_epi32_mask(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_cmpeq_epi32_mask(a, b); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_cmpneq_epi32_mask(a, b); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_mask_blend_epi32(__mmask8(m), a, b);
+            }
+            static void compress_store(int* d, unsigned m, vec v) { _mm256_mask_compressstoreu_epi32(d, __mmask8(m), v); }
+            static vec expand_load(vec a, unsigned m, const int* s) { return _mm256_mask_expandloadu_epi32(a, __mmask8(m), s); }
+        };
+
+        struct avx512_float_traits {
+            typedef float value_type;
+            typedef __m256 vec;
+            enum { width = 8 };
+            static vec load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+            static vec set1(float v) { return _mm256_set1_ps(v); }
+            static vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mul_ps(a, b); }
+            static vec div(vec a, vec b) { return _mm256_div_ps(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_ps(b, a); }
+            static vec max(vec a, vec b) { return _mm256_max_ps(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_mask_blend_ps(__mmask8(m), a, b);
+            }
+            static void compress_store(float* d, unsigned m, vec v) { _mm256_mask_compressstoreu_ps(d, __mmask8(m), v); }
+            static vec expand_load(vec a, unsigned m, const float* s) { return _mm256_mask_expandloadu_ps(a, __mmask8(m), s); }
+        };
+
+        /// The low byte of the products of the byte lanes
+        inline __m256i avx512_mullo_epu8(__m256i a, __m256i b) {
+            const __m256i even = _mm256_mullo_epi16(a, b);
+            const __m256i odd = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+            return _mm256_mask_blend_epi8(__mmask32(0xAAAAAAAA), even, _mm256_slli_epi16(odd, 8));
+        }
+
+        struct avx512_int16_traits {
+            typedef int16_t value_type;
+            typedef __m256i vec;
+            enum { width = 16 };
+            static vec load(const int16_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(int16_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(int16_t v) { return _mm256_set1_epi16(v); }
+            static vec add(vec a, vec b) { return _mm256_adds_epi16(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mullo_epi16(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_epi16(a, b); }
+            static vec max(vec a, vec b) { return _mm256_max_epi16(a, b); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_cmpgt_epi16_mask(a, b); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_cmplt_epi16_mask(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_cmpeq_epi16_mask(a, b); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_cmpneq_epi16_mask(a, b); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_mask_blend_epi16(__mmask16(m), a, b);
+            }
+        };
+
+        struct avx512_uint8_traits {
+            typedef uint8_t value_type;
+            typedef __m256i vec;
+            enum { width = 32 };
+            static vec load(const uint8_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(uint8_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(uint8_t v) { return _mm256_set1_epi8(char(v)); }
+            static vec add(vec a, vec b) { return _mm256_adds_epu8(a, b); }
+            static vec mul(vec a, vec b) { return avx512_mullo_epu8(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_epu8(a, b); }
+            static vec max(vec a, vec b) { return _mm256_max_epu8(a, b); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_cmpgt_epu8_mask(a, b); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_cmplt_epu8_mask(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_cmpeq_epu8_mask(a, b); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_cmpneq_epu8_mask(a, b); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_mask_blend_epi8(__mmask32(m), a, b);
+            }
+        };
+
+        struct avx512_int64_traits {
+            typedef int64_t value_type;
+            typedef __m256i vec;
+            enum { width = 4 };
+            static vec load(const int64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void store(int64_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static vec set1(int64_t v) { return _mm256_set1_epi64x(v); }
+            static vec add(vec a, vec b) { return _mm256_add_epi64(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mullo_epi64(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_epi64(a, b); }
+            static vec max(vec a, vec b) { return _mm256_max_epi64(a, b); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_cmpgt_epi64_mask(a, b); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_cmplt_epi64_mask(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_cmpeq_epi64_mask(a, b); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_cmpneq_epi64_mask(a, b); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_mask_blend_epi64(__mmask8(m), a, b);
+            }
+            static void compress_store(int64_t* d, unsigned m, vec v) { _mm256_mask_compressstoreu_epi64(d, __mmask8(m), v); }
+            static vec expand_load(vec a, unsigned m, const int64_t* s) { return _mm256_mask_expandloadu_epi64(a, __mmask8(m), s); }
+        };
+
+        struct avx512_double_traits {
+            typedef double value_type;
+            typedef __m256d vec;
+            enum { width = 4 };
+            static vec load(const double* p) { return _mm256_loadu_pd(p); }
+            static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+            static vec set1(double v) { return _mm256_set1_pd(v); }
+            static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+            static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+            static vec div(vec a, vec b) { return _mm256_div_pd(a, b); }
+            static vec min(vec a, vec b) { return _mm256_min_pd(b, a); }
+            static vec max(vec a, vec b) { return _mm256_max_pd(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm256_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+            static unsigned cmplt(vec a, vec b) { return _mm256_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+            static unsigned cmpeq(vec a, vec b) { return _mm256_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+            static unsigned cmpneq(vec a, vec b) { return _mm256_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm256_mask_blend_pd(__mmask8(m), a, b);
+            }
+            static void compress_store(double* d, unsigned m, vec v) { _mm256_mask_compressstoreu_pd(d, __mmask8(m), v); }
+            static vec expand_load(vec a, unsigned m, const double* s) { return _mm256_mask_expandloadu_pd(a, __mmask8(m), s); }
+        };
+
+        /// Lane masks use the full 512-bit registers
+        struct avx512_bit_traits {
+            typedef __m512i vec;
+            enum { width = 8 };
+            static vec load(const uint64_t* p) { return _mm512_loadu_si512(p); }
+            static void store(uint64_t* p, vec v) { _mm512_storeu_si512(p, v); }
+            static vec bit_or(vec a, vec b) { return _mm512_or_si512(a, b); }
+            static vec bit_and(vec a, vec b) { return _mm512_and_si512(a, b); }
+            static vec bit_andnot(vec a, vec b) { return _mm512_andnot_si512(a, b); }
+            static vec bit_not(vec a) { return _mm512_ternarylogic_epi64(a, a, a, 0x55); }
+            static bool zeros(vec a) { return _mm512_test_epi64_mask(a, a) == 0; }
+            static bool ones(vec a) { return _mm512_cmpneq_epi64_mask(a, _mm512_set1_epi64(-1)) == 0; }
+        };
+
+        /// 512-bit registers, 16 lanes per operation
+        struct avx512_zmm_int_traits {
+            typedef int value_type;
+            typedef __m512i vec;
+            enum { width = 16 };
+            static vec load(const int* p) { return _mm512_loadu_si512(p); }
+            static void store(int* p, vec v) { _mm512_storeu_si512(p, v); }
+            static vec set1(int v) { return _mm512_set1_epi32(v); }
+            static vec add(vec a, vec b) { return _mm512_add_epi32(a, b); }
+            static vec mul(vec a, vec b) { return _mm512_mullo_epi32(a, b); }
+            static vec min(vec a, vec b) { return _mm512_min_epi32(a, b); }
+            static vec max(vec a, vec b) { return _mm512_max_epi32(a, b); }
+            static unsigned cmpgt(vec a, vec b) { return _mm512_cmpgt_epi32_mask(a, b); }
+            static unsigned cmplt(vec a, vec b) { return _mm512_cmplt_epi32_mask(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm512_cmpeq_epi32_mask(a, b); }
+            static unsigned cmpneq(vec a, vec b) { return _mm512_cmpneq_epi32_mask(a, b); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm512_mask_blend_epi32(__mmask16(m), a, b);
+            }
+            static void compress_store(int* d, unsigned m, vec v) { _mm512_mask_compressstoreu_epi32(d, __mmask16(m), v); }
+            static vec expand_load(vec a, unsigned m, const int* s) { return _mm512_mask_expandloadu_epi32(a, __mmask16(m), s); }
+        };
+
+        struct avx512_zmm_float_traits {
+            typedef float value_type;
+            typedef __m512 vec;
+            enum { width = 16 };
+            static vec load(const float* p) { return _mm512_loadu_ps(p); }
+            static void store(float* p, vec v) { _mm512_storeu_ps(p, v); }
+            static vec set1(float v) { return _mm512_set1_ps(v); }
+            static vec add(vec a, vec b) { return _mm512_add_ps(a, b); }
+            static vec mul(vec a, vec b) { return _mm512_mul_ps(a, b); }
+            static vec div(vec a, vec b) { return _mm512_div_ps(a, b); }
+            static vec min(vec a, vec b) { return _mm512_min_ps(b, a); }
+            static vec max(vec a, vec b) { return _mm512_max_ps(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+            static unsigned cmplt(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+            static unsigned cmpeq(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+            static unsigned cmpneq(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm512_mask_blend_ps(__mmask16(m), a, b);
+            }
+            static void compress_store(float* d, unsigned m, vec v) { _mm512_mask_compressstoreu_ps(d, __mmask16(m), v); }
+            static vec expand_load(vec a, unsigned m, const float* s) { return _mm512_mask_expandloadu_ps(a, __mmask16(m), s); }
+        };
+
+        struct avx512_zmm_int16_traits {
+            typedef int16_t value_type;
+            typedef __m512i vec;
+            enum { width = 32 };
+            static vec load(const int16_t* p) { return _mm512_loadu_si512(p); }
+            static void store(int16_t* p, vec v) { _mm512_storeu_si512(p, v); }
+            static vec set1(int16_t v) { return _mm512_set1_epi16(v); }
+            static vec add(vec a, vec b) { return _mm512_adds_epi16(a, b); }
+            static vec mul(vec a, vec b) { return _mm512_mullo_epi16(a, b); }
+            static vec min(vec a, vec b) { return _mm512_min_epi16(a, b); }
+            static vec max(vec a, vec b) { return _mm512_max_epi16(a, b); }
+            static unsigned cmpgt(vec a, vec b) { return _mm512_cmpgt_epi16_mask(a, b); }
+            static unsigned cmplt(vec a, vec b) { return _mm512_cmplt_epi16_mask(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm512_cmpeq_epi16_mask(a, b); }
+            static unsigned cmpneq(vec a, vec b) { return _mm512_cmpneq_epi16_mask(a, b); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm512_mask_blend_epi16(__mmask32(m), a, b);
+            }
+        };
+
+        struct avx512_zmm_int64_traits {
+            typedef int64_t value_type;
+            typedef __m512i vec;
+            enum { width = 8 };
+            static vec load(const int64_t* p) { return _mm512_loadu_si512(p); }
+            static void store(int64_t* p, vec v) { _mm512_storeu_si512(p, v); }
+            static vec set1(int64_t v) { return _mm512_set1_epi64(v); }
+            static vec add(vec a, vec b) { return _mm512_add_epi64(a, b); }
+            static vec mul(vec a, vec b) { return _mm512_mullo_epi64(a, b); }
+            static vec min(vec a, vec b) { return _mm512_min_epi64(a, b); }
+            static vec max(vec a, vec b) { return _mm512_max_epi64(a, b); }
+            static unsigned cmpgt(vec a, vec b) { return _mm512_cmpgt_epi64_mask(a, b); }
+            static unsigned cmplt(vec a, vec b) { return _mm512_cmplt_epi64_mask(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm512_cmpeq_epi64_mask(a, b); }
+            static unsigned cmpneq(vec a, vec b) { return _mm512_cmpneq_epi64_mask(a, b); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm512_mask_blend_epi64(__mmask8(m), a, b);
+            }
+            static void compress_store(int64_t* d, unsigned m, vec v) { _mm512_mask_compressstoreu_epi64(d, __mmask8(m), v); }
+            static vec expand_load(vec a, unsigned m, const int64_t* s) { return _mm512_mask_expandloadu_epi64(a, __mmask8(m), s); }
+        };
+
+        struct avx512_zmm_double_traits {
+            typedef double value_type;
+            typedef __m512d vec;
+            enum { width = 8 };
+            static vec load(const double* p) { return _mm512_loadu_pd(p); }
+            static void store(double* p, vec v) { _mm512_storeu_pd(p, v); }
+            static vec set1(double v) { return _mm512_set1_pd(v); }
+            static vec add(vec a, vec b) { return _mm512_add_pd(a, b); }
+            static vec mul(vec a, vec b) { return _mm512_mul_pd(a, b); }
+            static vec div(vec a, vec b) { return _mm512_div_pd(a, b); }
+            static vec min(vec a, vec b) { return _mm512_min_pd(b, a); }
+            static vec max(vec a, vec b) { return _mm512_max_pd(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+            static unsigned cmplt(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+            static unsigned cmpeq(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+            static unsigned cmpneq(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm512_mask_blend_pd(__mmask8(m), a, b);
+            }
+            static void compress_store(double* d, unsigned m, vec v) { _mm512_mask_compressstoreu_pd(d, __mmask8(m), v); }
+            static vec expand_load(vec a, unsigned m, const double* s) { return _mm512_mask_expandloadu_pd(a, __mmask8(m), s); }
+        };
+
+        /**
+         * Packs and unpacks the 32- and 64-bit lanes with the compress
+         * and expand instructions, one register at a time.
+         */
+        template <typename X>
+        struct avx512_packer {
+            typedef typename X::value_type T;
+
+            static size_t compress(T* d, const uint8_t* m, const T* s, size_t n) {
+                size_t i = 0, k = 0;
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    X::compress_store(d + k, bits, X::load(s + i));
+                    k += __builtin_popcount(bits);
+                }
+                return k + lane_packer<scalar_traits<T> >::compress(d + k, m + i / 8, s + i, n - i);
+            }
+
+            static size_t expand(T* d, const uint8_t* m, const T* s, size_t n) {
+                size_t i = 0, k = 0;
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    X::store(d + i, X::expand_load(X::load(d + i), bits, s + k));
+                    k += __builtin_popcount(bits);
+                }
+                return k + lane_packer<scalar_traits<T> >::expand(d + i, m + i / 8, s + k, n - i);
+            }
+        };
+
+        template <> struct lane_packer<avx512_int_traits> : avx512_packer<avx512_int_traits> { };
+        template <> struct lane_packer<avx512_float_traits> : avx512_packer<avx512_float_traits> { };
+        template <> struct lane_packer<avx512_int64_traits> : avx512_packer<avx512_int64_traits> { };
+        template <> struct lane_packer<avx512_double_traits> : avx512_packer<avx512_double_traits> { };
+        template <> struct lane_packer<avx512_zmm_int_traits> : avx512_packer<avx512_zmm_int_traits> { };
+        template <> struct lane_packer<avx512_zmm_float_traits> : avx512_packer<avx512_zmm_float_traits> { };
+        template <> struct lane_packer<avx512_zmm_int64_traits> : avx512_packer<avx512_zmm_int64_traits> { };
+        template <> struct lane_packer<avx512_zmm_double_traits> : avx512_packer<avx512_zmm_double_traits> { };
+
+        struct avx512_backend {
+            typedef avx512_int_traits i32;
+            typedef avx512_float_traits f32;
+            typedef avx512_int16_traits i16;
+            typedef avx512_uint8_traits u8;
+            typedef avx512_int64_traits i64;
+            typedef avx512_double_traits f64;
+            typedef avx512_bit_traits bits;
+        };
+
+        /**
+         * uint8_t stays on 256-bit registers: 64 byte lanes would not fit
+         * the 32-bit lane masks of the kernels.
+         */
+        struct avx512_zmm_backend {
+            typedef avx512_zmm_int_traits i32;
+            typedef avx512_zmm_float_traits f32;
+            typedef avx512_zmm_int16_traits i16;
+            typedef avx512_uint8_traits u8;
+            typedef avx512_zmm_int64_traits i64;
+            typedef avx512_zmm_double_traits f64;
+            typedef avx512_bit_traits bits;
+        };
+
+    } // anonymous namespace
+
+    namespace automi_simd_backends {
+        const automi_simd_kernels* avx512() {
+            static const automi_simd_kernels kernels =
+                make_simd_kernels<avx512_backend>(AUTOMI_ISA_AVX512, "avx512");
+            return &kernels;
+        }
+
+        const automi_simd_kernels* avx512_zmm() {
+            static const automi_simd_kernels kernels =
+                make_simd_kernels<avx512_zmm_backend>(AUTOMI_ISA_AVX512_ZMM, "avx512zmm");
+            return &kernels;
+        }
+    }
+
+}
+
+#else
+
+namespace graphlab {
+    namespace automi_simd_backends {
+        const automi_simd_kernels* avx512() { return NULL; }
+        const automi_simd_kernels* avx512_zmm() { return NULL; }
+    }
+}
+
+#endif
+
+#pragma GCC diagnostic pop
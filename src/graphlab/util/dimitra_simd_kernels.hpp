@@ -0,0 +1,708 @@
+#ifndef GRAPHLAB_DIMITRA_SIMD_KERNELS_HPP
+#define GRAPHLAB_DIMITRA_SIMD_KERNELS_HPP
+
+#include <cstring>
+#include <limits>
+
+#include <graphlab/util/dimitra_simd.hpp>
+
+/**
+ * \internal
+ * Generic AutoMI lane kernels, only included by the backend
+ * translation units (dimitra_simd*.cpp).
+ *
+ * A backend describes its registers with a traits class:
+ *
+ * \code
+ * struct traits {
+ *   typedef ... value_type;               // the lane type
+ *   typedef ... vec;                      // a register of lanes
+ *   enum { width = ... };                 // lanes per register
+ *   static vec load(const value_type*);   // unaligned load
+ *   static void store(value_type*, vec);  // unaligned store
+ *   static vec set1(value_type);
+ *   static vec add(vec, vec);  static vec mul(vec, vec);
+ *   static vec min(vec, vec);  static vec max(vec, vec);
+ *   static unsigned cmpgt(vec, vec);      // one bit per lane
+ *   static unsigned cmplt(vec, vec);
+ *   static unsigned cmpeq(vec, vec);
+ *   static unsigned cmpneq(vec, vec);
+ *   static vec blend(vec a, vec b, unsigned m);  // m ? b : a
+ *   static vec div(vec, vec);             // floating point lanes only
+ * };
+ * \endcode
+ *
+ * and instantiates the kernels with it.  Lanes which do not fill a
+ * whole register are processed with the scalar traits.
+ *
+ * The add of the int16_t and uint8_t lanes saturates, so that a lane
+ * holding the largest value (the usual "unreached" distance) stays
+ * there; their mul wraps around like the wider lanes.
+ *
+ * The kernels of lane masks take a second traits class over registers
+ * of 64-bit words:
+ *
+ * \code
+ * struct bit_traits {
+ *   typedef ... vec;
+ *   enum { width = ... };                 // words per register
+ *   static vec load(const uint64_t*);     // unaligned load
+ *   static void store(uint64_t*, vec);    // unaligned store
+ *   static vec bit_or(vec, vec);  static vec bit_and(vec, vec);
+ *   static vec bit_andnot(vec a, vec b);  // ~a & b
+ *   static vec bit_not(vec);
+ *   static bool zeros(vec);               // no bit set
+ *   static bool ones(vec);                // all bits set
+ * };
+ * \endcode
+ *
+ * The compress and expand kernels go through lane_packer<traits>,
+ * which walks the lane mask byte by byte; a backend with compress and
+ * expand instructions specializes it for its traits.
+ *
+ * Everything here has internal linkage: the same templates are
+ * compiled with different instruction set flags in every backend, and
+ * must never be merged by the linker.
+ */
+
+namespace graphlab {
+
+    /// \internal The backend entry points, NULL if not compiled in
+    namespace automi_simd_backends {
+        const automi_simd_kernels* scalar();
+        const automi_simd_kernels* sse4();
+        const automi_simd_kernels* avx2();
+        const automi_simd_kernels* avx512();
+        const automi_simd_kernels* avx512_zmm();
+    }
+
+    namespace {
+
+        /// Reads the mask bits of w lanes starting at lane i
+        inline unsigned load_lane_bits(const uint8_t* m, size_t i, unsigned w) {
+            if (w >= 8) {
+                unsigned bits = 0;
+                for (unsigned k = 0; k < w / 8; ++k)
+                    bits |= unsigned(m[i / 8 + k]) << (8 * k);
+                return bits;
+            }
+            return (m[i / 8] >> (i % 8)) & ((1u << w) - 1);
+        }
+
+        /// Writes the mask bits of w lanes starting at lane i
+        inline void store_lane_bits(uint8_t* m, size_t i, unsigned bits, unsigned w) {
+            if (w >= 8) {
+                for (unsigned k = 0; k < w / 8; ++k)
+                    m[i / 8 + k] = uint8_t(bits >> (8 * k));
+                return;
+            }
+            const unsigned shift = i % 8;
+            const unsigned keep = ~(((1u << w) - 1) << shift);
+            m[i / 8] = uint8_t((m[i / 8] & keep) | (bits << shift));
+        }
+
+        /// a + b, saturated for the narrow integer lanes
+        template <typename T>
+        inline T lane_add(T a, T b) { return a + b; }
+
+        inline int16_t lane_add(int16_t a, int16_t b) {
+            const int s = int(a) + int(b);
+            const int hi = std::numeric_limits<int16_t>::max();
+            const int lo = std::numeric_limits<int16_t>::min();
+            return int16_t(s > hi ? hi : (s < lo ? lo : s));
+        }
+
+        inline uint8_t lane_add(uint8_t a, uint8_t b) {
+            const unsigned s = unsigned(a) + unsigned(b);
+            return uint8_t(s > 0xFF ? 0xFF : s);
+        }
+
+        /// One lane per register, also used for the tails of wider backends
+        template <typename T>
+        struct scalar_traits {
+            typedef T value_type;
+            typedef T vec;
+            enum { width = 1 };
+            static vec load(const T* p) { return *p; }
+            static void store(T* p, vec v) { *p = v; }
+            static vec set1(T v) { return v; }
+            static vec add(vec a, vec b) { return lane_add(a, b); }
+            static vec mul(vec a, vec b) { return vec(a * b); }
+            static vec div(vec a, vec b) { return a / b; }
+            static vec min(vec a, vec b) { return b < a ? b : a; }
+            static vec max(vec a, vec b) { return a < b ? b : a; }
+            static unsigned cmpgt(vec a, vec b) { return a > b; }
+            static unsigned cmplt(vec a, vec b) { return a < b; }
+            static unsigned cmpeq(vec a, vec b) { return a == b; }
+            static unsigned cmpneq(vec a, vec b) { return a != b; }
+            static vec blend(vec a, vec b, unsigned m) { return (m & 1) ? b : a; }
+        };
+
+        struct op_add {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::add(a, b); }
+        };
+        struct op_mul {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::mul(a, b); }
+        };
+        struct op_div {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::div(a, b); }
+        };
+        struct op_min {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::min(a, b); }
+        };
+        struct op_max {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::max(a, b); }
+        };
+        struct op_cmpgt {
+            template <typename X>
+            static unsigned apply(typename X::vec a, typename X::vec b) { return X::cmpgt(a, b); }
+        };
+        struct op_cmplt {
+            template <typename X>
+            static unsigned apply(typename X::vec a, typename X::vec b) { return X::cmplt(a, b); }
+        };
+        struct op_cmpeq {
+            template <typename X>
+            static unsigned apply(typename X::vec a, typename X::vec b) { return X::cmpeq(a, b); }
+        };
+        struct op_cmpneq {
+            template <typename X>
+            static unsigned apply(typename X::vec a, typename X::vec b) { return X::cmpneq(a, b); }
+        };
+
+        /// Packs and unpacks the lanes selected by a lane mask, 8 lanes at a time
+        template <typename X>
+        struct lane_packer {
+            typedef typename X::value_type T;
+
+            static size_t compress(T* d, const uint8_t* m, const T* s, size_t n) {
+                size_t k = 0;
+                for (size_t i = 0; i < n; i += 8) {
+                    unsigned bits = m[i / 8];
+                    if (bits == 0xFF) {
+                        memcpy(d + k, s + i, sizeof(T) * 8);
+                        k += 8;
+                        continue;
+                    }
+                    for (; bits != 0; bits &= bits - 1)
+                        d[k++] = s[i + __builtin_ctz(bits)];
+                }
+                return k;
+            }
+
+            static size_t expand(T* d, const uint8_t* m, const T* s, size_t n) {
+                size_t k = 0;
+                for (size_t i = 0; i < n; i += 8) {
+                    unsigned bits = m[i / 8];
+                    if (bits == 0xFF) {
+                        memcpy(d + i, s + k, sizeof(T) * 8);
+                        k += 8;
+                        continue;
+                    }
+                    for (; bits != 0; bits &= bits - 1)
+                        d[i + __builtin_ctz(bits)] = s[k++];
+                }
+                return k;
+            }
+        };
+
+        /// The kernels of backend Tr, with the tails processed by Sc
+        template <typename Tr, typename Sc>
+        struct lane_kernels_impl {
+            typedef typename Tr::value_type T;
+
+            template <typename X>
+            static size_t run_set1(T* d, T v, size_t i, size_t n) {
+                const typename X::vec vv = X::set1(v);
+                for (; i + X::width <= n; i += X::width)
+                    X::store(d + i, vv);
+                return i;
+            }
+
+            static void set1(T* d, T v, size_t n) {
+                run_set1<Sc>(d, v, run_set1<Tr>(d, v, 0, n), n);
+            }
+
+            template <typename X>
+            static size_t run_blend(T* d, const uint8_t* m, const T* s, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    X::store(d + i, X::blend(X::load(d + i), X::load(s + i), bits));
+                }
+                return i;
+            }
+
+            static void blend(T* d, const uint8_t* m, const T* s, size_t n) {
+                run_blend<Sc>(d, m, s, run_blend<Tr>(d, m, s, 0, n), n);
+            }
+
+            template <typename X>
+            static size_t run_blend1(T* d, const uint8_t* m, T v, size_t i, size_t n) {
+                const typename X::vec vv = X::set1(v);
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    X::store(d + i, X::blend(X::load(d + i), vv, bits));
+                }
+                return i;
+            }
+
+            static void blend1(T* d, const uint8_t* m, T v, size_t n) {
+                run_blend1<Sc>(d, m, v, run_blend1<Tr>(d, m, v, 0, n), n);
+            }
+
+            template <typename X, typename Op>
+            static size_t run_binary(T* d, const T* a, const T* b, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    X::store(d + i, Op::template apply<X>(X::load(a + i), X::load(b + i)));
+                return i;
+            }
+
+            template <typename Op>
+            static void binary(T* d, const T* a, const T* b, size_t n) {
+                run_binary<Sc, Op>(d, a, b, run_binary<Tr, Op>(d, a, b, 0, n), n);
+            }
+
+            template <typename X, typename Op>
+            static size_t run_binary1(T* d, const T* a, T v, size_t i, size_t n) {
+                const typename X::vec vv = X::set1(v);
+                for (; i + X::width <= n; i += X::width)
+                    X::store(d + i, Op::template apply<X>(X::load(a + i), vv));
+                return i;
+            }
+
+            template <typename Op>
+            static void binary1(T* d, const T* a, T v, size_t n) {
+                run_binary1<Sc, Op>(d, a, v, run_binary1<Tr, Op>(d, a, v, 0, n), n);
+            }
+
+            template <typename X, typename Op>
+            static size_t run_binary_mask(T* d, const uint8_t* m, const T* a, const T* b,
+                                          size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    const typename X::vec r = Op::template apply<X>(X::load(a + i), X::load(b + i));
+                    X::store(d + i, X::blend(X::load(d + i), r, bits));
+                }
+                return i;
+            }
+
+            template <typename Op>
+            static void binary_mask(T* d, const uint8_t* m, const T* a, const T* b, size_t n) {
+                run_binary_mask<Sc, Op>(d, m, a, b, run_binary_mask<Tr, Op>(d, m, a, b, 0, n), n);
+            }
+
+            /// d = m ? d op s : d
+            template <typename Op>
+            static void binary_mask_self(T* d, const uint8_t* m, const T* s, size_t n) {
+                binary_mask<Op>(d, m, d, s, n);
+            }
+
+            template <typename X, typename Op>
+            static size_t run_binary1_mask(T* d, const uint8_t* m, const T* a, T v,
+                                           size_t i, size_t n) {
+                const typename X::vec vv = X::set1(v);
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    const typename X::vec r = Op::template apply<X>(X::load(a + i), vv);
+                    X::store(d + i, X::blend(X::load(d + i), r, bits));
+                }
+                return i;
+            }
+
+            template <typename Op>
+            static void binary1_mask(T* d, const uint8_t* m, const T* a, T v, size_t n) {
+                run_binary1_mask<Sc, Op>(d, m, a, v, run_binary1_mask<Tr, Op>(d, m, a, v, 0, n), n);
+            }
+
+            template <typename X>
+            static size_t run_add1_min(T* d, const T* a, T v, size_t i, size_t n) {
+                const typename X::vec vv = X::set1(v);
+                for (; i + X::width <= n; i += X::width)
+                    X::store(d + i, X::min(X::load(d + i), X::add(X::load(a + i), vv)));
+                return i;
+            }
+
+            /// d = min(d, a + v) in one pass
+            static void add1_min(T* d, const T* a, T v, size_t n) {
+                run_add1_min<Sc>(d, a, v, run_add1_min<Tr>(d, a, v, 0, n), n);
+            }
+
+            template <typename X>
+            static size_t run_add1_min_mask(T* d, const uint8_t* m, const T* a, T v,
+                                            size_t i, size_t n) {
+                const typename X::vec vv = X::set1(v);
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    const typename X::vec c = X::load(d + i);
+                    const typename X::vec r = X::min(c, X::add(X::load(a + i), vv));
+                    X::store(d + i, X::blend(c, r, bits));
+                }
+                return i;
+            }
+
+            /// d = m ? min(d, a + v) : d in one pass
+            static void add1_min_mask(T* d, const uint8_t* m, const T* a, T v, size_t n) {
+                run_add1_min_mask<Sc>(d, m, a, v, run_add1_min_mask<Tr>(d, m, a, v, 0, n), n);
+            }
+
+            template <typename X, typename Op>
+            static size_t run_compare(uint8_t* o, const T* a, const T* b, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    store_lane_bits(o, i, Op::template apply<X>(X::load(a + i), X::load(b + i)),
+                                    X::width);
+                return i;
+            }
+
+            template <typename Op>
+            static void compare(uint8_t* o, const T* a, const T* b, size_t n) {
+                run_compare<Sc, Op>(o, a, b, run_compare<Tr, Op>(o, a, b, 0, n), n);
+            }
+
+            /// Cmp selects the lanes to report, Op the value kept in d
+            template <typename X, typename Cmp, typename Op>
+            static size_t run_update(T* d, uint8_t* o, const T* s, unsigned& any,
+                                     size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width) {
+                    const typename X::vec a = X::load(d + i);
+                    const typename X::vec b = X::load(s + i);
+                    const unsigned bits = Cmp::template apply<X>(a, b);
+                    X::store(d + i, Op::template apply<X>(a, b));
+                    if (o != NULL) store_lane_bits(o, i, bits, X::width);
+                    any |= bits;
+                }
+                return i;
+            }
+
+            template <typename Cmp, typename Op>
+            static bool update(T* d, uint8_t* o, const T* s, size_t n) {
+                unsigned any = 0;
+                run_update<Sc, Cmp, Op>(d, o, s, any,
+                                        run_update<Tr, Cmp, Op>(d, o, s, any, 0, n), n);
+                return any != 0;
+            }
+
+            template <typename X>
+            static size_t run_min_gt_mask(T* d, const uint8_t* m, uint8_t* o, const T* s,
+                                          unsigned& any, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width) {
+                    const unsigned bits = load_lane_bits(m, i, X::width);
+                    if (bits == 0) continue;
+                    const typename X::vec a = X::load(d + i);
+                    const typename X::vec b = X::load(s + i);
+                    const unsigned gt = op_cmpgt::template apply<X>(a, b) & bits;
+                    if (gt == 0) continue;
+                    // the lanes to lower are exactly those taking s
+                    X::store(d + i, X::blend(a, b, gt));
+                    if (o != NULL)
+                        store_lane_bits(o, i, load_lane_bits(o, i, X::width) | gt, X::width);
+                    any |= gt;
+                }
+                return i;
+            }
+
+            /// o |= m & (d > s), d = m ? min(d, s) : d in one pass
+            static bool min_gt_mask(T* d, const uint8_t* m, uint8_t* o, const T* s, size_t n) {
+                unsigned any = 0;
+                run_min_gt_mask<Sc>(d, m, o, s, any,
+                                    run_min_gt_mask<Tr>(d, m, o, s, any, 0, n), n);
+                return any != 0;
+            }
+
+            template <typename X>
+            static size_t run_add1_min_gt(T* d, uint8_t* o, const T* a, T v,
+                                          unsigned& any, size_t i, size_t n) {
+                const typename X::vec vv = X::set1(v);
+                for (; i + X::width <= n; i += X::width) {
+                    const typename X::vec c = X::load(d + i);
+                    const typename X::vec r = X::add(X::load(a + i), vv);
+                    const unsigned gt = op_cmpgt::template apply<X>(c, r);
+                    X::store(d + i, X::min(c, r));
+                    if (o != NULL) store_lane_bits(o, i, gt, X::width);
+                    any |= gt;
+                }
+                return i;
+            }
+
+            /// o = d > a + v, d = min(d, a + v) in one pass
+            static bool add1_min_gt(T* d, uint8_t* o, const T* a, T v, size_t n) {
+                unsigned any = 0;
+                run_add1_min_gt<Sc>(d, o, a, v, any,
+                                    run_add1_min_gt<Tr>(d, o, a, v, any, 0, n), n);
+                return any != 0;
+            }
+
+            static void fill(automi_lane_kernels<T>& k) {
+                k.set1 = &set1;
+                k.blend = &blend;
+                k.blend1 = &blend1;
+                k.add = &binary<op_add>;
+                k.add1 = &binary1<op_add>;
+                k.add_mask = &binary_mask<op_add>;
+                k.add1_mask = &binary1_mask<op_add>;
+                k.add1_min = &add1_min;
+                k.add1_min_mask = &add1_min_mask;
+                k.mul = &binary<op_mul>;
+                k.mul1 = &binary1<op_mul>;
+                k.mul1_mask = &binary1_mask<op_mul>;
+                k.div = NULL;
+                k.div1 = NULL;
+                k.div_mask = NULL;
+                k.min = &binary<op_min>;
+                k.max = &binary<op_max>;
+                k.cmpgt = &compare<op_cmpgt>;
+                k.cmplt = &compare<op_cmplt>;
+                k.cmpeq = &compare<op_cmpeq>;
+                k.cmpneq = &compare<op_cmpneq>;
+                k.min_gt = &update<op_cmpgt, op_min>;
+                k.max_lt = &update<op_cmplt, op_max>;
+                k.min_gt_mask = &min_gt_mask;
+                k.add1_min_gt = &add1_min_gt;
+                k.compress = &lane_packer<Tr>::compress;
+                k.expand = &lane_packer<Tr>::expand;
+            }
+
+            /// Fills the division kernels, floating point lanes only
+            static void fill_div(automi_lane_kernels<T>& k) {
+                k.div = &binary<op_div>;
+                k.div1 = &binary1<op_div>;
+                k.div_mask = &binary_mask_self<op_div>;
+            }
+        };
+
+        /// One word per register, also used for the tails of wider backends
+        struct scalar_bit_traits {
+            typedef uint64_t vec;
+            enum { width = 1 };
+            static vec load(const uint64_t* p) { return *p; }
+            static void store(uint64_t* p, vec v) { *p = v; }
+            static vec bit_or(vec a, vec b) { return a | b; }
+            static vec bit_and(vec a, vec b) { return a & b; }
+            static vec bit_andnot(vec a, vec b) { return ~a & b; }
+            static vec bit_not(vec a) { return ~a; }
+            static bool zeros(vec a) { return a == 0; }
+            static bool ones(vec a) { return a == ~uint64_t(0); }
+        };
+
+        struct op_bit_or {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::bit_or(a, b); }
+        };
+        struct op_bit_and {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::bit_and(a, b); }
+        };
+        struct op_bit_andnot {
+            template <typename X>
+            static typename X::vec apply(typename X::vec a, typename X::vec b) { return X::bit_andnot(a, b); }
+        };
+
+        /// The lane mask kernels of backend Tr, with the tails processed word by word
+        template <typename Tr>
+        struct bit_kernels_impl {
+            typedef scalar_bit_traits Sc;
+
+            template <typename X, typename Op>
+            static size_t run_binary(uint64_t* d, const uint64_t* a, const uint64_t* b,
+                                     size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    X::store(d + i, Op::template apply<X>(X::load(a + i), X::load(b + i)));
+                return i;
+            }
+
+            template <typename Op>
+            static void binary(uint64_t* d, const uint64_t* a, const uint64_t* b, size_t n) {
+                run_binary<Sc, Op>(d, a, b, run_binary<Tr, Op>(d, a, b, 0, n), n);
+            }
+
+            template <typename X>
+            static size_t run_bit_not(uint64_t* d, const uint64_t* a, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    X::store(d + i, X::bit_not(X::load(a + i)));
+                return i;
+            }
+
+            static void bit_not(uint64_t* d, const uint64_t* a, size_t n) {
+                run_bit_not<Sc>(d, a, run_bit_not<Tr>(d, a, 0, n), n);
+            }
+
+            template <typename X>
+            static size_t run_blend(uint64_t* d, const uint64_t* m, const uint64_t* a,
+                                    size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width) {
+                    const typename X::vec mm = X::load(m + i);
+                    if (X::zeros(mm)) continue;
+                    X::store(d + i, X::bit_or(X::bit_andnot(mm, X::load(d + i)),
+                                              X::bit_and(mm, X::load(a + i))));
+                }
+                return i;
+            }
+
+            static void blend(uint64_t* d, const uint64_t* m, const uint64_t* a, size_t n) {
+                run_blend<Sc>(d, m, a, run_blend<Tr>(d, m, a, 0, n), n);
+            }
+
+            template <typename X>
+            static size_t run_andnot_mask(uint64_t* d, const uint64_t* m, const uint64_t* a,
+                                          const uint64_t* b, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width) {
+                    const typename X::vec mm = X::load(m + i);
+                    if (X::zeros(mm)) continue;
+                    const typename X::vec r = X::bit_andnot(X::load(a + i), X::load(b + i));
+                    X::store(d + i, X::bit_or(X::bit_andnot(mm, X::load(d + i)),
+                                              X::bit_and(mm, r)));
+                }
+                return i;
+            }
+
+            static void andnot_mask(uint64_t* d, const uint64_t* m, const uint64_t* a,
+                                    const uint64_t* b, size_t n) {
+                run_andnot_mask<Sc>(d, m, a, b, run_andnot_mask<Tr>(d, m, a, b, 0, n), n);
+            }
+
+            /// d |= s, recording in 'changed' whether a bit of d was set
+            template <typename X>
+            static void or_into(uint64_t* d, typename X::vec s, bool& changed) {
+                const typename X::vec c = X::load(d);
+                const typename X::vec gained = X::bit_andnot(c, s);
+                if (X::zeros(gained)) return;
+                X::store(d, X::bit_or(c, s));
+                changed = true;
+            }
+
+            template <typename X>
+            static size_t run_or_update(uint64_t* d, const uint64_t* a, bool& changed,
+                                        size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    or_into<X>(d + i, X::load(a + i), changed);
+                return i;
+            }
+
+            static bool or_update(uint64_t* d, const uint64_t* a, size_t n) {
+                bool changed = false;
+                run_or_update<Sc>(d, a, changed, run_or_update<Tr>(d, a, changed, 0, n), n);
+                return changed;
+            }
+
+            template <typename X>
+            static size_t run_or_update_mask(uint64_t* d, const uint64_t* m, const uint64_t* a,
+                                             bool& changed, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    or_into<X>(d + i, X::bit_and(X::load(m + i), X::load(a + i)), changed);
+                return i;
+            }
+
+            static bool or_update_mask(uint64_t* d, const uint64_t* m, const uint64_t* a, size_t n) {
+                bool changed = false;
+                run_or_update_mask<Sc>(d, m, a, changed,
+                                       run_or_update_mask<Tr>(d, m, a, changed, 0, n), n);
+                return changed;
+            }
+
+            /// Skips the leading registers of a without a set bit
+            template <typename X>
+            static size_t skip_zeros(const uint64_t* a, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    if (!X::zeros(X::load(a + i))) break;
+                return i;
+            }
+
+            static size_t popcount(const uint64_t* a, size_t n) {
+                // hardware popcnt in the backends built with SSE4.2 and up
+                size_t count = 0;
+                for (size_t i = 0; i < n; i += Tr::width) {
+                    i = skip_zeros<Tr>(a, i, n);
+                    const size_t end = i + Tr::width < n ? i + Tr::width : n;
+                    for (size_t j = i; j < end; ++j) count += __builtin_popcountll(a[j]);
+                }
+                return count;
+            }
+
+            static bool any(const uint64_t* a, size_t n) {
+                const size_t i = skip_zeros<Tr>(a, 0, n);
+                if (i + Tr::width <= n) return true;
+                return skip_zeros<Sc>(a, i, n) < n;
+            }
+
+            template <typename X>
+            static size_t run_all(const uint64_t* a, size_t i, size_t n) {
+                for (; i + X::width <= n; i += X::width)
+                    if (!X::ones(X::load(a + i))) break;
+                return i;
+            }
+
+            static bool all(const uint64_t* a, size_t n) {
+                const size_t i = run_all<Tr>(a, 0, n);
+                if (i + Tr::width <= n) return false;
+                return run_all<Sc>(a, i, n) == n;
+            }
+
+            static size_t first_set(const uint64_t* a, size_t n) {
+                for (size_t i = skip_zeros<Tr>(a, 0, n); i < n; ++i) {
+                    if (a[i] != 0) return 64 * i + __builtin_ctzll(a[i]);
+                }
+                return 64 * n;
+            }
+
+            static void fill(automi_bit_kernels& k) {
+                k.bit_or = &binary<op_bit_or>;
+                k.bit_and = &binary<op_bit_and>;
+                k.bit_andnot = &binary<op_bit_andnot>;
+                k.bit_not = &bit_not;
+                k.blend = &blend;
+                k.andnot_mask = &andnot_mask;
+                k.or_update = &or_update;
+                k.or_update_mask = &or_update_mask;
+                k.popcount = &popcount;
+                k.any = &any;
+                k.all = &all;
+                k.first_set = &first_set;
+            }
+        };
+
+        /// The registers of the scalar backend
+        struct scalar_backend {
+            typedef scalar_traits<int> i32;
+            typedef scalar_traits<float> f32;
+            typedef scalar_traits<int16_t> i16;
+            typedef scalar_traits<uint8_t> u8;
+            typedef scalar_traits<int64_t> i64;
+            typedef scalar_traits<double> f64;
+            typedef scalar_bit_traits bits;
+        };
+
+        /**
+         * Builds the kernel table of a backend, whose traits classes are
+         * the typedefs i32, f32, i16, u8, i64, f64 and bits of Backend.
+         */
+        template <typename Backend>
+        automi_simd_kernels make_simd_kernels(automi_isa_type isa, const char* name) {
+            automi_simd_kernels k;
+            k.isa = isa;
+            k.name = name;
+            lane_kernels_impl<typename Backend::i32, scalar_traits<int> >::fill(k.i32);
+            lane_kernels_impl<typename Backend::f32, scalar_traits<float> >::fill(k.f32);
+            lane_kernels_impl<typename Backend::f32, scalar_traits<float> >::fill_div(k.f32);
+            lane_kernels_impl<typename Backend::i16, scalar_traits<int16_t> >::fill(k.i16);
+            lane_kernels_impl<typename Backend::u8, scalar_traits<uint8_t> >::fill(k.u8);
+            lane_kernels_impl<typename Backend::i64, scalar_traits<int64_t> >::fill(k.i64);
+            lane_kernels_impl<typename Backend::f64, scalar_traits<double> >::fill(k.f64);
+            lane_kernels_impl<typename Backend::f64, scalar_traits<double> >::fill_div(k.f64);
+            bit_kernels_impl<typename Backend::bits>::fill(k.bits);
+            return k;
+        }
+
+    } // anonymous namespace
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_SIMD_KERNELS_HPP
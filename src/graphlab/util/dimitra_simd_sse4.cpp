@@ -0,0 +1,223 @@
+#include <graphlab/util/dimitra_simd_kernels.hpp>
+
+// compiled with -msse4.1 -msse4.2, see src/graphlab/CMakeLists.txt
+#if defined(__SSE4_1__)
+
+#include <smmintrin.h>
+
+namespace graphlab {
+
+    namespace {
+
+        /// Expands 4 mask bits to 4 lane-wide masks
+        inline __m128i sse4_expand_bits(unsigned m) {
+            const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+            return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(int(m)), bits), bits);
+        }
+
+        struct sse4_int_traits {
+            typedef int value_type;
+            typedef __m128i vec;
+            enum { width = 4 };
+            static vec load(const int* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void store(int* p, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static vec set1(int v) { return _mm_set1_epi32(v); }
+            static vec add(vec a, vec b) { return _mm_add_epi32(a, b); }
+            static vec mul(vec a, vec b) { return _mm_mullo_epi32(a, b); }
+            static vec min(vec a, vec b) { return _mm_min_epi32(a, b); }
+            static vec max(vec a, vec b) { return _mm_max_epi32(a, b); }
+            static unsigned movemask(vec v) { return _mm_movemask_ps(_mm_castsi128_ps(v)); }
+            static unsigned cmpgt(vec a, vec b) { return movemask(_mm_cmpgt_epi32(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return movemask(_mm_cmplt_epi32(a, b)); }
+            static unsigned cmpeq(vec a, vec b) { return movemask(_mm_cmpeq_epi32(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b) & 0xF; }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm_blendv_epi8(a, b, sse4_expand_bits(m));
+            }
+        };
+
+        struct sse4_float_traits {
+            typedef float value_type;
+            typedef __m128 vec;
+            enum { width = 4 };
+            static vec load(const float* p) { return _mm_loadu_ps(p); }
+            static void store(float* p, vec v) { _mm_storeu_ps(p, v); }
+            static vec set1(float v) { return _mm_set1_ps(v); }
+            static vec add(vec a, vec b) { return _mm_add_ps(a, b); }
+            static vec mul(vec a, vec b) { return _mm_mul_ps(a, b); }
+            static vec div(vec a, vec b) { return _mm_div_ps(a, b); }
+            static vec min(vec a, vec b) { return _mm_min_ps(b, a); }
+            static vec max(vec a, vec b) { return _mm_max_ps(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+            static unsigned cmpeq(vec a, vec b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return _mm_movemask_ps(_mm_cmpneq_ps(a, b)); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm_blendv_ps(a, b, _mm_castsi128_ps(sse4_expand_bits(m)));
+            }
+        };
+
+        /// Expands 8 mask bits to 8 16-bit lane masks
+        inline __m128i sse4_expand_bits16(unsigned m) {
+            const __m128i bits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+            return _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(short(m)), bits), bits);
+        }
+
+        /// Expands 16 mask bits to 16 byte lane masks
+        inline __m128i sse4_expand_bits8(unsigned m) {
+            const __m128i spread = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+            const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                               1, 2, 4, 8, 16, 32, 64, -128);
+            const __m128i v = _mm_shuffle_epi8(_mm_cvtsi32_si128(int(m)), spread);
+            return _mm_cmpeq_epi8(_mm_and_si128(v, bits), bits);
+        }
+
+        /// The low byte of the products of the byte lanes
+        inline __m128i sse4_mullo_epu8(__m128i a, __m128i b) {
+            const __m128i even = _mm_mullo_epi16(a, b);
+            const __m128i odd = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+            return _mm_or_si128(_mm_and_si128(even, _mm_set1_epi16(0xFF)), _mm_slli_epi16(odd, 8));
+        }
+
+        struct sse4_int16_traits {
+            typedef int16_t value_type;
+            typedef __m128i vec;
+            enum { width = 8 };
+            static vec load(const int16_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void store(int16_t* p, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static vec set1(int16_t v) { return _mm_set1_epi16(v); }
+            static vec add(vec a, vec b) { return _mm_adds_epi16(a, b); }
+            static vec mul(vec a, vec b) { return _mm_mullo_epi16(a, b); }
+            static vec min(vec a, vec b) { return _mm_min_epi16(a, b); }
+            static vec max(vec a, vec b) { return _mm_max_epi16(a, b); }
+            static unsigned movemask(vec v) { return _mm_movemask_epi8(_mm_packs_epi16(v, _mm_setzero_si128())); }
+            static unsigned cmpgt(vec a, vec b) { return movemask(_mm_cmpgt_epi16(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return movemask(_mm_cmpgt_epi16(b, a)); }
+            static unsigned cmpeq(vec a, vec b) { return movemask(_mm_cmpeq_epi16(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b) & 0xFF; }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm_blendv_epi8(a, b, sse4_expand_bits16(m));
+            }
+        };
+
+        struct sse4_uint8_traits {
+            typedef uint8_t value_type;
+            typedef __m128i vec;
+            enum { width = 16 };
+            static vec load(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void store(uint8_t* p, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static vec set1(uint8_t v) { return _mm_set1_epi8(char(v)); }
+            static vec add(vec a, vec b) { return _mm_adds_epu8(a, b); }
+            static vec mul(vec a, vec b) { return sse4_mullo_epu8(a, b); }
+            static vec min(vec a, vec b) { return _mm_min_epu8(a, b); }
+            static vec max(vec a, vec b) { return _mm_max_epu8(a, b); }
+            static unsigned cmpeq(vec a, vec b) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b) & 0xFFFF; }
+            // a > b unless max(a, b) == b
+            static unsigned cmpgt(vec a, vec b) { return ~cmpeq(_mm_max_epu8(a, b), b) & 0xFFFF; }
+            static unsigned cmplt(vec a, vec b) { return cmpgt(b, a); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm_blendv_epi8(a, b, sse4_expand_bits8(m));
+            }
+        };
+
+        /// Expands 2 mask bits to 2 64-bit lane masks
+        inline __m128i sse4_expand_bits64(unsigned m) {
+            const __m128i bits = _mm_set_epi64x(2, 1);
+            return _mm_cmpeq_epi64(_mm_and_si128(_mm_set1_epi64x(m), bits), bits);
+        }
+
+        /// The low 64 bits of the products of the 64-bit lanes
+        inline __m128i sse4_mullo_epi64(__m128i a, __m128i b) {
+            const __m128i lo = _mm_mul_epu32(a, b);
+            const __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                                                _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+            return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+        }
+
+        struct sse4_int64_traits {
+            typedef int64_t value_type;
+            typedef __m128i vec;
+            enum { width = 2 };
+            static vec load(const int64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void store(int64_t* p, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static vec set1(int64_t v) { return _mm_set1_epi64x(v); }
+            static vec add(vec a, vec b) { return _mm_add_epi64(a, b); }
+            static vec mul(vec a, vec b) { return sse4_mullo_epi64(a, b); }
+            static vec min(vec a, vec b) { return _mm_blendv_epi8(a, b, _mm_cmpgt_epi64(a, b)); }
+            static vec max(vec a, vec b) { return _mm_blendv_epi8(b, a, _mm_cmpgt_epi64(a, b)); }
+            static unsigned movemask(vec v) { return _mm_movemask_pd(_mm_castsi128_pd(v)); }
+            static unsigned cmpgt(vec a, vec b) { return movemask(_mm_cmpgt_epi64(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return movemask(_mm_cmpgt_epi64(b, a)); }
+            static unsigned cmpeq(vec a, vec b) { return movemask(_mm_cmpeq_epi64(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return ~cmpeq(a, b) & 0x3; }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm_blendv_epi8(a, b, sse4_expand_bits64(m));
+            }
+        };
+
+        struct sse4_double_traits {
+            typedef double value_type;
+            typedef __m128d vec;
+            enum { width = 2 };
+            static vec load(const double* p) { return _mm_loadu_pd(p); }
+            static void store(double* p, vec v) { _mm_storeu_pd(p, v); }
+            static vec set1(double v) { return _mm_set1_pd(v); }
+            static vec add(vec a, vec b) { return _mm_add_pd(a, b); }
+            static vec mul(vec a, vec b) { return _mm_mul_pd(a, b); }
+            static vec div(vec a, vec b) { return _mm_div_pd(a, b); }
+            static vec min(vec a, vec b) { return _mm_min_pd(b, a); }
+            static vec max(vec a, vec b) { return _mm_max_pd(b, a); }
+            static unsigned cmpgt(vec a, vec b) { return _mm_movemask_pd(_mm_cmpgt_pd(a, b)); }
+            static unsigned cmplt(vec a, vec b) { return _mm_movemask_pd(_mm_cmplt_pd(a, b)); }
+            static unsigned cmpeq(vec a, vec b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+            static unsigned cmpneq(vec a, vec b) { return _mm_movemask_pd(_mm_cmpneq_pd(a, b)); }
+            static vec blend(vec a, vec b, unsigned m) {
+                return _mm_blendv_pd(a, b, _mm_castsi128_pd(sse4_expand_bits64(m)));
+            }
+        };
+
+        struct sse4_bit_traits {
+            typedef __m128i vec;
+            enum { width = 2 };
+            static vec load(const uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void store(uint64_t* p, vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static vec bit_or(vec a, vec b) { return _mm_or_si128(a, b); }
+            static vec bit_and(vec a, vec b) { return _mm_and_si128(a, b); }
+            static vec bit_andnot(vec a, vec b) { return _mm_andnot_si128(a, b); }
+            static vec bit_not(vec a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+            static bool zeros(vec a) { return _mm_testz_si128(a, a); }
+            static bool ones(vec a) { return _mm_testc_si128(a, _mm_set1_epi32(-1)); }
+        };
+
+        struct sse4_backend {
+            typedef sse4_int_traits i32;
+            typedef sse4_float_traits f32;
+            typedef sse4_int16_traits i16;
+            typedef sse4_uint8_traits u8;
+            typedef sse4_int64_traits i64;
+            typedef sse4_double_traits f64;
+            typedef sse4_bit_traits bits;
+        };
+
+    } // anonymous namespace
+
+    namespace automi_simd_backends {
+        const automi_simd_kernels* sse4() {
+            static const automi_simd_kernels kernels =
+                make_simd_kernels<sse4_backend>(AUTOMI_ISA_SSE4, "sse4");
+            return &kernels;
+        }
+    }
+
+}
+
+#else
+
+namespace graphlab {
+    namespace automi_simd_backends {
+        const automi_simd_kernels* sse4() { return NULL; }
+    }
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef GRAPHLAB_DIMITRA_SLAB_VECTOR_HPP
+#define GRAPHLAB_DIMITRA_SLAB_VECTOR_HPP
+
+#include <utility>
+#include <vector>
+#include <graphlab/util/dense_bitset.hpp>
+
+namespace graphlab {
+
+    /**
+     * \brief The per-vertex buffers of an engine (vertex programs,
+     * messages, gather accumulators), with a reset to the default value.
+     *
+     * Without 'Lazy', reset(i) assigns a default constructed T, as the
+     * engines always did.  For types owning heap lanes, such as the
+     * AutoMI lane vectors, that is an allocation, a swap and a release
+     * per vertex per phase.
+     *
+     * With 'Lazy', all the entries are constructed once by resize() and
+     * keep their storage for the life of the engine.  reset(i) only marks
+     * entry i stale, in O(1), and the next access to it copies a default
+     * prototype into it in place, which reuses its lanes.  An entry which
+     * is reset and not used again in the superstep costs nothing more.
+     * The prototype is rebuilt by refresh_default(), so the default value
+     * may follow a change of the number of lanes between supersteps.
+     *
+     * Entries are accessed under the same rules as a std::vector: an
+     * entry is used by one thread at a time.
+     */
+    template <typename T, bool Lazy>
+    class automi_slab_vector {
+    public:
+        typedef T value_type;
+
+        /// Resizes to 'n' entries, the new ones holding the default value
+        void resize(size_t n) {
+            refresh_default();
+            if (Lazy) items.resize(n, proto);
+            else items.resize(n, T());
+            // the new bits are 0
+            stale.resize(n);
+        }
+
+        inline size_t size() const { return items.size(); }
+
+        /// Returns entry 'i', first resetting it if it is stale
+        inline T& operator[](size_t i) {
+            if (Lazy && stale.get(i)) revive(i);
+            return items[i];
+        }
+
+        /// Overwrites entry 'i', without first resetting it if it is stale
+        inline void assign(size_t i, const T& value) {
+            if (Lazy) stale.clear_bit(i);
+            items[i] = value;
+        }
+
+        inline void assign(size_t i, T&& value) {
+            if (Lazy) stale.clear_bit(i);
+            items[i] = std::move(value);
+        }
+
+        /// Resets entry 'i' to the default value
+        inline void reset(size_t i) {
+            if (Lazy) stale.set_bit(i);
+            else items[i] = T();
+        }
+
+        /// Resets all the entries to the default value
+        void reset_all() {
+            if (Lazy) {
+                stale.fill();
+                return;
+            }
+            for (size_t i = 0; i < items.size(); ++i) items[i] = T();
+        }
+
+        /// Rebuilds the default value copied into the stale entries
+        inline void refresh_default() {
+            if (Lazy) proto = T();
+        }
+
+    private:
+        /// Resets the stale entry 'i' in place
+        inline void revive(size_t i) {
+            items[i] = proto;
+            stale.clear_bit(i);
+        }
+
+        std::vector<T> items;
+        /// Only used if Lazy
+        T proto;
+        dense_bitset stale;
+    };
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_SLAB_VECTOR_HPP
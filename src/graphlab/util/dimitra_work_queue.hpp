@@ -0,0 +1,116 @@
+#ifndef GRAPHLAB_DIMITRA_WORK_QUEUE_HPP
+#define GRAPHLAB_DIMITRA_WORK_QUEUE_HPP
+
+#include <algorithm>
+#include <vector>
+#include <graphlab/parallel/pthread_tools.hpp>
+
+namespace graphlab {
+
+    /**
+     * \brief Hands out the items [0, n) of a parallel loop to a fixed set
+     * of threads, in chunks of about equal weight, with work stealing.
+     *
+     * The weight of the items is given by their prefix sums: item i weighs
+     * prefix[i + 1] - prefix[i].  reset() gives each thread a contiguous
+     * range of items of about the same total weight, which acts as its
+     * deque: the thread takes chunks of CHUNK_RATIO-th of its share of the
+     * weight from the front of its range, and once it is empty, steals the
+     * back half (by weight) of the range of another thread.  Items are
+     * claimed exactly once.
+     */
+    class automi_work_queue {
+    public:
+        /// The number of chunks in the share of the weight of a thread
+        enum { CHUNK_RATIO = 16 };
+
+        automi_work_queue() : prefix(NULL), chunk(1) {}
+
+        /**
+         * Splits the items [0, n) among 'nthreads' threads.  'prefix' holds
+         * n + 1 non-decreasing weights starting at 0, and must live until
+         * the items are all claimed.
+         */
+        void reset(size_t nthreads, const size_t* prefix, size_t n) {
+            this->prefix = prefix;
+            if (ranges.size() != nthreads) ranges = std::vector<range>(nthreads);
+            const size_t total = prefix[n];
+            chunk = std::max<size_t>(1, total / (nthreads * CHUNK_RATIO));
+            size_t begin = 0;
+            for (size_t t = 0; t < nthreads; ++t) {
+                const size_t end = t + 1 == nthreads ? n : item_at(total * (t + 1) / nthreads, begin, n);
+                ranges[t].begin = begin;
+                ranges[t].end = end;
+                begin = end;
+            }
+        }
+
+        /**
+         * Claims the next chunk [begin, end) of thread 'thread_id'.
+         *
+         * @return false once no thread has items left.
+         */
+        bool next(size_t thread_id, size_t& begin, size_t& end) {
+            range& own = ranges[thread_id];
+            while (true) {
+                own.lock.lock();
+                if (own.begin < own.end) {
+                    begin = own.begin;
+                    // at least one item, and items up to the chunk weight
+                    end = std::max(begin + 1, item_at(prefix[begin] + chunk, begin, own.end));
+                    own.begin = end;
+                    own.lock.unlock();
+                    return true;
+                }
+                own.lock.unlock();
+                if (!steal(thread_id)) return false;
+            }
+        }
+
+    private:
+        struct range {
+            simple_spinlock lock;
+            size_t begin, end;
+            /// keeps the ranges of the threads on separate cache lines
+            char padding[64];
+            range() : begin(0), end(0) {}
+        };
+
+        /// Returns the first item in [begin, end) whose prefix is >= 'weight', or end
+        inline size_t item_at(size_t weight, size_t begin, size_t end) const {
+            return std::lower_bound(prefix + begin, prefix + end, weight) - prefix;
+        }
+
+        /// Moves the back half of the range of another thread to 'thread_id'
+        bool steal(size_t thread_id) {
+            for (size_t k = 1; k < ranges.size(); ++k) {
+                range& victim = ranges[(thread_id + k) % ranges.size()];
+                victim.lock.lock();
+                if (victim.begin < victim.end) {
+                    const size_t half = (prefix[victim.begin] + prefix[victim.end]) / 2;
+                    const size_t mid = std::min(victim.end - 1,
+                                                item_at(half, victim.begin, victim.end));
+                    const size_t end = victim.end;
+                    victim.end = mid;
+                    victim.lock.unlock();
+                    range& own = ranges[thread_id];
+                    own.lock.lock();
+                    own.begin = mid;
+                    own.end = end;
+                    own.lock.unlock();
+                    return true;
+                }
+                victim.lock.unlock();
+            }
+            return false;
+        }
+
+        std::vector<range> ranges;
+        const size_t* prefix;
+        /// The weight of a chunk taken from the front of a range
+        size_t chunk;
+    };
+
+}
+
+#endif  // GRAPHLAB_DIMITRA_WORK_QUEUE_HPP
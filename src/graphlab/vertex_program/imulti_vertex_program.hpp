@@ -0,0 +1,213 @@
+#ifndef GRAPHLAB_IMULTI_VERTEX_PROGRAM_HPP
+#define GRAPHLAB_IMULTI_VERTEX_PROGRAM_HPP
+
+#include <vector>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <graphlab/vertex_program/ivertex_program.hpp>
+#include <graphlab/util/dimitra_bitvec.hpp>
+
+#include <graphlab/macros_def.hpp>
+
+namespace graphlab {
+
+  /**
+   * \brief The imulti_vertex_program class extends the vertex program
+   * interface for AutoMI multi-instance programs, in which the vertex
+   * data, gather type and message type hold one lane per query
+   * (see \ref graphlab::automi_bitvec).
+   *
+   * A multi-instance vertex program carries the set of lanes it is
+   * active for.  The multi-instance engines (\ref dimitra_sync_engine)
+   * compute the lanes from the incoming message with
+   * \ref message_lanes before calling init, and narrow them to
+   * \ref changed_lanes after apply.  Vertices without any active lane
+   * are not gathered, applied or scattered at all, and the lanes are
+   * shipped to the mirrors together with the vertex program so that
+   * gather and scatter can restrict their lane operations to
+   * \ref active_lanes:
+   *
+   * \code
+   * msg_type gather(icontext_type& context, const vertex_type& vertex,
+   *                 edge_type& edge) const {
+   *   msg_type msg;
+   *   msg.ans.vec_op_add_update_mask(active_lanes(),
+   *                                  get_other_vertex(edge, vertex).data().ans,
+   *                                  edge.data().dist);
+   *   return msg;
+   * }
+   * \endcode
+   *
+   * Programs that keep additional state must serialize the lanes
+   * with \ref save_lanes and \ref load_lanes in their own save and
+   * load functions.
+   *
+   * To run with the <b>delta_sync</b> engine option, the vertex data
+   * must also provide
+   * <code>masked_save(oarchive&, const lane_mask_type&) const</code>
+   * and <code>masked_load(iarchive&, const lane_mask_type&)</code>,
+   * which only (de)serialize the lanes set in the mask.  The
+   * <b>masked_messages</b> engine option needs the same two functions
+   * on the message type, and sends the lanes returned by
+   * \ref message_lanes.
+   *
+   * A lane retires once no vertex in the cluster has changed it in a
+   * superstep.  To run with the <b>lane_compaction</b> engine option,
+   * which drops the retired lanes from the lane vectors, the program
+   * must implement \ref compact_lanes, \ref compact_vertex and
+   * \ref compact_message, usually with automi_bitvec::compact.  The
+   * results of the dropped lanes are emitted with \ref retire_lanes
+   * before they are compacted away.
+   *
+   * With the <b>stream_queries</b> engine option the engine emits the
+   * results of each retired lane with \ref retire_lanes and runs the
+   * queued queries in the freed lanes: the lanes are cleared with
+   * \ref reset_lanes and the sources are seeded with the message
+   * returned by \ref source_message through source_init.
+   */
+  template<typename Graph,
+           typename GatherType,
+           typename MessageType = graphlab::empty>
+  class imulti_vertex_program :
+    public ivertex_program<Graph, GatherType, MessageType> {
+  public:
+    typedef ivertex_program<Graph, GatherType, MessageType> ivertex_program_type;
+    typedef typename ivertex_program_type::message_type message_type;
+    typedef typename ivertex_program_type::vertex_type vertex_type;
+
+    /// The type of the per-lane activity mask
+    typedef automi_bitvec<bool> lane_mask_type;
+
+    virtual ~imulti_vertex_program() { }
+
+    /**
+     * \brief Computes the lanes carried by a message.
+     *
+     * Called by the engine on the master before init.  The returned
+     * mask must be sized to the number of lanes; a vertex whose
+     * message carries no lane is skipped for the superstep.
+     */
+    virtual void message_lanes(const message_type& message,
+                               lane_mask_type& ret) const = 0;
+
+    /**
+     * \brief Computes the lanes modified by the last apply.
+     *
+     * Called by the engine after apply.  The default keeps all the
+     * active lanes, programs that track a dirty mask should return
+     * it so that unchanged lanes are neither synchronized nor
+     * scattered.
+     */
+    virtual void changed_lanes(lane_mask_type& ret) const {
+      ret = lanes;
+    }
+
+    /**
+     * \brief Drops the retired lanes from the lane count of the
+     * program.
+     *
+     * Called by the engine once per machine, before compacting the
+     * vertices and messages, with the lanes which are kept.  Lane i of
+     * the compacted vectors is the i-th lane set in 'keep'; programs
+     * which size their vectors from a global lane count should set it
+     * to the number of kept lanes.
+     */
+    virtual void compact_lanes(const lane_mask_type& keep) const {
+      logstream(LOG_FATAL)
+        << "The vertex program does not support lane compaction" << std::endl;
+    }
+
+    /**
+     * \brief Compacts the lane vectors of the vertex data to the lanes
+     * set in 'keep'.
+     *
+     * Called on the master and on every mirror of each vertex.  The
+     * dropped lanes hold the final values of the retired queries, which
+     * were emitted with \ref retire_lanes and are lost after the call.
+     */
+    virtual void compact_vertex(vertex_type& vertex,
+                                const lane_mask_type& keep) const {
+      logstream(LOG_FATAL)
+        << "The vertex program does not support lane compaction" << std::endl;
+    }
+
+    /// Compacts the lane vectors of a pending message to the lanes set in 'keep'
+    virtual void compact_message(message_type& message,
+                                 const lane_mask_type& keep) const {
+      logstream(LOG_FATAL)
+        << "The vertex program does not support lane compaction" << std::endl;
+    }
+
+    /**
+     * \brief Emits the results of the retired lanes of a vertex.
+     *
+     * Called by the engine with the <b>stream_queries</b> option on the
+     * master of every vertex after the lanes in 'retired' have
+     * converged in the whole cluster, and with <b>lane_compaction</b>
+     * before the lanes in 'retired' are compacted away, from several
+     * threads at once.
+     * 'queries' maps each lane to the query it ran.  The default
+     * emits nothing.
+     */
+    virtual void retire_lanes(const vertex_type& vertex,
+                              const lane_mask_type& retired,
+                              const std::vector<size_t>& queries) const { }
+
+    /**
+     * \brief Restores the lanes set in 'lanes' of the vertex data to
+     * their initial values before they run a new query.
+     *
+     * Called on the master and on every mirror of each vertex.
+     */
+    virtual void reset_lanes(vertex_type& vertex,
+                             const lane_mask_type& lanes) const {
+      logstream(LOG_FATAL)
+        << "The vertex program does not support lane recycling" << std::endl;
+    }
+
+    /// Returns the message which seeds the source of a query run in 'lane'
+    virtual message_type source_message(size_t lane) const {
+      logstream(LOG_FATAL)
+        << "The vertex program does not support lane recycling" << std::endl;
+      return message_type();
+    }
+
+    /// Returns the lanes this vertex program is active for
+    const lane_mask_type& active_lanes() const { return lanes; }
+
+    /// Sets the lanes this vertex program is active for
+    void set_active_lanes(const lane_mask_type& mask) { lanes = mask; }
+
+    /// Serializes the active lanes
+    void save_lanes(oarchive& oarc) const { oarc << lanes; }
+
+    /// Deserializes the active lanes
+    void load_lanes(iarchive& iarc) { iarc >> lanes; }
+
+    void save(oarchive& oarc) const { save_lanes(oarc); }
+
+    void load(iarchive& iarc) { load_lanes(iarc); }
+
+  protected:
+    /// The lanes this vertex program is active for
+    lane_mask_type lanes;
+  }; // end of imulti_vertex_program
+
+
+  /**
+   * \brief Tests whether a vertex program implements the
+   * \ref imulti_vertex_program interface.
+   */
+  template<typename VertexProgram>
+  struct is_multi_vertex_program :
+    public boost::is_base_of<
+      imulti_vertex_program<typename VertexProgram::graph_type,
+                            typename VertexProgram::gather_type,
+                            typename VertexProgram::message_type>,
+      VertexProgram> { };
+
+}; // end of namespace graphlab
+
+#include <graphlab/macros_undef.hpp>
+
+#endif
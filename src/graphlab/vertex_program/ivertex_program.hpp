@@ -26,6 +26,8 @@
 #ifndef GRAPHLAB_IVERTEX_PROGRAM_HPP
 #define GRAPHLAB_IVERTEX_PROGRAM_HPP
 
+#include <utility>
+#include <boost/type_traits/integral_constant.hpp>
 
 #include <graphlab/vertex_program/icontext.hpp>
 #include <graphlab/util/empty.hpp>
@@ -34,6 +36,9 @@
 #include <graphlab/serialization/serialization_includes.hpp>
 #include <graphlab/vertex_program/op_plus_eq_concept.hpp>
 #include <graphlab/util/dimitra_bitvec.hpp>
+#include <graphlab/util/dimitra_fixedvec.hpp>
+#include <graphlab/util/dimitra_hybridvec.hpp>
+#include <graphlab/util/dimitra_lane_arena.hpp>
 #include <graphlab/util/dimitra_automaton.hpp>
 #include <graphlab/util/dimitra_automaton_bk.hpp>
 
@@ -615,6 +620,10 @@ namespace graphlab {
      * \return the result of the gather computation which will be
      * "summed" to produce the input to the apply operation.  The
      * behavior of the "sum" is defined by the \ref gather_type.
+     *
+     * A vertex program may also define a non-virtual gather_into
+     * which adds the result straight into the accumulator, see
+     * \ref has_gather_into.
      * 
      */
     virtual gather_type gather(icontext_type& context, 
@@ -776,7 +785,176 @@ namespace graphlab {
     }
 
   };  // end of ivertex_program
- 
+
+
+  namespace gather_into_impl {
+    template<typename T>
+    char test(decltype(std::declval<const T&>().gather_into(
+                         std::declval<typename T::icontext_type&>(),
+                         std::declval<const typename T::vertex_type&>(),
+                         std::declval<typename T::edge_type&>(),
+                         std::declval<typename T::gather_type&>()), 0)*);
+    template<typename T>
+    long test(...);
+  }; // end of namespace gather_into_impl
+
+  /**
+   * \brief Tests whether a vertex program defines the optional
+   * in-place gather
+   *
+   * \code
+   * void gather_into(icontext_type& context, const vertex_type& vertex,
+   *                  edge_type& edge, gather_type& accum) const;
+   * \endcode
+   *
+   * which must have the effect of
+   * <code>accum += gather(context, vertex, edge)</code> without
+   * building the gather_type temporary.  The engines use it for every
+   * edge of a local gather but the first one, which still calls
+   * \ref ivertex_program::gather to initialize the accumulator.
+   */
+  template<typename VertexProgram>
+  struct has_gather_into :
+    public boost::integral_constant<bool,
+      sizeof(gather_into_impl::test<VertexProgram>(0)) == sizeof(char)> { };
+
+  namespace gather_into_impl {
+    template<typename VertexProgram>
+    inline void accumulate(const VertexProgram& vprog,
+                           typename VertexProgram::icontext_type& context,
+                           const typename VertexProgram::vertex_type& vertex,
+                           typename VertexProgram::edge_type& edge,
+                           typename VertexProgram::gather_type& accum,
+                           boost::true_type) {
+      vprog.gather_into(context, vertex, edge, accum);
+    }
+    template<typename VertexProgram>
+    inline void accumulate(const VertexProgram& vprog,
+                           typename VertexProgram::icontext_type& context,
+                           const typename VertexProgram::vertex_type& vertex,
+                           typename VertexProgram::edge_type& edge,
+                           typename VertexProgram::gather_type& accum,
+                           boost::false_type) {
+      accum += vprog.gather(context, vertex, edge);
+    }
+  }; // end of namespace gather_into_impl
+
+  /**
+   * \brief Adds the gather of an edge to a local accumulator which
+   * already holds a value, in place if the vertex program defines
+   * gather_into (see \ref has_gather_into).
+   */
+  template<typename VertexProgram>
+  inline void gather_accumulate(const VertexProgram& vprog,
+                                typename VertexProgram::icontext_type& context,
+                                const typename VertexProgram::vertex_type& vertex,
+                                typename VertexProgram::edge_type& edge,
+                                typename VertexProgram::gather_type& accum) {
+    gather_into_impl::accumulate(vprog, context, vertex, edge, accum,
+                                 typename has_gather_into<VertexProgram>::type());
+  }
+
+
+  namespace pull_gather_impl {
+    template<typename T>
+    char test(decltype(std::declval<const T&>().pull_gather(
+                         std::declval<typename T::icontext_type&>(),
+                         std::declval<const typename T::vertex_type&>(),
+                         std::declval<typename T::edge_type&>()),
+                       std::declval<const T&>().pull_candidate(
+                         std::declval<typename T::icontext_type&>(),
+                         std::declval<const typename T::vertex_type&>()), 0)*);
+    template<typename T>
+    long test(...);
+  }; // end of namespace pull_gather_impl
+
+  /**
+   * \brief Tests whether a vertex program defines the optional
+   * bottom-up (pull) hooks
+   *
+   * \code
+   * gather_type pull_gather(icontext_type& context, const vertex_type& vertex,
+   *                         edge_type& edge) const;
+   * bool pull_candidate(icontext_type& context, const vertex_type& vertex) const;
+   * \endcode
+   *
+   * used by the <b>direction</b> option of the
+   * \ref powerlyra_sync_engine.  In a pull superstep the engine does
+   * not scatter the vertices changed by the previous apply.  Instead,
+   * every vertex for which pull_candidate returns true (typically a
+   * vertex with a lane still unreached) is activated with a default
+   * constructed vertex program, and pull_gather reads the neighbor
+   * across the gather edges, returning what the neighbor would have
+   * signaled to the vertex had it been scattered.  The vertex data of
+   * the neighbors is the one left by the previous apply.
+   */
+  template<typename VertexProgram>
+  struct has_pull_gather :
+    public boost::integral_constant<bool,
+      sizeof(pull_gather_impl::test<VertexProgram>(0)) == sizeof(char)> { };
+
+  namespace pull_gather_impl {
+    template<typename VertexProgram>
+    inline typename VertexProgram::gather_type
+    gather(const VertexProgram& vprog,
+           typename VertexProgram::icontext_type& context,
+           const typename VertexProgram::vertex_type& vertex,
+           typename VertexProgram::edge_type& edge,
+           boost::true_type) {
+      return vprog.pull_gather(context, vertex, edge);
+    }
+    template<typename VertexProgram>
+    inline typename VertexProgram::gather_type
+    gather(const VertexProgram& vprog,
+           typename VertexProgram::icontext_type& context,
+           const typename VertexProgram::vertex_type& vertex,
+           typename VertexProgram::edge_type& edge,
+           boost::false_type) {
+      return vprog.gather(context, vertex, edge);
+    }
+    template<typename VertexProgram>
+    inline bool candidate(const VertexProgram& vprog,
+                          typename VertexProgram::icontext_type& context,
+                          const typename VertexProgram::vertex_type& vertex,
+                          boost::true_type) {
+      return vprog.pull_candidate(context, vertex);
+    }
+    template<typename VertexProgram>
+    inline bool candidate(const VertexProgram& vprog,
+                          typename VertexProgram::icontext_type& context,
+                          const typename VertexProgram::vertex_type& vertex,
+                          boost::false_type) {
+      return false;
+    }
+  }; // end of namespace pull_gather_impl
+
+  /**
+   * \brief Gathers an edge of a pull superstep with the pull_gather of
+   * the vertex program, or with its gather if it has none (see
+   * \ref has_pull_gather).
+   */
+  template<typename VertexProgram>
+  inline typename VertexProgram::gather_type
+  gather_pull(const VertexProgram& vprog,
+              typename VertexProgram::icontext_type& context,
+              const typename VertexProgram::vertex_type& vertex,
+              typename VertexProgram::edge_type& edge) {
+    return pull_gather_impl::gather(vprog, context, vertex, edge,
+                                    typename has_pull_gather<VertexProgram>::type());
+  }
+
+  /**
+   * \brief Returns true if the vertex is activated by a pull
+   * superstep, always false if the vertex program has no pull hooks.
+   */
+  template<typename VertexProgram>
+  inline bool is_pull_candidate(const VertexProgram& vprog,
+                                typename VertexProgram::icontext_type& context,
+                                const typename VertexProgram::vertex_type& vertex) {
+    return pull_gather_impl::candidate(vprog, context, vertex,
+                                       typename has_pull_gather<VertexProgram>::type());
+  }
+
 }; //end of namespace graphlab
 #include <graphlab/macros_undef.hpp>
 
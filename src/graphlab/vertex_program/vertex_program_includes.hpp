@@ -23,6 +23,7 @@
 
 
 #include <graphlab/vertex_program/ivertex_program.hpp>
+#include <graphlab/vertex_program/imulti_vertex_program.hpp>
 #include <graphlab/vertex_program/messages.hpp>
 #include <graphlab/vertex_program/icontext.hpp>
 
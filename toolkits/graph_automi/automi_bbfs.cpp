@@ -128,6 +128,23 @@ public:
         return msg_type();
     }
 
+    // the gather is the identity of msg_type::operator+=
+    void gather_into(icontext_type& context, const vertex_type& vertex,
+                     edge_type& edge, msg_type& accum) const { }
+
+    // bottom-up gather (engine option direction): the lanes which reach
+    // the in-neighbor
+    msg_type pull_gather(icontext_type& context, const vertex_type& vertex,
+                         edge_type& edge) const {
+        const vertex_type other = get_other_vertex(edge, vertex);
+        return msg_type(other.data().ans);
+    }
+
+    // the vertex is not reached yet in some lane
+    bool pull_candidate(icontext_type& context, const vertex_type& vertex) const {
+        return !vertex.data().ans.vec_all();
+    }
+
     // Apply function
     void apply(icontext_type& context, vertex_type& vertex,
                const msg_type& msg_accum) {
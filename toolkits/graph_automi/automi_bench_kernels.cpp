@@ -0,0 +1,292 @@
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <graphlab/options/command_line_options.hpp>
+#include <graphlab/serialization/serialization_includes.hpp>
+#include <graphlab/util/dimitra_bitvec.hpp>
+#include <graphlab/util/dimitra_fixedvec.hpp>
+#include <graphlab/util/dimitra_hybridvec.hpp>
+#include <graphlab/util/timer.hpp>
+
+/**
+ * \file
+ * Single node microbenchmark of the AutoMI lane vector operators
+ * (graphlab::automi_bitvec), for every lane type, lane count and SIMD
+ * backend available on this CPU.  No MPI is involved.
+ *
+ * Each operator is repeated until it has run for at least min_time
+ * seconds; the report has one line per (isa, type, lanes, op) with the
+ * time per call and the bandwidth over the lane bytes it reads and
+ * writes.  The working set is a handful of vectors, so the numbers are
+ * the in-cache throughput of the kernels.
+ *
+ * Before it is timed, the masked serialization of each lane vector is
+ * checked to round trip, and load and masked_load are checked to read
+ * back the buffer they are timed on.  The benchmark exits if they do
+ * not.
+ */
+
+double MIN_TIME = 0.05;
+
+/**
+ * \brief Runs 'op' until it took at least MIN_TIME seconds, and prints
+ * its time per call and bandwidth over 'bytes' bytes per call.
+ */
+template <typename Op>
+void measure(const char* isa, const char* type, size_t lanes,
+             const char* name, size_t bytes, Op op) {
+  // warm up the caches and the pool of lane buffers
+  for (size_t i = 0; i < 16; ++i) op();
+  size_t iters = 64;
+  double elapsed = 0;
+  while (true) {
+    graphlab::timer ti;
+    for (size_t i = 0; i < iters; ++i) op();
+    elapsed = ti.current_time();
+    if (elapsed >= MIN_TIME) break;
+    iters = size_t(iters * (elapsed > 0 ? std::min(16.0, 2 * MIN_TIME / elapsed) : 16.0));
+  }
+  const double ns = elapsed * 1e9 / iters;
+  printf("%-10s %-7s %6zu  %-30s %10.2f %9.2f\n",
+         isa, type, lanes, name, ns, bytes / ns);
+}
+
+/**
+ * \brief Checks that masked_load() into a copy of 'other' reads back the
+ * lanes of 'v' set in 'mask' and keeps the other lanes of 'other'.  The
+ * lanes go through a buffered archive at every offset up to 8 bytes, so
+ * both the in-place and the unaligned paths are taken, and through a
+ * stream archive, each time followed by a sentinel which must be read
+ * back after them.  Exits on a mismatch.
+ */
+template <typename Vec, typename Mask>
+void check_masked(const char* isa, const char* what, size_t n,
+                  Vec& v, const Mask& mask, Vec& other) {
+  const size_t sentinel = 0x5e471e1;
+  for (size_t head = 0; head <= 8; ++head) {
+    for (size_t stream = 0; stream < 2; ++stream) {
+      std::stringstream strm;
+      graphlab::oarchive buffered, streamed(strm);
+      graphlab::oarchive& oarc = stream ? streamed : buffered;
+      for (size_t i = 0; i < head; ++i) oarc << char(i);
+      v.masked_save(oarc, mask);
+      oarc << sentinel;
+      const std::string saved = strm.str();
+      graphlab::iarchive iarc(stream ? saved.data() : buffered.buf,
+                              stream ? saved.size() : buffered.off);
+      for (size_t i = 0; i < head; ++i) { char c; iarc >> c; }
+      Vec loaded(other);
+      loaded.masked_load(iarc, mask);
+      size_t tail = 0;
+      iarc >> tail;
+      bool ok = (tail == sentinel);
+      for (size_t i = 0; ok && i < n; ++i) {
+        ok = loaded.get_single(i) ==
+             (mask.test_bit(i) ? v.get_single(i) : other.get_single(i));
+      }
+      free(buffered.buf);
+      if (!ok) {
+        fprintf(stderr, "%s %s %zu: masked_load does not read back masked_save "
+                "(%s archive, %zu bytes ahead)\n", isa, what, n,
+                stream ? "stream" : "buffered", head);
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+}
+
+/// Exits unless 'ok', which tells whether 'name' read back the saved lanes
+void expect_lanes(bool ok, const char* isa, const char* type, size_t n,
+                  const char* name) {
+  if (ok) return;
+  fprintf(stderr, "%s %s %zu: %s does not read back the saved lanes\n",
+          isa, type, n, name);
+  exit(EXIT_FAILURE);
+}
+
+/// Checks the masked serialization of the fixed size and hybrid vectors
+void check_containers(const char* isa) {
+  const size_t n = 64;
+  graphlab::automi_fixedvec<bool, n> fmask;
+  graphlab::automi_fixedvec<int, n> fa, fb;
+  graphlab::automi_fixedvec<float, n> fc, fd;
+  graphlab::automi_bitvec<bool> mask(n), few(n);
+  graphlab::automi_hybridvec<int> sparse(n), dense(n), empty(n);
+  for (size_t i = 0; i < n; ++i) {
+    fmask.set_single(i % 3 == 0, i);
+    mask.set_single(i % 3 == 0, i);
+    few.set_single(i % 16 == 1, i);
+    fa.set_single(int(i + 1), i);
+    fb.set_single(-1, i);
+    fc.set_single(float(i) / 2, i);
+    fd.set_single(-1, i);
+    dense.set_single(int(i), i);
+    if (i % 16 == 1) sparse.set_single(int(i), i);
+  }
+  check_masked(isa, "fixedvec<int>", n, fa, fmask, fb);
+  check_masked(isa, "fixedvec<float>", n, fc, fmask, fd);
+  // a sparse vector masked with its present lanes sends its packed lanes
+  check_masked(isa, "hybridvec", n, sparse, few, empty);
+  check_masked(isa, "hybridvec", n, sparse, few, dense);
+  check_masked(isa, "hybridvec", n, dense, mask, empty);
+  check_masked(isa, "hybridvec", n, dense, mask, sparse);
+}
+
+/// Values which keep every operator in range, including mul
+template <typename T>
+T lane_value(size_t i) { return T(i % 7 + 1); }
+
+template <typename T>
+void bench_type(const char* isa, const char* type, size_t n) {
+  typedef graphlab::automi_bitvec<T> vec_type;
+  typedef graphlab::automi_bitvec<bool> mask_type;
+  vec_type a(n), b(n), c(n);
+  mask_type mask(n);
+  for (size_t i = 0; i < n; ++i) {
+    a.set_single(lane_value<T>(i), i);
+    b.set_single(lane_value<T>(i + 3), i);
+    mask.set_single(i % 3 == 0, i);
+  }
+  const T val = T(1);
+  const size_t vb = sizeof(T) * n;  // bytes of one lane vector
+  const size_t mb = (n + 7) / 8;    // bytes of one lane mask
+
+  measure(isa, type, n, "set_all", vb, [&] { c.set_all(val); });
+  measure(isa, type, n, "copy", 2 * vb, [&] { c = a; });
+  measure(isa, type, n, "pair_op_min", 3 * vb, [&] { vec_type::pair_op_min(c, b); });
+  measure(isa, type, n, "pair_op_max", 3 * vb, [&] { vec_type::pair_op_max(c, b); });
+  measure(isa, type, n, "pair_op_add", 3 * vb, [&] { c = a; vec_type::pair_op_add(c, b); });
+  measure(isa, type, n, "pair_op_mul", 3 * vb, [&] { c = a; vec_type::pair_op_mul(c, b); });
+  measure(isa, type, n, "vec_op_set", 2 * vb, [&] { c.vec_op_set(a); });
+  measure(isa, type, n, "vec_op_set_mask", 3 * vb + mb,
+          [&] { c.vec_op_set_mask(mask, a); });
+  measure(isa, type, n, "vec_op_add_min_update", 3 * vb,
+          [&] { c.vec_op_add_min_update(a, val); });
+  measure(isa, type, n, "vec_op_add_min_update_mask", 3 * vb + mb,
+          [&] { c.vec_op_add_min_update_mask(mask, a, val); });
+  mask_type gt(n);
+  measure(isa, type, n, "vec_op_min_update", 3 * vb + mb,
+          [&] { c.vec_op_min_update(b, gt); });
+  measure(isa, type, n, "vec_op_min_update_mask", 3 * vb + 3 * mb,
+          [&] { c.vec_op_min_update_mask(mask, b, gt); });
+  measure(isa, type, n, "vec_op_add_min_update_changed", 3 * vb + mb,
+          [&] { c.vec_op_add_min_update(a, val, gt); });
+  // the lane mask kernel behind mask_type::vec_op_cmpgt_update
+  measure(isa, type, n, "cmpgt", 2 * vb + mb, [&] {
+    graphlab::automi_simd_lanes<T>::get().cmpgt(gt.array, a.array, b.array, 8 * a.arrlen);
+  });
+
+  check_masked(isa, type, n, a, mask, b);
+  graphlab::oarchive oarc;
+  measure(isa, type, n, "save", vb, [&] { oarc.off = 0; oarc << a; });
+  const size_t saved = oarc.off;
+  {
+    graphlab::iarchive iarc(oarc.buf, saved);
+    iarc >> c;
+    bool ok = (iarc.off == saved);
+    for (size_t i = 0; ok && i < n; ++i) ok = c.get_single(i) == a.get_single(i);
+    expect_lanes(ok, isa, type, n, "load");
+  }
+  measure(isa, type, n, "load", vb, [&] {
+    graphlab::iarchive iarc(oarc.buf, saved);
+    iarc >> c;
+  });
+  measure(isa, type, n, "masked_save", vb, [&] { oarc.off = 0; a.masked_save(oarc, mask); });
+  const size_t masked = oarc.off;
+  {
+    // the timed loads read the buffer of the last timed save
+    graphlab::iarchive iarc(oarc.buf, masked);
+    c = b;
+    c.masked_load(iarc, mask);
+    bool ok = (iarc.off == masked);
+    for (size_t i = 0; ok && i < n; ++i) {
+      ok = c.get_single(i) == (mask.test_bit(i) ? a.get_single(i) : b.get_single(i));
+    }
+    expect_lanes(ok, isa, type, n, "masked_load");
+  }
+  measure(isa, type, n, "masked_load", vb, [&] {
+    graphlab::iarchive iarc(oarc.buf, masked);
+    c.masked_load(iarc, mask);
+  });
+  free(oarc.buf);
+}
+
+void bench_mask(const char* isa, size_t n) {
+  typedef graphlab::automi_bitvec<bool> mask_type;
+  mask_type a(n), b(n), c(n);
+  for (size_t i = 0; i < n; ++i) {
+    a.set_single(i % 3 == 0, i);
+    b.set_single(i % 5 == 0, i);
+  }
+  const size_t mb = (n + 7) / 8;
+  size_t sink = 0;
+  measure(isa, "bool", n, "copy", 2 * mb, [&] { c = a; });
+  measure(isa, "bool", n, "pair_op_or", 3 * mb, [&] { mask_type::pair_op_or(c, b); });
+  measure(isa, "bool", n, "vec_op_or_update", 3 * mb, [&] { c.vec_op_or_update(a); });
+  measure(isa, "bool", n, "vec_op_andnot_update", 3 * mb,
+          [&] { c.vec_op_andnot_update(a, b); });
+  measure(isa, "bool", n, "vec_op_negate", 2 * mb, [&] { a.vec_op_negate(c); });
+  measure(isa, "bool", n, "count", mb, [&] { sink += a.count(); });
+  measure(isa, "bool", n, "vec_all_zeros", mb, [&] { sink += a.vec_all_zeros(); });
+  measure(isa, "bool", n, "first_set", mb, [&] { sink += b.first_set(); });
+  if (sink == 0) printf("\n");
+}
+
+int main(int argc, char** argv) {
+  graphlab::command_line_options
+    clopts("AutoMI lane vector kernel microbenchmark.", true);
+  std::vector<size_t> lanes;
+  std::vector<std::string> types;
+  std::vector<std::string> isas;
+  clopts.attach_option("lanes", lanes,
+                       "The lane counts (default 8 16 32 ... 1024)");
+  clopts.attach_option("types", types,
+                       "The lane types among bool int float int16 uint8 "
+                       "int64 double (default all)");
+  clopts.attach_option("isa", isas,
+                       "The SIMD backends, see AUTOMI_ISA (default all "
+                       "supported by this CPU)");
+  clopts.attach_option("min_time", MIN_TIME,
+                       "The minimum time in seconds measured per operator");
+  if(!clopts.parse(argc, argv)) return EXIT_FAILURE;
+  if (lanes.empty()) {
+    for (size_t n = 8; n <= 1024; n *= 2) lanes.push_back(n);
+  }
+  if (types.empty()) {
+    const char* all[] = {"bool", "int", "float", "int16", "uint8", "int64", "double"};
+    types.assign(all, all + 7);
+  }
+
+  printf("%-10s %-7s %6s  %-30s %10s %9s\n",
+         "isa", "type", "lanes", "op", "ns/op", "GB/s");
+  for (int i = 0; i < graphlab::AUTOMI_ISA_COUNT; ++i) {
+    const graphlab::automi_isa_type isa = graphlab::automi_isa_type(i);
+    const char* isa_name = graphlab::automi_isa_name(isa);
+    if (!isas.empty() &&
+        std::find(isas.begin(), isas.end(), isa_name) == isas.end()) continue;
+    if (!graphlab::automi_select_isa(isa)) continue;
+    check_containers(isa_name);
+    for (size_t t = 0; t < types.size(); ++t) {
+      for (size_t l = 0; l < lanes.size(); ++l) {
+        const size_t n = lanes[l];
+        const char* type = types[t].c_str();
+        if (types[t] == "bool") bench_mask(isa_name, n);
+        else if (types[t] == "int") bench_type<int>(isa_name, type, n);
+        else if (types[t] == "float") bench_type<float>(isa_name, type, n);
+        else if (types[t] == "int16") bench_type<int16_t>(isa_name, type, n);
+        else if (types[t] == "uint8") bench_type<uint8_t>(isa_name, type, n);
+        else if (types[t] == "int64") bench_type<int64_t>(isa_name, type, n);
+        else if (types[t] == "double") bench_type<double>(isa_name, type, n);
+        else {
+          fprintf(stderr, "Unknown lane type: %s\n", type);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -143,6 +143,26 @@ public:
         return msg_type();
     }
 
+    // the gather is the identity of msg_type::operator+=
+    void gather_into(icontext_type& context, const vertex_type& vertex,
+                     edge_type& edge, msg_type& accum) const { }
+
+    // bottom-up gather (engine option direction): the lanes in which the
+    // in-neighbor is visited, one level further
+    msg_type pull_gather(icontext_type& context, const vertex_type& vertex,
+                         edge_type& edge) const {
+        const vertex_type other = get_other_vertex(edge, vertex);
+        msg_type msg = msg_type();
+        msg.track = other.data().status;
+        msg.ans.vec_op_add_update_mask(msg.track, other.data().ans, 1);
+        return msg;
+    }
+
+    // the vertex is not visited yet in some lane
+    bool pull_candidate(icontext_type& context, const vertex_type& vertex) const {
+        return !vertex.data().status.vec_all();
+    }
+
     // Apply function
     void apply(icontext_type& context, vertex_type& vertex,
                const msg_type& msg_accum) {
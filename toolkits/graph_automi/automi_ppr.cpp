@@ -292,9 +292,11 @@ int main(int argc, char** argv) {
   graphlab::omni_engine<vertex_program> engine(dc, graph, exec_type, clopts);
 
   // Signal all the vertices in the source set
+  std::vector<std::pair<graph_type::vertex_id_type, msg_type> > source_msgs;
   for(size_t i = 0; i < sources.size(); ++i) {
-    engine.signal_source(sources[i], msg_type(true, i));
+    source_msgs.push_back(std::make_pair(sources[i], msg_type(true, i)));
   }
+  engine.signal_sources(source_msgs);
 
   timer.start();
   engine.start();
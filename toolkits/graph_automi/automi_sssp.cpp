@@ -1,6 +1,7 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <sstream>
 
 
 #include <graphlab.hpp>
@@ -21,6 +22,14 @@ bool nextLine(std::ifstream &input_fs, std::string &buf) {
 int NUM_SRC_NODES;
 int ITERATIONS = 0;
 
+/**
+ * \brief The file receiving the distances of the retired queries
+ * (stream mode or lane_compaction), one "query vertex distance" line
+ * per reached vertex
+ */
+std::ofstream RESULT_STREAM;
+graphlab::mutex RESULT_LOCK;
+
 /**
  * \brief The type used to measure distances in the graph.
  */
@@ -48,6 +57,16 @@ struct vertex_data {
   void load(graphlab::iarchive& iarc) {
     iarc >> ans;
   }
+
+  void masked_save(graphlab::oarchive &oarc,
+                   const graphlab::automi_bitvec<bool>& mask) const {
+    ans.masked_save(oarc, mask);
+  }
+
+  void masked_load(graphlab::iarchive& iarc,
+                   const graphlab::automi_bitvec<bool>& mask) {
+    ans.masked_load(iarc, mask);
+  }
 };  // end of vertex data
 
 /**
@@ -76,27 +95,26 @@ get_other_vertex(const graph_type::edge_type& edge,
 
 /**
  * \brief struct msg_type
+ *
+ * Most lanes of a message hold default_ans, so only the lanes carrying
+ * a distance are stored and sent (see automi_hybridvec).
  */
 struct msg_type {
-  graphlab::automi_bitvec<ans_type> ans;
+  graphlab::automi_hybridvec<ans_type> ans;
   // constructor with single distance value, used during initialization
-  msg_type() {
-    ans = graphlab::automi_bitvec<ans_type>(NUM_SRC_NODES);
-    ans.set_all(default_ans);
-  }
+  msg_type() : ans(NUM_SRC_NODES, default_ans) { }
   // constructor with single distance value, used during initialization
-  msg_type(ans_type init_ans, size_t idx) {
-    ans = graphlab::automi_bitvec<ans_type>(NUM_SRC_NODES);
-    ans.set_all(default_ans);
+  msg_type(ans_type init_ans, size_t idx) : ans(NUM_SRC_NODES, default_ans) {
     ans.set_single(init_ans, idx);
   }
   // constructor with distance array
-  msg_type(const graphlab::automi_bitvec<ans_type>& ans_in) {
-    ans = graphlab::automi_bitvec<ans_type>(ans_in);
+  msg_type(const graphlab::automi_bitvec<ans_type>& ans_in) : ans(ans_in.size(), default_ans) {
+    ans.densify() = ans_in;
+    ans.shrink();
   }
 
   msg_type& operator+=(const msg_type& other) {
-    graphlab::automi_bitvec<ans_type>::pair_op_min(ans, other.ans);
+    graphlab::automi_hybridvec<ans_type>::pair_op_min(ans, other.ans);
     return *this;
   }
   // serialization method
@@ -106,6 +124,15 @@ struct msg_type {
   void load(graphlab::iarchive& iarc) {
     iarc >> ans;
   }
+  // only the lanes carrying a distance (engine option masked_messages)
+  void masked_save(graphlab::oarchive &oarc,
+                   const graphlab::automi_bitvec<bool>& mask) const {
+    ans.masked_save(oarc, mask);
+  }
+  void masked_load(graphlab::iarchive& iarc,
+                   const graphlab::automi_bitvec<bool>& mask) {
+    ans.masked_load(iarc, mask);
+  }
 };  // end of msg_type
 
 
@@ -113,12 +140,74 @@ struct msg_type {
  * \brief The vertex program class.
  */
 class vertex_program :
-  public graphlab::ivertex_program<graph_type, msg_type, msg_type> {
+  public graphlab::imulti_vertex_program<graph_type, msg_type, msg_type> {
 
-    graphlab::automi_bitvec<bool> changed;
+    // lanes improved by the last apply
+    lane_mask_type changed;
 
 public: 
 
+    // lanes carrying a distance
+    void message_lanes(const msg_type& msg, lane_mask_type& ret) const {
+        msg.ans.present_lanes(ret);
+    }
+
+    void changed_lanes(lane_mask_type& ret) const {
+        ret = changed;
+    }
+
+    // drop the retired lanes (engine option lane_compaction)
+    void compact_lanes(const lane_mask_type& keep) const {
+        NUM_SRC_NODES = keep.count();
+    }
+
+    void compact_vertex(vertex_type& vertex, const lane_mask_type& keep) const {
+        vertex.data().ans.compact(keep);
+    }
+
+    void compact_message(msg_type& msg, const lane_mask_type& keep) const {
+        msg.ans.compact(keep);
+    }
+
+    // emit the distances of the retired queries (engine options
+    // stream_queries and lane_compaction)
+    void retire_lanes(const vertex_type& vertex, const lane_mask_type& retired,
+                      const std::vector<size_t>& queries) const {
+        if (!RESULT_STREAM.is_open()) return;
+        std::ostringstream out;
+        for (size_t i = 0; i < retired.size(); ++i) {
+            if (!retired.test_bit(i)) continue;
+            const ans_type dist = vertex.data().ans.array[i];
+            if (dist != default_ans)
+                out << queries[i] << " " << vertex.id() << " " << dist << "\n";
+        }
+        if (out.tellp() <= 0) return;
+        RESULT_LOCK.lock();
+        RESULT_STREAM << out.str();
+        RESULT_LOCK.unlock();
+    }
+
+    void reset_lanes(vertex_type& vertex, const lane_mask_type& lanes) const {
+        vertex.data().ans.vec_op_set_mask(lanes, default_ans);
+    }
+
+    msg_type source_message(size_t lane) const {
+        return msg_type(0, lane);
+    }
+
+    void init(icontext_type& context, const vertex_type& vertex,
+              const msg_type& msg) {
+        // engines without lane tracking leave the lanes empty
+        if (active_lanes().size() == 0)
+            message_lanes(msg, lanes);
+    }
+
+    void source_init(icontext_type& context, vertex_type& vertex,
+                     const msg_type& msg) {
+        init(context, vertex, msg);
+        apply(context, vertex, msg);
+    }
+
     edge_dir_type gather_edges(icontext_type& context,
                                const vertex_type& vertex) const {
         return DIRECTED_GRAPH ? graphlab::IN_EDGES : graphlab::ALL_EDGES;
@@ -129,40 +218,67 @@ public:
                        edge_type& edge) const {
         const vertex_type other = get_other_vertex(edge, vertex);
         msg_type msg = msg_type();
-        msg.ans.vec_op_add_update(other.data().ans, edge.data().dist);
+        msg.ans.densify().vec_op_add_update_mask(active_lanes(), other.data().ans, edge.data().dist);
         return msg;
     }
 
+    // accum += gather(context, vertex, edge), relaxing into accum in one pass
+    void gather_into(icontext_type& context, const vertex_type& vertex,
+                     edge_type& edge, msg_type& accum) const {
+        const vertex_type other = get_other_vertex(edge, vertex);
+        accum.ans.densify().vec_op_add_min_update_mask(active_lanes(), other.data().ans, edge.data().dist);
+    }
+
+    // bottom-up gather (engine option direction): relaxes the lanes the
+    // in-neighbor has reached, as its scatter would have
+    msg_type pull_gather(icontext_type& context, const vertex_type& vertex,
+                         edge_type& edge) const {
+        // the lanes are not compacted by the engines which pull
+        static const graphlab::automi_bitvec<ans_type> unreached = vertex_data().ans;
+        const vertex_type other = get_other_vertex(edge, vertex);
+        lane_mask_type reached(unreached.size());
+        reached.vec_op_cmpneq_update(other.data().ans, unreached);
+        msg_type msg = msg_type();
+        msg.ans.densify().vec_op_add_update_mask(reached, other.data().ans, edge.data().dist);
+        return msg;
+    }
+
+    // any vertex may still improve in some lane
+    bool pull_candidate(icontext_type& context, const vertex_type& vertex) const {
+        return true;
+    }
+
     // Apply function
     void apply(icontext_type& context, vertex_type& vertex,
                  const msg_type& msg_accum) {
-        graphlab::automi_bitvec<bool> mask;
-        mask.vec_op_cmpgt_update(vertex.data().ans, msg_accum.ans);
-        vertex.data().ans.vec_op_set_mask(mask, msg_accum.ans);
-        changed.vec_op_set_mask(mask, true);
+        msg_accum.ans.min_into(vertex.data().ans, changed);
     };
 
     // scatter_nbrs function
     edge_dir_type scatter_edges(icontext_type& context, 
                                 const vertex_type& vertex) const {
+      // tested once per vertex rather than once per edge
+      if (!changed.vec_any()) return graphlab::NO_EDGES;
       return DIRECTED_GRAPH? graphlab::OUT_EDGES : graphlab::ALL_EDGES;
     }
 
     // Scatter function
     void scatter(icontext_type& context, const vertex_type& vertex,
                  edge_type& edge) const {
-        if (!changed.vec_all_zeros()) {
-          const vertex_type other = get_other_vertex(edge, vertex);
-          msg_type msg = msg_type(vertex.data().ans);
-          context.signal(other, msg);
-        }
+        const vertex_type other = get_other_vertex(edge, vertex);
+        // only the improved lanes are propagated
+        msg_type msg = msg_type();
+        msg.ans.assign_mask(changed, vertex.data().ans);
+        context.signal(other, msg);
     }
 
   void save(graphlab::oarchive &oarc) const {
+    save_lanes(oarc);
     oarc << changed;
   }
 
   void load(graphlab::iarchive& iarc) {
+    load_lanes(iarc);
     iarc >> changed;
   }
 
@@ -184,7 +300,11 @@ int main(int argc, char** argv) {
   std::string exec_type = "synchronous";
   size_t powerlaw = 0;
   std::vector<unsigned int> sources;
+  std::vector<graphlab::vertex_id_type> queued;
   bool max_degree_source = false;
+  bool stream = false;
+  std::string result_prefix;
+  std::string lane_store;
   clopts.attach_option("graph", graph_dir,
                        "The graph file.  If none is provided "
                        "then a toy graph will be created");
@@ -204,6 +324,20 @@ int main(int argc, char** argv) {
   clopts.attach_option("num_query", NUM_SRC_NODES, 
                        "Number of queries to load");
 
+  clopts.attach_option("stream", stream,
+                       "Run all the queries of the query file with num_query "
+                       "lanes, admitting the next query whenever a query "
+                       "has converged.");
+  clopts.attach_option("result_prefix", result_prefix,
+                       "If set, the distances of each converged query are "
+                       "written to [prefix]_[machine] (stream mode, or "
+                       "when lane_compaction drops its lane).");
+
+  clopts.attach_option("lane_store", lane_store,
+                       "If set to packed or aligned, the distances of all "
+                       "the local vertices are stored in one lane-major "
+                       "arena, with rows packed or padded to cache lines.");
+
   clopts.attach_option("directed", DIRECTED_GRAPH,
                        "Treat edges as directed.");
 
@@ -225,6 +359,13 @@ int main(int argc, char** argv) {
     return EXIT_FAILURE;
   }
 
+  graphlab::automi_lane_layout lane_layout = graphlab::AUTOMI_LANES_PACKED;
+  if (lane_store.length() > 0 &&
+      !graphlab::automi_parse_lane_layout(lane_store, lane_layout)) {
+    dc.cout() << "Unknown lane_store layout: " << lane_store << std::endl;
+    return EXIT_FAILURE;
+  }
+
   if (ITERATIONS) {
     // make sure this is the synchronous engine
     dc.cout() << "--iterations set. Forcing Synchronous engine, and running "
@@ -249,8 +390,11 @@ int main(int argc, char** argv) {
       startPos = currentPos + 1;
       currentPos = buf.find(',', startPos);
     }
-    // remove excessive queries
+    // remove excessive queries, which are queued in stream mode
     if (sources.size() > NUM_SRC_NODES) {
+      if (stream) {
+        queued.assign(sources.begin() + NUM_SRC_NODES, sources.end());
+      }
       sources.resize(NUM_SRC_NODES);
     }
     dc.cout() << "Loaded #queries: " << sources.size() << std::endl;
@@ -268,6 +412,8 @@ int main(int argc, char** argv) {
   // Build the graph ----------------------------------------------------------
   dc.cout() << "Loading graph." << std::endl;
   graphlab::timer timer;
+  // declared before the graph, whose vertex data may view it
+  graphlab::automi_lane_arena ans_arena;
   graph_type graph(dc, clopts);
   if(powerlaw > 0) { // make a synthetic graph
     dc.cout() << "Loading synthetic Powerlaw graph." << std::endl;
@@ -288,6 +434,9 @@ int main(int argc, char** argv) {
   dc.cout() << "Finalizing graph." << std::endl;
   timer.start();
   graph.finalize();
+  if (lane_store.length() > 0) {
+    ans_arena.bind(graph, &vertex_data::ans, lane_layout);
+  }
   const double finalizing = timer.current_time();
   dc.cout() << "Finalizing graph. Finished in " 
             << finalizing << std::endl;
@@ -301,24 +450,48 @@ int main(int argc, char** argv) {
   dc.cout() << "#vertices: " << graph.num_vertices()
             << " #edges:" << graph.num_edges() << std::endl;
 
-  // Running The Engine -------------------------------------------------------
-  graphlab::omni_engine<vertex_program> engine(dc, graph, exec_type, clopts);
-
   // Signal all the vertices in the source set
+  std::vector<std::pair<graph_type::vertex_id_type, msg_type> > source_msgs;
   for(size_t i = 0; i < sources.size(); ++i) {
-    engine.signal_source(sources[i], msg_type(0, i));
+    source_msgs.push_back(std::make_pair(sources[i], msg_type(0, i)));
   }
 
-  timer.start();
-  engine.start();
-  const double runtime = timer.current_time();
+  // Running The Engine -------------------------------------------------------
+  double runtime = 0;
+  size_t num_updates = 0;
+  if (result_prefix.length() > 0) {
+    std::ostringstream fname;
+    fname << result_prefix << "_" << dc.procid();
+    RESULT_STREAM.open(fname.str().c_str());
+  }
+  if (stream) {
+    // serve all the queries on the multi-instance engine, which emits
+    // and recycles the lanes of the converged queries
+    clopts.get_engine_args().set_option("stream_queries", true);
+    graphlab::dimitra_sync_engine<vertex_program> engine(dc, graph, clopts);
+    engine.signal_sources(source_msgs);
+    engine.queue_queries(queued);
+    timer.start();
+    engine.start();
+    runtime = timer.current_time();
+    num_updates = engine.num_updates();
+    dc.cout() << "Queries retired: " << engine.num_retired() << std::endl;
+  } else {
+    graphlab::omni_engine<vertex_program> engine(dc, graph, exec_type, clopts);
+    engine.signal_sources(source_msgs);
+    timer.start();
+    engine.start();
+    runtime = timer.current_time();
+    num_updates = engine.num_updates();
+  }
+  RESULT_STREAM.close();
   dc.cout() << "----------------------------------------------------------"
             << std::endl
             << "Final Runtime (seconds):   " << runtime 
             << std::endl
-            << "Updates executed: " << engine.num_updates() << std::endl
+            << "Updates executed: " << num_updates << std::endl
             << "Update Rate (updates/second): " 
-            << engine.num_updates() / runtime << std::endl;
+            << num_updates / runtime << std::endl;
 
   // Tear-down communication layer and quit -----------------------------------
   graphlab::mpi_tools::finalize();
@@ -145,10 +145,8 @@ public:
     void apply(icontext_type& context, vertex_type& vertex,
                  const msg_type& msg_accum) {
         vp_track = msg_accum.track;
-        graphlab::automi_bitvec<bool> mask;
-        mask.vec_op_cmpgt_update_mask(vp_track, vertex.data().ans, msg_accum.ans);
-        vertex.data().ans.vec_op_set_mask(mask, msg_accum.ans);
-        changed.vec_op_set_mask(mask, true);
+        // lower the tracked lanes and mark them changed in one pass
+        vertex.data().ans.vec_op_min_update_mask(vp_track, msg_accum.ans, changed);
     };
 
     // scatter_nbrs function
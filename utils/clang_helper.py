@@ -11,6 +11,57 @@ from anytree import Node, RenderTree
 
 mask_count = 0
 
+# number of lanes when it is known at build time (`--num-query`), in
+# which case lane vectors are emitted as inline `automi_fixedvec`s
+num_query = None
+
+# user-declared range of the integer lane values (`--value-range`), in
+# which case integer lanes use the narrowest type covering it
+value_range = None
+
+# integer types that may be narrowed, and the narrow lane types with the
+# range of values they hold
+integer_types = ['int', 'long', 'long long', 'short', 'unsigned', 'unsigned int',
+                 'int32_t', 'int64_t', 'size_t']
+narrow_lane_types = [('uint8_t', 0, 255), ('int16_t', -32768, 32767)]
+
+def set_num_query(n):
+    global num_query
+    num_query = n
+
+def set_value_range(lo, hi):
+    global value_range
+    value_range = (lo, hi)
+
+def narrow_int_type(elem_type):
+    """
+    Returns the narrowest lane type covering `value_range` for an integer
+    `elem_type`, or `elem_type` itself if no narrower type covers it.
+    """
+    if value_range is None or elem_type.strip() not in integer_types:
+        return elem_type
+    lo, hi = value_range
+    for (lane_type, type_min, type_max) in narrow_lane_types:
+        if type_min <= lo and hi <= type_max:
+            return lane_type
+    return elem_type
+
+def narrow_typedef_line(line):
+    """
+    Rewrites `typedef <integer type> <name>;` to the narrow lane type, so
+    that values of <name> (e.g. numeric_limits<name>::max()) match the lanes.
+    """
+    match = re.match(r'^(\s*typedef\s+)(.+?)(\s+\w+\s*;.*)$', line)
+    if match is None:
+        return line
+    return match.group(1) + narrow_int_type(match.group(2)) + match.group(3)
+
+def lane_vec_type(elem_type):
+    elem_type = narrow_int_type(elem_type)
+    if num_query is None:
+        return 'graphlab::automi_bitvec<%s>' % elem_type
+    return 'graphlab::automi_fixedvec<%s, %d>' % (elem_type, num_query)
+
 pair_op_dict = {'std::min': 'pair_op_min', 'std::max': 'pair_op_max',
                 '|': 'pair_op_or', '&': 'pair_op_and',
                 '+': 'pair_op_plus', '*': 'pair_op_mul'}
@@ -367,8 +418,12 @@ def annotate_return_stmt(cursor, automi_label) -> Node:
 
 
 def convert_comp_stmt(comp_stmt_root : Node, ignore_track=False):
+    return convert_stmt_list(comp_stmt_root.children, ignore_track)
+
+
+def convert_stmt_list(stmt_root_list, ignore_track=False):
     child_stmt_code_list = []
-    for child_stmt_root in comp_stmt_root.children:
+    for child_stmt_root in stmt_root_list:
         if child_stmt_root.type == 'if_stmt':
             child_stmt_code_list.extend(['  ' + line for line in convert_if_stmt(child_stmt_root, ignore_track)])
         elif child_stmt_root.type == 'signal':
@@ -382,13 +437,51 @@ def convert_comp_stmt(comp_stmt_root : Node, ignore_track=False):
     return child_stmt_code_list
 
 
+def convert_min_update_if(if_stmt_root : Node, ignore_track=False) -> List:
+    """
+    Fuses `if (<a> > <b>) { <a> = <b>; ... }` (or `<b> < <a>`) without an
+    else branch into one `vec_op_min_update` pass, which lowers <a> and
+    collects the lanes it lowered in the branch mask.  The rest of the
+    branch is converted under that mask.  Returns None if the if statement
+    does not have this form.
+    """
+    if len(if_stmt_root.children) != 2:
+        return None
+    if_cond_root, if_branch_root = if_stmt_root.children
+    cond_expr_root = if_cond_root.children[0]
+    if cond_expr_root.type != 'expr_bi_op' or cond_expr_root.name not in ('>', '<'):
+        return None
+    lhs_name, rhs_name = [child.name for child in cond_expr_root.children]
+    if cond_expr_root.name == '<':
+        lhs_name, rhs_name = rhs_name, lhs_name
+    if len(if_branch_root.children) == 0:
+        return None
+    first_stmt = if_branch_root.children[0]
+    if (first_stmt.type != 'assign_stmt' or first_stmt.children[0].name != lhs_name or
+        first_stmt.children[1].type != 'expr_no_op' or first_stmt.children[1].name != rhs_name):
+        return None
+    no_mask = (ignore_track) and (if_cond_root.mark == 'T')
+    mask_name = 'msg_acc.track' if (if_cond_root.mark == 'T') else if_cond_root.mark
+    min_update_code_list = ['%s %s;' % (lane_vec_type('bool'), if_cond_root.name)] # declare bitvec
+    if no_mask:
+        min_update_code_list.append('%s.vec_op_min_update(%s, %s);' % (lhs_name, rhs_name, if_cond_root.name))
+    else:
+        min_update_code_list.append('%s.vec_op_min_update_mask(%s, %s, %s);' %
+                                    (lhs_name, mask_name, rhs_name, if_cond_root.name))
+    min_update_code_list.extend(convert_stmt_list(if_branch_root.children[1:], ignore_track))
+    return min_update_code_list
+
+
 def convert_if_stmt(if_stmt_root : Node, ignore_track=False) -> List:
+    min_update_code_list = convert_min_update_if(if_stmt_root, ignore_track)
+    if min_update_code_list is not None:
+        return min_update_code_list
     if_stmt_code_list = []
     # if branch condition assignment
     if_cond_root = if_stmt_root.children[0]
     no_mask = (ignore_track) and (if_cond_root.mark == 'T')
     mask_name = 'msg_acc.track' if (if_cond_root.mark == 'T') else if_cond_root.mark
-    if_stmt_code_list.append('graphlab::automi_bitvec<bool> %s;' % if_cond_root.name) # declare bitvec
+    if_stmt_code_list.append('%s %s;' % (lane_vec_type('bool'), if_cond_root.name)) # declare bitvec
     cond_expr_root = if_cond_root.children[0]
     if_cond_str = '%s.%s' % (if_cond_root.name, convert_cond_expr(cond_expr_root, '' if no_mask else mask_name))
     if_stmt_code_list.append(if_cond_str)
@@ -399,7 +492,7 @@ def convert_if_stmt(if_stmt_root : Node, ignore_track=False) -> List:
     if (len(if_stmt_root.children) == 4):
         else_cond_root = if_stmt_root.children[2]
         mask_name = 'msg_acc.track' if (if_cond_root.mark == 'T') else else_cond_root.mark
-        if_stmt_code_list.append('graphlab::automi_bitvec<bool> %s;' % else_cond_root.name) # declare bitvec
+        if_stmt_code_list.append('%s %s;' % (lane_vec_type('bool'), else_cond_root.name)) # declare bitvec
         else_expr_root = else_cond_root.children[0]
         else_cond_str = '%s.%s' % (else_cond_root.name, convert_cond_expr(else_expr_root, '' if no_mask else mask_name))
         if_stmt_code_list.append(else_cond_str)
@@ -474,6 +567,44 @@ def convert_assign_stmt(assign_stmt_root : Node, ignore_track=False) -> List:
             return [f'{lhs_var_name}.{vec_op_name}({mask_name}, {rhs_expr_root.children[0].name});']
 
 
+def convert_gather_into(gather_body_root : Node, accum_op_dict, msg_fields) -> List:
+    """
+    Fuses a gather into its accumulation as the body of `gather_into`, when
+    the gather builds one message whose fields are each assigned once from
+    `<vector> + <scalar>` and accumulated with std::min.  Returns None if the
+    gather does not have this form.
+    """
+    return_stmts = [stmt for stmt in gather_body_root.children if stmt.type == 'return_stmt']
+    if len(return_stmts) != 1:
+        return None
+    msg_name = return_stmts[0].name
+    gather_into_code_list = []
+    assigned_fields = []
+    for stmt_root in gather_body_root.children:
+        if stmt_root.type == 'decl_stmt':
+            # the returned message is replaced by the accumulator
+            if msg_name not in stmt_root.token_list:
+                gather_into_code_list.extend(['  ' + line for line in convert_decl_stmt(stmt_root)])
+        elif stmt_root.type == 'assign_stmt':
+            lhs_var_name = stmt_root.children[0].name
+            rhs_expr_root = stmt_root.children[1]
+            if not lhs_var_name.startswith(msg_name + '.'):
+                return None
+            field_name = lhs_var_name[len(msg_name) + 1:]
+            if (field_name in assigned_fields or rhs_expr_root.type != 'expr_bi_op' or
+                rhs_expr_root.name != '+' or accum_op_dict.get(field_name) != 'pair_op_min'):
+                return None
+            assigned_fields.append(field_name)
+            gather_into_code_list.append('  accum.%s.vec_op_add_min_update(%s, %s);' %
+                                         (field_name, rhs_expr_root.children[0].name, rhs_expr_root.children[1].name))
+        elif stmt_root.type != 'return_stmt':
+            return None
+    # fields left at their default value must be accumulated too
+    if len(assigned_fields) == 0 or sorted(assigned_fields) != sorted(msg_fields):
+        return None
+    return gather_into_code_list
+
+
 def convert_decl_stmt(decl_stmt_root : Node, ignore_track=False) -> List:
     return [' '.join(decl_stmt_root.token_list)]
 
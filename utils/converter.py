@@ -42,7 +42,8 @@ class GlobalConverter:
                     segment_end = line_num
                     # debug print
                     print(f'segment_start: {segment_start}, segment_end: {segment_end}')
-                    self.all_segment_dict['Patch'].extend(self.content_list[segment_start:segment_end])
+                    self.all_segment_dict['Patch'].extend([narrow_typedef_line(line) for line in
+                                                           self.content_list[segment_start:segment_end]])
                     break
             for (segment_start, segment_end) in locate_struct_segments(content_str):
                 # debug print
@@ -104,6 +105,8 @@ class GlobalConverter:
         self.helper_lines = graph_type_line + ''.join(func_get_other_vertex_lines)
         code_lines = '\n'.join(self.all_segment_dict['Patch']) + '\n' + self.helper_lines + self.vertex_program_keyword_replacement()
         self.vertex_program_obj.annotate(code_lines)
+        self.vertex_program_obj.msg_fields = [field[0] for field in (self.msg_type_obj.var_tuple_list or [])]
+        self.vertex_program_obj.msg_accum_ops = self.msg_type_obj.accum_op_dict()
 
     def codegen(self):
         with open(self.output_filename, 'w') as file:
@@ -144,10 +147,26 @@ def parse_args():
                           add_help_option=False)
     parser.add_option("-t", "--track-free", action="store_true", dest="track_free",
                       default=False, help="Enable TrackFree")
+    parser.add_option("-n", "--num-query", type="int", dest="num_query",
+                      default=None, help="Number of queries known at build time, "
+                      "emits fixed-width lane vectors (automi_fixedvec)")
+    parser.add_option("-r", "--value-range", type="string", dest="value_range",
+                      default=None, help="Range MIN,MAX of the integer lane values, "
+                      "emits the narrowest integer lanes covering it (int16_t, uint8_t)")
     (opts, args) = parser.parse_args()
     if len(args) != 2:
         parser.print_help()
         sys.exit(1)
+    if opts.value_range is not None:
+        try:
+            opts.value_range = tuple(int(v) for v in opts.value_range.split(','))
+        except ValueError:
+            parser.error("--value-range expects MIN,MAX")
+        if len(opts.value_range) != 2 or opts.value_range[0] > opts.value_range[1]:
+            parser.error("--value-range expects MIN,MAX")
+        if opts.num_query is not None:
+            parser.error("--value-range cannot be combined with --num-query "
+                         "(automi_fixedvec has no narrow lanes)")
     return opts, args
 
 def main():
@@ -155,6 +174,10 @@ def main():
     input_filename, output_filename = args[0], args[1]
     # # debug: check opts is working
     # print("TrackFree enabled: ", opts.track_free)
+    if opts.num_query is not None:
+        set_num_query(opts.num_query)
+    if opts.value_range is not None:
+        set_value_range(*opts.value_range)
     converter = GlobalConverter(input_filename, output_filename, opts.track_free)
     converter.read_input_file()
     converter.annotate_all_segments()
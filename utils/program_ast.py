@@ -32,17 +32,17 @@ class VertexData:
 
         # struct fields declaration lines
         for (field_name, field_type, _) in self.var_tuple_list:
-            mip_lines.append('  graphlab::automi_bitvec<%s> %s;\n' % (field_type, field_name))
+            mip_lines.append('  %s %s;\n' % (lane_vec_type(field_type), field_name))
 
         # struct default constructor
         mip_lines.append('  vertex_data() {\n')
         for (field_name, field_type, field_value) in self.var_tuple_list:
-            mip_lines.append('    %s = graphlab::automi_bitvec<%s>(NUM_SRC_NODES);\n' % (field_name, field_type))
+            mip_lines.append('    %s = %s(NUM_SRC_NODES);\n' % (field_name, lane_vec_type(field_type)))
             mip_lines.append('    %s.set_all(%s);\n' % (field_name, field_value))
         mip_lines.append('  }\n')
 
         # struct explicit constructor
-        constructor_params_list = ['const graphlab::automi_bitvec<%s>& %s' % (var_tuple[1], var_tuple[0]) for var_tuple in self.var_tuple_list]
+        constructor_params_list = ['const %s& %s' % (lane_vec_type(var_tuple[1]), var_tuple[0]) for var_tuple in self.var_tuple_list]
         constructor_params_str = ', '.join(constructor_params_list)
         constructor_field_list = ['%s(%s)' % (var_tuple[0], var_tuple[0]) for var_tuple in self.var_tuple_list]
         constructor_field_str = ', '.join(constructor_field_list)
@@ -144,6 +144,16 @@ class MsgType:
         # TODO: handle operator+= function!
         self.accum_op_lines_list.extend(parse_accum_operator(code_lines, 'msg_type'))
 
+    def accum_op_dict(self):
+        # pairwise operator used by `operator+=` for each field
+        op_dict = {}
+        for accum_line in self.accum_op_lines_list:
+            if len(accum_line.split('=')) != 2:
+                break
+            [field_name, operation_str] = accum_line.split('=')
+            _, op_dict[field_name] = pair_op_lookup(operation_str)
+        return op_dict
+
     def codegen(self, output_file) -> None:
         output_file.write(''.join(self.multi_lines()))
 
@@ -155,17 +165,17 @@ class MsgType:
 
         # struct field declaration lines
         for (field_name, field_type, _) in self.var_tuple_list:
-            mip_lines.append('  graphlab::automi_bitvec<%s> %s;\n' % (field_type, field_name))
+            mip_lines.append('  %s %s;\n' % (lane_vec_type(field_type), field_name))
         if not self.track_free:
-            mip_lines.append('  graphlab::automi_bitvec<bool> track;\n')
+            mip_lines.append('  %s track;\n' % lane_vec_type('bool'))
 
         # default constructor
         mip_lines.append('  %s() {\n' % self.struct_name)
         for (field_name, field_type, field_value) in self.var_tuple_list:
-            mip_lines.append('    %s = graphlab::automi_bitvec<%s>(NUM_SRC_NODES);\n' % (field_name, field_type))
+            mip_lines.append('    %s = %s(NUM_SRC_NODES);\n' % (field_name, lane_vec_type(field_type)))
             mip_lines.append('    %s.set_all(%s);\n' % (field_name, field_value))
         if not self.track_free:
-            mip_lines.append('    track = graphlab::automi_bitvec<bool>(NUM_SRC_NODES);\n')
+            mip_lines.append('    track = %s(NUM_SRC_NODES);\n' % lane_vec_type('bool'))
             mip_lines.append('    track.set_all(false);\n')
         mip_lines.append('  }\n')
 
@@ -175,11 +185,11 @@ class MsgType:
             source_default_values_list.append('%s %s' % (field_type, field_name + '_in'))
         mip_lines.append('  %s(%s, size_t idx) {\n' % (self.struct_name, ', '.join(source_default_values_list)))
         for (field_name, field_type, field_value) in self.var_tuple_list:
-            mip_lines.append('    %s = graphlab::dimitra_bitvec<%s>(NUM_SRC_NODES);\n' % (field_name, field_type))
+            mip_lines.append('    %s = %s(NUM_SRC_NODES);\n' % (field_name, lane_vec_type(field_type)))
             mip_lines.append('    %s.set_all(%s);\n' % (field_name, field_value))
             mip_lines.append('    %s.set_single(%s, idx);\n' % (field_name, field_name + '_in'))
         if not self.track_free:
-            mip_lines.append('    track = graphlab::dimitra_bitvec<bool>(NUM_SRC_NODES);\n')
+            mip_lines.append('    track = %s(NUM_SRC_NODES);\n' % lane_vec_type('bool'))
             mip_lines.append('    track.set_all(false);\n')
             mip_lines.append('    track.set_single(true, idx);\n')
         mip_lines.append('  }\n')
@@ -187,20 +197,20 @@ class MsgType:
         # explicit constructor
         explicit_constructor_params_list = []
         for (field_name, field_type, _) in self.var_tuple_list:
-            explicit_constructor_params_list.append('const graphlab::automi_bitvec<%s>& %s' % (field_type, field_name + '_in'))
+            explicit_constructor_params_list.append('const %s& %s' % (lane_vec_type(field_type), field_name + '_in'))
         if not self.track_free:
-            explicit_constructor_params_list.append('const graphlab::automi_bitvec<bool>& track_in')
+            explicit_constructor_params_list.append('const %s& track_in' % lane_vec_type('bool'))
         mip_lines.append('  %s(%s) {\n' % (self.struct_name, ', '.join(explicit_constructor_params_list)))
         for (field_name, field_type, _) in self.var_tuple_list:
-            mip_lines.append('    %s = graphlab::automi_bitvec<%s>(%s);\n' % (field_name, field_type, field_name + '_in'))
+            mip_lines.append('    %s = %s(%s);\n' % (field_name, lane_vec_type(field_type), field_name + '_in'))
         if not self.track_free:
-            mip_lines.append('    track = graphlab::automi_bitvec<bool>(track_in);\n')
+            mip_lines.append('    track = %s(track_in);\n' % lane_vec_type('bool'))
         mip_lines.append('  }\n')
 
         # accumulation funtion `operator+=`
         mip_lines.append('  %s& operator+=(const %s& other) {\n' % (self.struct_name, self.struct_name))
         if not self.track_free:
-            mip_lines.append('    graphlab::automi_bitvec::pair_op_or(track, other.track);\n')
+            mip_lines.append('    %s::pair_op_or(track, other.track);\n' % lane_vec_type('bool'))
         for accum_line in self.accum_op_lines_list:
             if len(accum_line.split('=')) != 2:
                 break
@@ -209,7 +219,7 @@ class MsgType:
             for (field_name, field_type, _) in self.var_tuple_list:
                 if field_name == tmp_field_name:
                     tmp_field_type = field_type
-                    mip_lines.append('    graphlab::automi_bitvec<%s>::%s(%s, other.%s);\n' % (tmp_field_type, operator_name, tmp_field_name, tmp_field_name))
+                    mip_lines.append('    %s::%s(%s, other.%s);\n' % (lane_vec_type(tmp_field_type), operator_name, tmp_field_name, tmp_field_name))
                     break
             mip_lines.append('    return *this;\n')
             mip_lines.append('  }\n')
@@ -241,6 +251,10 @@ class VertexProgram:
     track_free = False
     vp_fields = []
 
+    # `msg_type` fields and their accumulation operators, see MsgType
+    msg_fields = []
+    msg_accum_ops = {}
+
     def __init__(self, track_free) -> None:
         self.track_free = track_free
 
@@ -290,9 +304,9 @@ class VertexProgram:
 
         # declare member variables
         for (field_name, field_type) in self.vp_fields:
-            mip_lines.append('  graphlab::automi_bitvec<%s> %s;\n' % (field_type, field_name))
+            mip_lines.append('  %s %s;\n' % (lane_vec_type(field_type), field_name))
         if not self.track_free:
-            mip_lines.append('  graphlab::automi_bitvec<bool> vp_track;\n')
+            mip_lines.append('  %s vp_track;\n' % lane_vec_type('bool'))
         
         mip_lines.append('public:\n')
 
@@ -306,6 +320,16 @@ class VertexProgram:
         mip_lines.append('\n  ' + '\n  '.join(convert_comp_stmt(self.gather_body, True)))
         mip_lines.append('\n  }\n')
 
+        # in-place gather, if the gather can be fused into the accumulation
+        # (track is left alone: its default value is the identity of `|`)
+        gather_into_lines = convert_gather_into(self.gather_body, self.msg_accum_ops, self.msg_fields)
+        if gather_into_lines is not None:
+            gather_into_params = self.gather_params + [('accum', 'msg_type &')]
+            gather_into_params_line = ', '.join([f'{param_type} {param_name}' for (param_name, param_type) in gather_into_params])
+            mip_lines.append('\n  ' + 'void gather_into(%s) const {' % gather_into_params_line)
+            mip_lines.append('\n  ' + '\n  '.join(gather_into_lines))
+            mip_lines.append('\n  }\n')
+
         # apply function
         apply_params_line = ', '.join([f'{param_type} {param_name}' for (param_name, param_type) in self.apply_params])
         mip_lines.append('\n  ' + 'void apply(%s) {\n' % apply_params_line)
@@ -89,8 +89,7 @@ public:
     vp_track = msg_acc.track;
 
     graphlab::automi_bitvec<bool> mask_1;
-    mask_1.vec_op_cmpgt_update_mask(msg_acc.track, vertex.data().ans, msg_accum.ans);
-      vertex.data().ans.vec_op_set_mask(mask_1, msg_accum.ans);
+    vertex.data().ans.vec_op_min_update_mask(msg_acc.track, msg_accum.ans, mask_1);
       changed.vec_op_set_mask(mask_1, true);
   }
 
@@ -77,8 +77,7 @@ public:
   void apply(icontext_type & context, vertex_type & vertex, const msg_type & msg_accum) {
 
     graphlab::automi_bitvec<bool> mask_1;
-    mask_1.vec_op_cmpgt_update(vertex.data().ans, msg_accum.ans);
-      vertex.data().ans.vec_op_set_mask(mask_1, msg_accum.ans);
+    vertex.data().ans.vec_op_min_update(msg_accum.ans, mask_1);
       changed.vec_op_set_mask(mask_1, true);
   }
 